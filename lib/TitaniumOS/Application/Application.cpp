@@ -7,10 +7,13 @@
 
 #include <memory>
 
+#include "esp_sleep.h"
+
 // Initialize static member variables
 SharedMemoryManager* SharedMemoryManager::singleton_pointer_ = nullptr;
 GPIOManager* GPIOManager::singleton_pointer_                 = nullptr;
 SPIManager* SPIManager::singleton_pointer_                   = nullptr;
+MessageBus* MessageBus::singleton_pointer_                   = nullptr;
 
 /**
  * @brief Initializes the Hardware Abstraction Layer (HAL) components.
@@ -38,6 +41,26 @@ void Application::InitializeHAL(void) {
     }
 }
 
+/**
+ * @brief Starts the message bus fanning the area writes out to the subscribed processes.
+ *        Enable it before the processes that subscribe to it.
+ * @param[in] process_stack Stack size for the bus dispatcher, the subscriber callbacks run on it.
+ * @param[in] process_priority Priority of the bus dispatcher.
+ * @param[in] can_fail Flag indicating if initialization failure should be tolerated.
+ * @return ESP_OK if initialization succeeds, otherwise an error code.
+ */
+titan_err_t Application::EnableMessageBus(uint32_t process_stack, uint8_t process_priority, bool can_fail) {
+    this->_message_bus = MessageBus::GetInstance();
+    auto result        = this->_message_bus->Start(process_stack, process_priority);
+
+    if (!can_fail) {
+        ESP_ERROR_CHECK(result);
+    }
+    ESP_LOGI("Application", "Message Bus Initialization Successfully");
+
+    return result;
+}
+
 /**
  * @brief Initializes the network component.
  * @param[in] process_stack Stack size for the network process.
@@ -49,12 +72,8 @@ titan_err_t Application::EnableNetworkProcess(uint32_t process_stack, uint8_t pr
     auto result            = ESP_OK;
     this->_network_process = new NetworkProcess("Network Proccess", process_stack, process_priority);
 
-    result += this->_shared_memory_manager->SignUpSharedArea(MEMORY_AREAS_NETWORK_CREDENTIALS,
-                                                             NETWORK_CREDENTIALS_SIZE,
-                                                             READ_WRITE);
-    result += this->_shared_memory_manager->SignUpSharedArea(MEMORY_AREAS_NETWORK_INFORMATION,
-                                                             NETWORK_INFORMATION_SIZE,
-                                                             READ_WRITE);
+    result += this->_shared_memory_manager->SignUpSharedArea<MEMORY_AREAS_NETWORK_CREDENTIALS>();
+    result += this->_shared_memory_manager->SignUpSharedArea<MEMORY_AREAS_NETWORK_INFORMATION>();
     if (!can_fail) {
         ESP_ERROR_CHECK(result);
     }
@@ -99,12 +118,10 @@ titan_err_t Application::EnableUartProcess(uint32_t process_stack, uint8_t proce
                                                                  process_stack,
                                                                  process_priority);
 
-    result += this->_shared_memory_manager->SignUpSharedArea(MEMORY_AREAS_UART_SINGLE_PACKET,
-                                                             PACKET_REQUEST_SIZE,
-                                                             READ_WRITE);
-    result += this->_shared_memory_manager->SignUpSharedArea(MEMORY_AREAS_UART_CONTINUOS_PACKET,
-                                                             CONTINUOS_PACKET_LIST_SIZE,
-                                                             READ_WRITE);
+    result += this->_shared_memory_manager->SignUpSharedArea<MEMORY_AREAS_UART_SINGLE_PACKET>();
+    result += this->_shared_memory_manager->SignUpSharedArea<MEMORY_AREAS_UART_CONTINUOS_PACKET>();
+    result += this->_shared_memory_manager->SetPriorityCeiling(MEMORY_AREAS_UART_SINGLE_PACKET, process_priority);
+    result += this->_shared_memory_manager->SetPriorityCeiling(MEMORY_AREAS_UART_CONTINUOS_PACKET, process_priority);
 
     this->_uart_communication_process->InstallDriver(new UARTDriver(UART_NUM_0, Baudrate::BaudRate115200, 256),
                                                      MEMORY_AREAS_UART_SINGLE_PACKET,
@@ -137,18 +154,19 @@ titan_err_t Application::EnableLoraProcess(uint32_t process_stack, uint8_t proce
             ESP_LOGE("Application", "Lora Process Initialization failed with error: %d", result);
             break;
         }
-        result += this->_shared_memory_manager->SignUpSharedArea(MEMORY_AREAS_LORA_SINGLE_PACKET,
-                                                                 PACKET_REQUEST_SIZE,
-                                                                 READ_WRITE);
-        result += this->_shared_memory_manager->SignUpSharedArea(MEMORY_AREAS_LORA_CONTINUOS_PACKET,
-                                                                 CONTINUOS_PACKET_LIST_SIZE,
-                                                                 READ_WRITE);
+        result += this->_shared_memory_manager->SignUpSharedArea<MEMORY_AREAS_LORA_SINGLE_PACKET>();
+        result += this->_shared_memory_manager->SignUpSharedArea<MEMORY_AREAS_LORA_CONTINUOS_PACKET>();
+        /* Consumers writing the packet requests cannot be preempted while they hold the areas. */
+        result += this->_shared_memory_manager->SetPriorityCeiling(MEMORY_AREAS_LORA_SINGLE_PACKET, process_priority);
+        result += this->_shared_memory_manager->SetPriorityCeiling(MEMORY_AREAS_LORA_CONTINUOS_PACKET, process_priority);
 
         this->_lora_communication_process = new CommunicationProcess("LoRa Communication Proccess", process_stack, process_priority);
         this->_lora_communication_process->InstallDriver(new LoRaDriver(Regions::BRAZIL, CRCMode::ENABLE, 255),
                                                          MEMORY_AREAS_LORA_SINGLE_PACKET,
                                                          MEMORY_AREAS_LORA_CONTINUOS_PACKET);
         this->_lora_communication_process->Configure(0x1015);  // this should be in the memory area
+        /* Airtime at high spreading factors makes resending unchanged bytes expensive. */
+        this->_lora_communication_process->EnableDeltaEncoding();
 
         this->_lora_communication_process->InitializeProcess();
         ESP_LOGE("Application", "Lora Process Initialization Successfully");
@@ -173,8 +191,15 @@ titan_err_t Application::EnableMQTTClientProcess(uint32_t process_stack, uint8_t
     auto result = ESP_OK;
 
     do {
+        /* The client only learns about network changes and writes through the bus. */
+        if ((this->_message_bus == nullptr) || !this->_message_bus->IsStarted()) {
+            ESP_LOGE("Application", "Enable the message bus before the MQTT client process");
+            result = ESP_ERR_INVALID_STATE;
+            break;
+        }
+
         this->_mqtt_client_process = new MQTTClientProcess("MQTT Client Proccess", process_stack, process_priority);
-        result += this->_shared_memory_manager->SignUpSharedArea(MEMORY_AREAS_BROKER_CONFIG, BROKER_CONFIG_SIZE, READ_WRITE);
+        result += this->_shared_memory_manager->SignUpSharedArea<MEMORY_AREAS_BROKER_CONFIG>();
         this->_mqtt_client_process->InitializeProcess();
 
     } while (0);
@@ -193,10 +218,13 @@ titan_err_t Application::EnableMQTTClientProcess(uint32_t process_stack, uint8_t
  * @param[in] size_in_bytes Size of the shared memory area in bytes.
  * @param[in] access_type Access type for the shared memory area.
  * @param[in] can_fail Flag indicating if sign-up failure should be tolerated.
+ * @param[in] read_mode Synchronization strategy used by the readers of the area.
+ * @param[in] placement Memory holding the area data, AreaPlacement::EXTERNAL for large areas that are not hot.
  * @return ESP_OK if sign-up succeeds, otherwise an error code.
  */
-titan_err_t Application::SignUpSharedArea(uint8_t index, uint16_t size_in_bytes, AccessType access_type, bool can_fail) {
-    auto result = this->_shared_memory_manager->SignUpSharedArea(index, size_in_bytes, access_type);
+titan_err_t Application::SignUpSharedArea(uint8_t index, uint16_t size_in_bytes, AccessType access_type, bool can_fail,
+                                          ReadMode read_mode, AreaPlacement placement) {
+    auto result = this->_shared_memory_manager->SignUpSharedArea(index, size_in_bytes, access_type, read_mode, placement);
 
     if (!can_fail) {
         ESP_ERROR_CHECK(result);
@@ -205,6 +233,55 @@ titan_err_t Application::SignUpSharedArea(uint8_t index, uint16_t size_in_bytes,
     return result;
 }
 
+/**
+ * @brief Logs the placement of the shared memory areas signed up so far.
+ *        Intended to be called once every process is enabled.
+ */
+void Application::PrintMemoryMap(void) {
+    this->_shared_memory_manager->PrintMemoryMap();
+}
+
+/**
+ * @brief Publishes the contention and latency counters of the areas to the diagnostics area.
+ *        Requires a firmware built with -DTITANIUM_AREA_STATISTICS=1.
+ * @param[in] period_ms Delay between two publications.
+ * @param[in] can_fail Flag indicating if initialization failure should be tolerated.
+ * @return ESP_OK if the diagnostics are enabled, otherwise an error code.
+ */
+titan_err_t Application::EnableDiagnostics(uint32_t period_ms, bool can_fail) {
+    auto result = this->_shared_memory_manager->EnableDiagnostics(period_ms);
+
+    if (!can_fail) {
+        ESP_ERROR_CHECK(result);
+    }
+    return result;
+}
+
+/**
+ * @brief Logs the contention and latency counters of the shared memory areas.
+ */
+void Application::DumpAreaCounters(void) {
+    this->_shared_memory_manager->DumpAreaCounters();
+}
+
+/**
+ * @brief Flushes the persistent areas and puts the chip in deep sleep, this function does not return.
+ *        Retained areas are mirrored to RTC memory on every write and restored when they are signed up again.
+ * @param[in] sleep_time_us Time before the timer wakes the chip up, 0 to rely on the wake up sources already enabled.
+ */
+void Application::EnterDeepSleep(uint64_t sleep_time_us) {
+    auto result = this->_shared_memory_manager->FlushPersistentAreas();
+    if (result != ESP_OK) {
+        ESP_LOGE("Application", "Persistent areas not flushed before deep sleep, error: %d", result);
+    }
+
+    if (sleep_time_us > 0) {
+        esp_sleep_enable_timer_wakeup(sleep_time_us);
+    }
+
+    esp_deep_sleep_start();
+}
+
 /**
  * @brief Injects debug credentials into the credentials shared memory area.
  *        This function is intended for debugging purposes and should not be exposed in production.
@@ -215,5 +292,5 @@ void Application::InjectDebugCredentials(const char* ssid, const char* password)
     strcpy(credentials_debug.ssid, ssid);          // TODO: implement a safe strlen, strcpy and strcmp
     strcpy(credentials_debug.password, password);  // TODO: implement a safe strlen, strcpy and strcmp
 
-    this->_shared_memory_manager->Write(MEMORY_AREAS_NETWORK_CREDENTIALS, credentials_debug, network_credentials_t_msg);
+    this->_shared_memory_manager->Write<MEMORY_AREAS_NETWORK_CREDENTIALS>(credentials_debug);
 }
@@ -8,6 +8,7 @@
 #include <Drivers/LoRa/LoRaDriver.h>
 #include <Drivers/UART/UARTDriver.h>
 #include <HAL/gpio/GPIOManager.h>
+#include <HAL/memory/MessageBus.h>
 #include <HAL/memory/SharedMemoryManager.h>
 #include <HAL/spi/SPIManager.h>
 #include <SystemProcess/CommunicationProcess/inc/CommunicationProcess.h>
@@ -19,23 +20,35 @@ class Application {
    public:
     /**
      * @brief Constructor for Application class.
-     *        Initializes NVS flash and HAL components.
+     *        Initializes NVS flash and HAL components. The NVS partition is only
+     *        erased when it cannot be mounted, so persistent areas survive a reboot.
      */
     Application() {
-        nvs_flash_erase();
-        ESP_ERROR_CHECK(nvs_flash_init());
+        esp_err_t result = nvs_flash_init();
+        if ((result == ESP_ERR_NVS_NO_FREE_PAGES) || (result == ESP_ERR_NVS_NEW_VERSION_FOUND)) {
+            ESP_ERROR_CHECK(nvs_flash_erase());
+            result = nvs_flash_init();
+        }
+        ESP_ERROR_CHECK(result);
 
         this->InitializeHAL();
     };
+    titan_err_t EnableMessageBus(uint32_t process_stack, uint8_t process_priority, bool can_fail = false);
     titan_err_t EnableNetworkProcess(uint32_t process_stack, uint8_t process_priority, bool can_fail = false);
     titan_err_t EnableHTTPServerProcess(uint32_t process_stack, uint8_t process_priority, bool can_fail = false);
     titan_err_t EnableUartProcess(uint32_t process_stack, uint8_t process_priority, bool can_fail = false);
     titan_err_t EnableLoraProcess(uint32_t process_stack, uint8_t process_priority, bool can_fail = false);
     titan_err_t EnableMQTTClientProcess(uint32_t process_stack, uint8_t process_priority, bool can_fail = false);
     titan_err_t SignUpSharedArea(uint8_t index, uint16_t size_in_bytes,
-                                 AccessType access_type, bool can_fail = false);
+                                 AccessType access_type, bool can_fail = false,
+                                 ReadMode read_mode = ReadMode::LOCKED,
+                                 AreaPlacement placement = AreaPlacement::INTERNAL);
 
     void InjectDebugCredentials(const char* ssid, const char* password);
+    void PrintMemoryMap(void);
+    titan_err_t EnableDiagnostics(uint32_t period_ms, bool can_fail = false);
+    void DumpAreaCounters(void);
+    void EnterDeepSleep(uint64_t sleep_time_us);
 
     /**
      * @brief Injects debug data into a specific memory area.
@@ -58,6 +71,7 @@ class Application {
     bool _spi_initialized  = false;                               ///< Flag indicating SPI initialization status.
     bool _gpio_initialized = false;                               ///< Flag indicating GPIO initialization status.
     SharedMemoryManager* _shared_memory_manager;                  ///< Pointer to SharedMemoryManager instance.
+    MessageBus* _message_bus = nullptr;                           ///< Pointer to MessageBus instance.
     GPIOManager* _gpio_manager;                                   ///< Pointer to GPIOManager instance.
     SPIManager* _spi_manager;                                     ///< Pointer to SPIManager instance.
     NetworkProcess* _network_process;                             ///< Pointer to NetworkManager instance.
@@ -29,6 +29,7 @@ namespace Error {
     constexpr titan_err_t SERIALIZE_ERROR          = -20;
     constexpr titan_err_t DESERIALIZE_ERROR        = -21;
     constexpr titan_err_t WRITTEN_LESS_THAN_ZERO   = -22;
+    constexpr titan_err_t LOCK_TIMEOUT             = -23; /**< Error code indicating a memory area stayed locked past the timeout. */
 }  // namespace Error
 
 #endif /* ERROR_H */
\ No newline at end of file
@@ -36,6 +36,7 @@ class TimeProcess : public ProcessTemplate {
    private:
     TaskHandle_t _process_handler               = nullptr; /**< Handle for the time processing task. */
     SharedMemoryManager* _shared_memory_manager = nullptr; /**< Pointer to the shared memory manager instance used by this process. */
+    consumer_handle_t _consumer = MemoryConsumer::INVALID_CONSUMER; /**< Consumer handle used to track area updates. */
     time_process_t time_process{};
 };
 
@@ -19,9 +19,15 @@ void TimeProcess::Execute(void) {
     this->Initialize();
     uint8_t mode = 0;
 
+    if (mode == 0) {
+        this->_shared_memory_manager->Subscribe(this->_consumer, MEMORY_AREAS_TIME_PROCESS);
+    }
+
     while (1) {
         if (mode == 0) {
-            this->_shared_memory_manager->Read(MEMORY_AREAS_TIME_PROCESS, this->time_process, time_process_t_msg);
+            if (this->_shared_memory_manager->HasChangedSince(this->_consumer, MEMORY_AREAS_TIME_PROCESS)) {
+                this->_shared_memory_manager->Read<MEMORY_AREAS_TIME_PROCESS>(this->time_process);
+            }
         } else {
             uint64_t elapsed_time_us = esp_timer_get_time();
 
@@ -37,14 +43,18 @@ void TimeProcess::Execute(void) {
             this->time_process.minutes  = minutes;
             this->time_process.seconds  = seconds;
 
-            this->_shared_memory_manager->Write(MEMORY_AREAS_TIME_PROCESS, this->time_process, time_process_t_msg);
+            this->_shared_memory_manager->Write<MEMORY_AREAS_TIME_PROCESS>(this->time_process);
         }
 
         ESP_LOGI("Timer", "Elapsed time since boot: %02lu:%02lu:%02lu", this->time_process.hours,
                  this->time_process.minutes,
                  this->time_process.seconds);
 
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        if (mode == 0) {
+            this->_shared_memory_manager->WaitForUpdate(portMAX_DELAY);
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(1000));
+        }
     }
 }
 
@@ -61,6 +71,7 @@ titan_err_t TimeProcess::Initialize(void) {
     auto result = ESP_OK;
 
     this->_shared_memory_manager = SharedMemoryManager::GetInstance();
+    this->_consumer              = this->_shared_memory_manager->RegisterConsumer();
 
     return result;
 }
@@ -0,0 +1,83 @@
+/* This file is autogenerated. Do not edit manually. It is generated*/
+/* before the build process based on src/static/titanium.proto */
+#pragma once
+
+#include "HAL/memory/MemoryTypes.h"
+#include "Protocols/Protobuf/inc/titanium.pb.h"
+
+namespace AreaRegistry {
+
+    static constexpr uint8_t NUM_AREAS = 9;
+    static constexpr AreaDescriptor AREAS[] = {
+        {MEMORY_AREAS_NETWORK_CREDENTIALS, NETWORK_CREDENTIALS_SIZE, &network_credentials_t_msg, READ_WRITE, ReadMode::LOCKED, false, true, false, AreaPlacement::INTERNAL, "NetworkProcess"},
+        {MEMORY_AREAS_NETWORK_INFORMATION, NETWORK_INFORMATION_SIZE, &network_information_t_msg, READ_WRITE, ReadMode::OPTIMISTIC, true, false, false, AreaPlacement::INTERNAL, "NetworkProcess"},
+        {MEMORY_AREAS_BROKER_CONFIG, BROKER_CONFIG_SIZE, &broker_config_t_msg, READ_WRITE, ReadMode::LOCKED, false, true, false, AreaPlacement::EXTERNAL, "MQTTClientProcess"},
+        {MEMORY_AREAS_UART_SINGLE_PACKET, PACKET_REQUEST_SIZE, &packet_request_t_msg, READ_WRITE, ReadMode::LOCKED, false, false, false, AreaPlacement::INTERNAL, "UARTCommunicationProcess"},
+        {MEMORY_AREAS_UART_CONTINUOS_PACKET, CONTINUOS_PACKET_LIST_SIZE, &continuos_packet_list_t_msg, READ_WRITE, ReadMode::LOCKED, false, true, true, AreaPlacement::EXTERNAL, "UARTCommunicationProcess"},
+        {MEMORY_AREAS_LORA_SINGLE_PACKET, PACKET_REQUEST_SIZE, &packet_request_t_msg, READ_WRITE, ReadMode::LOCKED, false, false, false, AreaPlacement::INTERNAL, "LoRaCommunicationProcess"},
+        {MEMORY_AREAS_LORA_CONTINUOS_PACKET, CONTINUOS_PACKET_LIST_SIZE, &continuos_packet_list_t_msg, READ_WRITE, ReadMode::LOCKED, false, true, true, AreaPlacement::EXTERNAL, "LoRaCommunicationProcess"},
+        {MEMORY_AREAS_TIME_PROCESS, TIME_PROCESS_SIZE, &time_process_t_msg, READ_WRITE, ReadMode::LOCKED, false, false, true, AreaPlacement::INTERNAL, "TimeProcess"},
+        {MEMORY_AREAS_AREA_DIAGNOSTICS, AREA_DIAGNOSTICS_SIZE, &area_diagnostics_t_msg, READ_WRITE, ReadMode::LOCKED, false, false, false, AreaPlacement::EXTERNAL, "SharedMemoryManager"},
+    };
+
+    /**
+     * @brief Compile-time description of a memory area, specialized for every registered area.
+     */
+    template <memory_areas_t area>
+    struct Area;
+
+    template <>
+    struct Area<MEMORY_AREAS_NETWORK_CREDENTIALS> {
+        using type = network_credentials_t;
+        static constexpr const AreaDescriptor& descriptor = AREAS[0];
+    };
+
+    template <>
+    struct Area<MEMORY_AREAS_NETWORK_INFORMATION> {
+        using type = network_information_t;
+        static constexpr const AreaDescriptor& descriptor = AREAS[1];
+    };
+
+    template <>
+    struct Area<MEMORY_AREAS_BROKER_CONFIG> {
+        using type = broker_config_t;
+        static constexpr const AreaDescriptor& descriptor = AREAS[2];
+    };
+
+    template <>
+    struct Area<MEMORY_AREAS_UART_SINGLE_PACKET> {
+        using type = packet_request_t;
+        static constexpr const AreaDescriptor& descriptor = AREAS[3];
+    };
+
+    template <>
+    struct Area<MEMORY_AREAS_UART_CONTINUOS_PACKET> {
+        using type = continuos_packet_list_t;
+        static constexpr const AreaDescriptor& descriptor = AREAS[4];
+    };
+
+    template <>
+    struct Area<MEMORY_AREAS_LORA_SINGLE_PACKET> {
+        using type = packet_request_t;
+        static constexpr const AreaDescriptor& descriptor = AREAS[5];
+    };
+
+    template <>
+    struct Area<MEMORY_AREAS_LORA_CONTINUOS_PACKET> {
+        using type = continuos_packet_list_t;
+        static constexpr const AreaDescriptor& descriptor = AREAS[6];
+    };
+
+    template <>
+    struct Area<MEMORY_AREAS_TIME_PROCESS> {
+        using type = time_process_t;
+        static constexpr const AreaDescriptor& descriptor = AREAS[7];
+    };
+
+    template <>
+    struct Area<MEMORY_AREAS_AREA_DIAGNOSTICS> {
+        using type = area_diagnostics_t;
+        static constexpr const AreaDescriptor& descriptor = AREAS[8];
+    };
+
+}  // namespace AreaRegistry
@@ -0,0 +1,276 @@
+#ifndef AREA_SNAPSHOT_H
+#define AREA_SNAPSHOT_H
+
+#include <stdint.h>
+
+#include "Application/error/error_enum.h"
+#include "SharedMemory.h"
+
+namespace AreaSet {
+    constexpr uint8_t MAXIMUM_AREAS = 8; /**< Maximum amount of areas held by a snapshot or a transaction. */
+}  // namespace AreaSet
+
+class SharedMemoryManager;
+
+/**
+ * @brief Coherent read access to several memory areas.
+ *
+ * The snapshot borrows every area in ascending index order and keeps them
+ * until it is released, so no write can land in between two reads. Since
+ * transactions lock in the same order, snapshots and transactions never
+ * deadlock each other. Do not take a snapshot while holding a view or a
+ * lease of one of its areas.
+ */
+class AreaSnapshot {
+   public:
+    AreaSnapshot() = default;
+    AreaSnapshot(AreaSnapshot&&)                 = default;
+    AreaSnapshot& operator=(AreaSnapshot&&)      = default;
+    AreaSnapshot(const AreaSnapshot&)            = delete;
+    AreaSnapshot& operator=(const AreaSnapshot&) = delete;
+
+    /**
+     * @brief Checks if every requested area could be borrowed.
+     *
+     * @return bool True if the snapshot holds all its areas.
+     */
+    bool valid(void) const {
+        return this->_valid;
+    }
+
+    /**
+     * @brief Retrieves the storage of one of the areas.
+     *
+     * @param[in] area_index Index of the area.
+     * @return const uint8_t* Pointer to the area data, nullptr if the area is not part of the snapshot.
+     */
+    const uint8_t* data(uint8_t area_index) const {
+        auto view = this->Find(area_index);
+        return view == nullptr ? nullptr : view->data();
+    }
+
+    /**
+     * @brief Retrieves the amount of valid bytes of one of the areas.
+     *
+     * @param[in] area_index Index of the area.
+     * @return uint16_t The written bytes, 0 if the area is not part of the snapshot.
+     */
+    uint16_t size(uint8_t area_index) const {
+        auto view = this->Find(area_index);
+        return view == nullptr ? 0 : view->size();
+    }
+
+    /**
+     * @brief Decodes the message stored in one of the areas.
+     *
+     * @param[in] area_index Index of the area.
+     * @param[out] protobuf The message to decode into.
+     * @param[in] msg_desc Descriptor of the message.
+     * @return titan_err_t Error code indicating the result of the operation.
+     */
+    template <typename T>
+    titan_err_t Read(uint8_t area_index, T& protobuf, const pb_msgdesc_t& msg_desc) const {
+        auto view = this->Find(area_index);
+
+        if (view == nullptr) {
+            return Error::INVALID_MEMORY_AREA;
+        }
+
+        pb_istream_t istream = pb_istream_from_buffer(view->data(), view->size());
+        return pb_decode(&istream, &msg_desc, &protobuf) ? Error::NO_ERROR : Error::DESERIALIZE_ERROR;
+    }
+
+    /**
+     * @brief Gives every area back, in the reverse order they were borrowed.
+     */
+    void Release(void) {
+        while (this->_count > 0) {
+            this->_views[--this->_count].Release();
+        }
+        this->_valid = false;
+    }
+
+   private:
+    friend class SharedMemoryManager;
+
+    const SharedMemory::ReadView* Find(uint8_t area_index) const {
+        for (uint8_t i = 0; i < this->_count; i++) {
+            if (this->_areas[i] == area_index) {
+                return &this->_views[i];
+            }
+        }
+        return nullptr;
+    }
+
+    SharedMemory::ReadView _views[AreaSet::MAXIMUM_AREAS]; /**< Borrowed areas, in locking order. */
+    uint8_t _areas[AreaSet::MAXIMUM_AREAS] = {};          /**< Index of each borrowed area. */
+    uint8_t _count                         = 0;           /**< Amount of borrowed areas. */
+    bool _valid                            = false;       /**< True if every requested area was borrowed. */
+};
+
+/**
+ * @brief Atomic write access to several memory areas.
+ *
+ * The transaction leases every area in ascending index order. Writes are
+ * only staged: their size is checked against the area and the transaction
+ * keeps a reference to the message or buffer, which must stay valid until
+ * Commit. Commit copies every staged write into its area and publishes them
+ * together, locked readers and snapshots see either none or all of them and
+ * subscribers are notified once per written area. A transaction aborted or
+ * destroyed without Commit leaves the storage and the generation of every
+ * area untouched.
+ */
+class AreaTransaction {
+   public:
+    AreaTransaction() = default;
+    AreaTransaction(AreaTransaction&&)                 = default;
+    AreaTransaction& operator=(AreaTransaction&&)      = default;
+    AreaTransaction(const AreaTransaction&)            = delete;
+    AreaTransaction& operator=(const AreaTransaction&) = delete;
+
+    /**
+     * @brief Checks if every requested area could be leased.
+     *
+     * @return bool True if the transaction holds all its areas.
+     */
+    bool valid(void) const {
+        return this->_valid;
+    }
+
+    /**
+     * @brief Stages a message to be encoded into one of the areas on Commit.
+     *
+     * @param[in] area_index Index of the area.
+     * @param[in] protobuf The message to encode, must stay valid until Commit.
+     * @param[in] msg_desc Descriptor of the message.
+     * @return titan_err_t Error code indicating the result of the operation.
+     */
+    template <typename T>
+    titan_err_t Write(uint8_t area_index, T& protobuf, const pb_msgdesc_t& msg_desc) {
+        auto slot = this->FindSlot(area_index);
+
+        if (slot == AreaSet::MAXIMUM_AREAS) {
+            return Error::INVALID_MEMORY_AREA;
+        }
+
+        size_t encoded_size = 0;
+        if (!pb_get_encoded_size(&encoded_size, &msg_desc, &protobuf)) {
+            return Error::SERIALIZE_ERROR;
+        }
+
+        if (encoded_size > this->_leases[slot].capacity()) {
+            return Error::BUFFER_OUT_OF_SPACE;
+        }
+
+        this->_staged[slot] = {&protobuf, &msg_desc, static_cast<uint16_t>(encoded_size)};
+        return Error::NO_ERROR;
+    }
+
+    /**
+     * @brief Stages a raw buffer to be copied into one of the areas on Commit.
+     *
+     * @param[in] area_index Index of the area.
+     * @param[in] buffer Data to copy, must stay valid until Commit.
+     * @param[in] length Size of the data in bytes.
+     * @return titan_err_t Error code indicating the result of the operation.
+     */
+    titan_err_t Write(uint8_t area_index, const uint8_t* buffer, uint16_t length) {
+        auto slot = this->FindSlot(area_index);
+
+        if ((slot == AreaSet::MAXIMUM_AREAS) || (buffer == nullptr)) {
+            return Error::INVALID_MEMORY_AREA;
+        }
+
+        if (length > this->_leases[slot].capacity()) {
+            return Error::BUFFER_OUT_OF_SPACE;
+        }
+
+        this->_staged[slot] = {buffer, nullptr, length};
+        return Error::NO_ERROR;
+    }
+
+    /**
+     * @brief Writes every staged message and publishes them, then gives the areas back.
+     *
+     * The sizes were checked when the writes were staged, so only a message
+     * whose encoding fails on its own, e.g. in a field callback, is lost. Its
+     * area keeps its previous length and its readers are made to retry.
+     *
+     * @return titan_err_t Error code indicating the result of the operation.
+     */
+    titan_err_t Commit(void) {
+        titan_err_t result = Error::NO_ERROR;
+
+        for (uint8_t i = 0; i < this->_count; i++) {
+            auto& staged = this->_staged[i];
+            auto& lease  = this->_leases[i];
+
+            if (staged.source == nullptr) {
+                continue;
+            }
+
+            if (staged.msg_desc == nullptr) {
+                memcpy(lease.data(), staged.source, staged.length);
+                lease.Commit(staged.length);
+                continue;
+            }
+
+            pb_ostream_t ostream = pb_ostream_from_buffer(lease.data(), lease.capacity());
+            if (!pb_encode(&ostream, staged.msg_desc, staged.source)) {
+                result = Error::SERIALIZE_ERROR;
+                continue;
+            }
+            lease.Commit(ostream.bytes_written);
+        }
+
+        this->Release();
+        return result;
+    }
+
+    /**
+     * @brief Drops the staged writes and gives the areas back, none of them is written or published.
+     */
+    void Abort(void) {
+        this->Release();
+    }
+
+   private:
+    friend class SharedMemoryManager;
+
+    /**
+     * @brief Write waiting for Commit, the source belongs to the caller.
+     */
+    struct StagedWrite {
+        const void* source           = nullptr; /**< Message or buffer to write, nullptr if the area is not written. */
+        const pb_msgdesc_t* msg_desc = nullptr; /**< Descriptor of the message, nullptr for a raw buffer. */
+        uint16_t length              = 0;       /**< Encoded size of the message or length of the buffer. */
+    };
+
+    /**
+     * @brief Releases the leases in the reverse order they were taken, only the committed ones count as writes.
+     */
+    void Release(void) {
+        while (this->_count > 0) {
+            this->_staged[--this->_count] = {};
+            this->_leases[this->_count].Release();
+        }
+        this->_valid = false;
+    }
+
+    uint8_t FindSlot(uint8_t area_index) const {
+        for (uint8_t i = 0; i < this->_count; i++) {
+            if (this->_areas[i] == area_index) {
+                return i;
+            }
+        }
+        return AreaSet::MAXIMUM_AREAS;
+    }
+
+    SharedMemory::WriteLease _leases[AreaSet::MAXIMUM_AREAS]; /**< Leased areas, in locking order. */
+    StagedWrite _staged[AreaSet::MAXIMUM_AREAS];             /**< Write waiting for Commit in each leased area. */
+    uint8_t _areas[AreaSet::MAXIMUM_AREAS] = {};             /**< Index of each leased area. */
+    uint8_t _count                         = 0;              /**< Amount of leased areas. */
+    bool _valid                            = false;          /**< True if every requested area was leased. */
+};
+
+#endif /* AREA_SNAPSHOT_H */
\ No newline at end of file
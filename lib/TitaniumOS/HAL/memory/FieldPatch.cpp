@@ -0,0 +1,96 @@
+#include "FieldPatch.h"
+
+#include <string.h>
+
+#include "pb_common.h"
+
+/**
+ * @brief Copies a value into the storage of a field.
+ *
+ * @param[in] iter Iterator positioned on the field.
+ * @param[out] target Storage of the field, or of the repeated element.
+ * @param[in] value Value to assign.
+ * @param[in] size Size of the value in bytes.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+static titan_err_t AssignField(const pb_field_iter_t& iter, uint8_t* target, const void* value, size_t size) {
+    switch (PB_LTYPE(iter.type)) {
+        case PB_LTYPE_BYTES:
+        case PB_LTYPE_EXTENSION:
+            return ESP_ERR_NOT_SUPPORTED;
+
+        case PB_LTYPE_STRING:
+            if ((size == 0) || (size > iter.data_size) || (static_cast<const char*>(value)[size - 1] != '\0')) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            memcpy(target, value, size);
+            memset(target + size, 0, iter.data_size - size);
+            return ESP_OK;
+
+        default:
+            if (size != iter.data_size) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            memcpy(target, value, size);
+            return ESP_OK;
+    }
+}
+
+titan_err_t PatchField(const pb_msgdesc_t* msg_desc, void* message, FieldPath path, const void* value, size_t size) {
+    if ((msg_desc == nullptr) || (message == nullptr) || (value == nullptr) || (path.size() == 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pb_field_iter_t iter;
+    auto tag = path.begin();
+
+    while (true) {
+        if ((!pb_field_iter_begin(&iter, msg_desc, message)) || (!pb_field_iter_find(&iter, *tag))) {
+            return ESP_ERR_NOT_FOUND;
+        }
+
+        if (PB_ATYPE(iter.type) != PB_ATYPE_STATIC) {
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+
+        auto target = static_cast<uint8_t*>(iter.pData);
+        ++tag;
+
+        if (PB_HTYPE(iter.type) == PB_HTYPE_REPEATED) {
+            if (tag == path.end()) {
+                return ESP_ERR_INVALID_ARG;
+            }
+
+            pb_size_t index = *tag++;
+            /* Fixed count arrays have no count field. */
+            auto count      = static_cast<pb_size_t*>(iter.pSize);
+            auto length     = (count == nullptr) ? iter.array_size : *count;
+
+            /* Writing right after the last element grows the array by one. */
+            if ((index >= iter.array_size) || (index > length)) {
+                return ESP_ERR_INVALID_ARG;
+            }
+
+            if ((count != nullptr) && (index == length)) {
+                (*count)++;
+            }
+
+            target += index * iter.data_size;
+        } else if ((PB_HTYPE(iter.type) == PB_HTYPE_OPTIONAL) && (iter.pSize != nullptr)) {
+            *static_cast<bool*>(iter.pSize) = true;
+        } else if (PB_HTYPE(iter.type) == PB_HTYPE_ONEOF) {
+            *static_cast<pb_size_t*>(iter.pSize) = iter.tag;
+        }
+
+        if (tag == path.end()) {
+            return AssignField(iter, target, value, size);
+        }
+
+        if (!PB_LTYPE_IS_SUBMSG(iter.type)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        msg_desc = iter.submsg_desc;
+        message  = target;
+    }
+}
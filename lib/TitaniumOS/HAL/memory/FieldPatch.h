@@ -0,0 +1,44 @@
+#ifndef FIELD_PATCH_H
+#define FIELD_PATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <initializer_list>
+
+#include "Application/error/error_enum.h"
+
+#include "pb.h"
+
+/**
+ * @brief Path to a field of a decoded message, as a list of field tags.
+ *
+ * Every tag selecting a repeated field is followed by the index of the
+ * element, e.g. {CONTINUOS_PACKET_LIST_PACKET_CONFIGS_TAG, 0,
+ * PACKET_REQUEST_PACKET_INTERVAL_TAG} selects the packet_interval of the
+ * first packet config.
+ */
+using FieldPath = std::initializer_list<pb_size_t>;
+
+/**
+ * @brief Assigns a value to a field of a decoded message.
+ *
+ * Only statically allocated fields can be patched. Scalars, enums and
+ * submessages must be given with the exact size of the field, strings with
+ * at most the size of the field including the terminator. Writing the element
+ * right after the last one of a repeated field appends it.
+ *
+ * @param[in] msg_desc Descriptor of the message.
+ * @param[in,out] message The decoded message to patch.
+ * @param[in] path Path to the field.
+ * @param[in] value Value to assign.
+ * @param[in] size Size of the value in bytes.
+ * @return titan_err_t Error code indicating the result of the operation.
+ *         - ESP_ERR_NOT_FOUND if a tag of the path does not exist.
+ *         - ESP_ERR_NOT_SUPPORTED if the field is not statically allocated.
+ *         - ESP_ERR_INVALID_ARG if an index is out of range or the path is malformed.
+ *         - ESP_ERR_INVALID_SIZE if the value does not match the field.
+ */
+titan_err_t PatchField(const pb_msgdesc_t* msg_desc, void* message, FieldPath path, const void* value, size_t size);
+
+#endif /* FIELD_PATCH_H */
@@ -0,0 +1,88 @@
+#include "LinkBaseline.h"
+
+#include <string.h>
+
+/**
+ * @brief Finds the stream of an area transmission, assigning a free slot on first use.
+ *
+ * @param[in] area_index Area transmitted.
+ * @param[in] destination_address Address of the receiving device.
+ * @param[in] destination_area Area written on the receiving device.
+ * @return Stream* The stream, nullptr if every slot is taken by another transmission.
+ */
+LinkBaseline::Stream* LinkBaseline::Acquire(uint8_t area_index, uint16_t destination_address, uint8_t destination_area) {
+    Stream* free_stream = nullptr;
+
+    for (auto& stream : this->_streams) {
+        if (!stream.used) {
+            if (free_stream == nullptr) {
+                free_stream = &stream;
+            }
+            continue;
+        }
+
+        if ((stream.area_index == area_index) && (stream.destination_address == destination_address) &&
+            (stream.destination_area == destination_area)) {
+            return &stream;
+        }
+    }
+
+    if (free_stream != nullptr) {
+        free_stream->used                = true;
+        free_stream->valid               = false;
+        free_stream->area_index          = area_index;
+        free_stream->destination_address = destination_address;
+        free_stream->destination_area    = destination_area;
+        free_stream->deltas_sent         = 0;
+        free_stream->size                = 0;
+    }
+
+    return free_stream;
+}
+
+/**
+ * @brief Checks if the next transmission of a stream may be a delta.
+ *
+ * @param[in] stream Stream returned by Acquire.
+ * @return bool False if there is no baseline yet or a full frame is due.
+ */
+bool LinkBaseline::CanSendDelta(const Stream* stream) const {
+    return (stream != nullptr) && stream->valid && (stream->deltas_sent < Baseline::KEYFRAME_INTERVAL);
+}
+
+/**
+ * @brief Retains the content just transmitted as the baseline of the next delta.
+ *
+ * @param[in] stream Stream returned by Acquire.
+ * @param[in] data Content transmitted.
+ * @param[in] size Size of the content.
+ * @param[in] delta True if the content was sent as a delta, false for a full frame.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t LinkBaseline::Store(Stream* stream, const uint8_t* data, uint16_t size, bool delta) {
+    if ((stream == nullptr) || (data == nullptr)) {
+        return Error::NULL_PTR;
+    }
+
+    if (size > Baseline::IMAGE_SIZE) {
+        stream->valid = false;
+        return Error::BUFFER_OUT_OF_SPACE;
+    }
+
+    memcpy(stream->image, data, size);
+    stream->size        = size;
+    stream->valid       = true;
+    stream->deltas_sent = delta ? stream->deltas_sent + 1 : 0;
+
+    return Error::NO_ERROR;
+}
+
+/**
+ * @brief Forgets every stream, the next transmissions are full frames.
+ */
+void LinkBaseline::Reset(void) {
+    for (auto& stream : this->_streams) {
+        stream.used  = false;
+        stream.valid = false;
+    }
+}
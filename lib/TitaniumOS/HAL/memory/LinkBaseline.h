@@ -0,0 +1,59 @@
+#ifndef LINK_BASELINE_H
+#define LINK_BASELINE_H
+
+#include <stdint.h>
+
+#include "Application/error/error_enum.h"
+
+#ifndef TITANIUM_DELTA_IMAGE_SIZE
+#define TITANIUM_DELTA_IMAGE_SIZE 256 /**< Overridable with a build flag to send deltas of larger areas. */
+#endif
+
+#ifndef TITANIUM_DELTA_KEYFRAME_INTERVAL
+#define TITANIUM_DELTA_KEYFRAME_INTERVAL 16 /**< Overridable with a build flag to trade recovery time for airtime. */
+#endif
+
+namespace Baseline {
+    constexpr uint8_t MAXIMUM_STREAMS   = 8;                                /**< Area transmissions tracked by a link, one per continuos packet. */
+    constexpr uint16_t IMAGE_SIZE       = TITANIUM_DELTA_IMAGE_SIZE;        /**< Largest area content retained, larger areas are always sent in full. */
+    constexpr uint8_t KEYFRAME_INTERVAL = TITANIUM_DELTA_KEYFRAME_INTERVAL; /**< Deltas sent in a row before a full frame is forced. */
+}  // namespace Baseline
+
+/**
+ * @brief Content of the memory areas last transmitted over a link.
+ *
+ * Each stream is an area sent to a destination address and area, and keeps
+ * the image the receiver is expected to hold so the next transmission can be
+ * encoded as a delta against it. The links are unacknowledged, so a lost
+ * frame leaves the receiver on another image: it rejects the following
+ * deltas and resynchronizes on the full frame forced every
+ * Baseline::KEYFRAME_INTERVAL transmissions.
+ */
+class LinkBaseline {
+   public:
+    /**
+     * @brief Retained transmission of an area to a destination.
+     */
+    struct Stream {
+        bool used                    = false; /**< True once the slot is assigned to a stream. */
+        bool valid                   = false; /**< True if image holds the last transmitted content. */
+        uint8_t area_index           = 0;     /**< Area transmitted. */
+        uint16_t destination_address = 0;     /**< Address of the receiving device. */
+        uint8_t destination_area     = 0;     /**< Area written on the receiving device. */
+        uint8_t deltas_sent          = 0;     /**< Deltas sent since the last full frame. */
+        uint16_t size                = 0;     /**< Valid bytes in image. */
+        alignas(4) uint8_t image[Baseline::IMAGE_SIZE]; /**< Content last transmitted. */
+    };
+
+    LinkBaseline() {};
+
+    Stream* Acquire(uint8_t area_index, uint16_t destination_address, uint8_t destination_area);
+    bool CanSendDelta(const Stream* stream) const;
+    titan_err_t Store(Stream* stream, const uint8_t* data, uint16_t size, bool delta);
+    void Reset(void);
+
+   private:
+    Stream _streams[Baseline::MAXIMUM_STREAMS];
+};
+
+#endif /* LINK_BASELINE_H */
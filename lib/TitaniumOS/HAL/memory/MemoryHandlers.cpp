@@ -1,12 +1,45 @@
 #include "string.h"
 #include "MemoryHandlers.h"
 
+/**
+ * Buffers are walked a 32 bits word at a time once the pointers are aligned,
+ * four words per iteration so the Xtensa loop overhead is paid once per 16
+ * bytes. Words are accessed through a may_alias type since the buffers hold
+ * arbitrary bytes.
+ */
+typedef uint32_t __attribute__((__may_alias__)) memory_word_t;
+
+namespace MemoryWord {
+    constexpr uint32_t SIZE          = sizeof(memory_word_t); /**< Bytes handled per access. */
+    constexpr uintptr_t ALIGNMENT    = SIZE - 1;              /**< Address bits that must be clear for a word access. */
+    constexpr uint32_t UNROLLED_SIZE = 4 * SIZE;              /**< Bytes handled per unrolled iteration. */
+    constexpr uint32_t BYTE_SPREAD   = 0x01010101;            /**< Replicates a byte over the four bytes of a word. */
+}  // namespace MemoryWord
+
+/**
+ * @brief Checks if two buffers can be walked a word at a time after the same amount of leading bytes.
+ */
+static inline bool IsCoAligned(const void* first, const void* second) {
+    return ((reinterpret_cast<uintptr_t>(first) ^ reinterpret_cast<uintptr_t>(second)) & MemoryWord::ALIGNMENT) == 0;
+}
+
+/**
+ * @brief Counts the leading bytes to handle one at a time before the pointer is word aligned.
+ */
+static inline uint32_t LeadingBytes(const void* pointer, uint32_t size_in_bytes) {
+    uint32_t leading = (MemoryWord::SIZE - (reinterpret_cast<uintptr_t>(pointer) & MemoryWord::ALIGNMENT)) &
+                       MemoryWord::ALIGNMENT;
+    return leading < size_in_bytes ? leading : size_in_bytes;
+}
+
 /**
  * @brief Copies a specified number of bytes from one memory location to another.
  *
  * This function copies size_in_bytes bytes of data from the source memory
  * location pIn to the destination memory location pOut, while performing checks
- * for invalid sizes and memory availability.
+ * for invalid sizes and memory availability. The copy is left to the ROM
+ * memcpy, which already moves aligned words and realigns misaligned sources
+ * with funnel shifts, something a portable word loop cannot match.
  *
  * @tparam T Type of the elements in the memory buffer.
  * @param[out] pOut Pointer to the destination memory buffer.
@@ -40,7 +73,8 @@ titan_err_t memcpy_s(void* pOut, void* pIn, uint32_t size_in_bytes) {
  * @brief Compares two memory buffers for equality.
  *
  * This function compares two memory buffers, pOut and pIn, of size
- * size_in_bytes for equality.
+ * size_in_bytes for equality. It returns on the first difference, use
+ * memcmp_ct_s to compare secrets.
  *
  * @tparam T Type of the elements in the memory buffer.
  * @param[out] pOut Pointer to the destination memory buffer.
@@ -65,11 +99,51 @@ titan_err_t memcmp_s(void* pOut, void* pIn, uint32_t size_in_bytes) {
             break;
         }
 
-        uint8_t* internal_input_pointer  = reinterpret_cast<uint8_t*>(pIn);
-        uint8_t* internal_output_pointer = reinterpret_cast<uint8_t*>(pOut);
+        auto internal_input_pointer  = reinterpret_cast<const uint8_t*>(pIn);
+        auto internal_output_pointer = reinterpret_cast<const uint8_t*>(pOut);
+        uint32_t remaining           = size_in_bytes;
+
+        /* The leading bytes are compared by the byte loop below when the buffers cannot be walked by words. */
+        if (IsCoAligned(pOut, pIn)) {
+            uint32_t leading = LeadingBytes(pOut, remaining);
+
+            if (memcmp(internal_output_pointer, internal_input_pointer, leading) != 0) {
+                result = Error::UNKNOW_FAIL;
+                break;
+            }
+            internal_output_pointer += leading;
+            internal_input_pointer += leading;
+            remaining -= leading;
+
+            auto output_words = reinterpret_cast<const memory_word_t*>(internal_output_pointer);
+            auto input_words  = reinterpret_cast<const memory_word_t*>(internal_input_pointer);
 
-        for (uint32_t i = 0; i < size_in_bytes; i++) {
-            if (internal_output_pointer[i] != internal_input_pointer[i]) {
+            for (; remaining >= MemoryWord::UNROLLED_SIZE; remaining -= MemoryWord::UNROLLED_SIZE) {
+                if (((output_words[0] ^ input_words[0]) | (output_words[1] ^ input_words[1]) |
+                     (output_words[2] ^ input_words[2]) | (output_words[3] ^ input_words[3])) != 0) {
+                    result = Error::UNKNOW_FAIL;
+                    break;
+                }
+                output_words += 4;
+                input_words += 4;
+            }
+
+            for (; (result == ESP_OK) && (remaining >= MemoryWord::SIZE); remaining -= MemoryWord::SIZE) {
+                if (*output_words++ != *input_words++) {
+                    result = Error::UNKNOW_FAIL;
+                }
+            }
+
+            if (result != ESP_OK) {
+                break;
+            }
+
+            internal_output_pointer = reinterpret_cast<const uint8_t*>(output_words);
+            internal_input_pointer  = reinterpret_cast<const uint8_t*>(input_words);
+        }
+
+        for (; remaining > 0; remaining--) {
+            if (*internal_output_pointer++ != *internal_input_pointer++) {
                 result = Error::UNKNOW_FAIL;
                 break;
             }
@@ -109,12 +183,95 @@ titan_err_t memset_s(void* pOut, uint8_t value, uint32_t size_in_bytes) {
             break;
         }
 
-        uint8_t* internal_output_pointer = reinterpret_cast<uint8_t*>(pOut);
+        auto internal_output_pointer = reinterpret_cast<uint8_t*>(pOut);
+        uint32_t remaining           = size_in_bytes;
+
+        for (uint32_t leading = LeadingBytes(pOut, remaining); leading > 0; leading--, remaining--) {
+            *internal_output_pointer++ = value;
+        }
+
+        memory_word_t word = value * MemoryWord::BYTE_SPREAD;
+        auto output_words  = reinterpret_cast<memory_word_t*>(internal_output_pointer);
+
+        for (; remaining >= MemoryWord::UNROLLED_SIZE; remaining -= MemoryWord::UNROLLED_SIZE) {
+            output_words[0] = word;
+            output_words[1] = word;
+            output_words[2] = word;
+            output_words[3] = word;
+            output_words += 4;
+        }
+
+        for (; remaining >= MemoryWord::SIZE; remaining -= MemoryWord::SIZE) {
+            *output_words++ = word;
+        }
+
+        internal_output_pointer = reinterpret_cast<uint8_t*>(output_words);
+
+        for (; remaining > 0; remaining--) {
+            *internal_output_pointer++ = value;
+        }
+
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Compares two memory buffers for equality in constant time.
+ *
+ * Unlike memcmp_s every byte is compared whatever the content, so the time
+ * taken does not reveal how many leading bytes matched. Meant for secrets
+ * such as keys, tokens or passwords.
+ *
+ * @param[in] pOut Pointer to the first memory buffer.
+ * @param[in] pIn Pointer to the second memory buffer.
+ * @param[in] size_in_bytes Size of the memory buffers in bytes.
+ * @return titan_err_t Error code indicating the result of the comparison.
+ *         - ESP_OK if the memory buffers are equal.
+ *         - ESP_ERR_INVALID_SIZE if size_in_bytes is 0.
+ *         - ESP_ERR_NO_MEM if either pOut or pIn is nullptr.
+ *         - Error::UNKNOW_FAIL if the memory buffers are not equal.
+ */
+titan_err_t memcmp_ct_s(const void* pOut, const void* pIn, uint32_t size_in_bytes) {
+    titan_err_t result = ESP_OK;
+
+    do {
+        if (size_in_bytes == 0) {
+            result = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+        if (pOut == nullptr || pIn == nullptr) {
+            result = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        auto internal_input_pointer  = reinterpret_cast<const uint8_t*>(pIn);
+        auto internal_output_pointer = reinterpret_cast<const uint8_t*>(pOut);
+        uint32_t remaining           = size_in_bytes;
+        memory_word_t difference     = 0;
+
+        /* The path taken depends on the addresses only, never on the content. */
+        if (IsCoAligned(pOut, pIn)) {
+            for (uint32_t leading = LeadingBytes(pOut, remaining); leading > 0; leading--, remaining--) {
+                difference |= *internal_output_pointer++ ^ *internal_input_pointer++;
+            }
+
+            auto output_words = reinterpret_cast<const memory_word_t*>(internal_output_pointer);
+            auto input_words  = reinterpret_cast<const memory_word_t*>(internal_input_pointer);
+
+            for (; remaining >= MemoryWord::SIZE; remaining -= MemoryWord::SIZE) {
+                difference |= *output_words++ ^ *input_words++;
+            }
+
+            internal_output_pointer = reinterpret_cast<const uint8_t*>(output_words);
+            internal_input_pointer  = reinterpret_cast<const uint8_t*>(input_words);
+        }
 
-        for (uint32_t i = 0; i < size_in_bytes; i++) {
-            internal_output_pointer[i] = value;
+        for (; remaining > 0; remaining--) {
+            difference |= *internal_output_pointer++ ^ *internal_input_pointer++;
         }
 
+        result = (difference == 0) ? ESP_OK : Error::UNKNOW_FAIL;
     } while (0);
 
     return result;
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
+#include <pb.h>
+
 /**
  * @brief Enumeration of access types for a resource.
  */
@@ -12,4 +14,54 @@ enum AccessType : uint8_t {
     READ_WRITE,    /**< Read-write access type. */
 };
 
+/**
+ * @brief Enumeration of the synchronization strategies used by readers of a memory area.
+ */
+enum class ReadMode : uint8_t {
+    LOCKED = 0, /**< Readers take the area mutex, serializing with writers and other readers. */
+    OPTIMISTIC, /**< Readers copy without the mutex and retry if a write happened meanwhile (seqlock). */
+};
+
+/**
+ * @brief Enumeration of the layouts of a memory area.
+ */
+enum class AreaKind : uint8_t {
+    LATEST = 0, /**< The area holds the latest value, every write replaces the previous one. */
+    RING,       /**< The area holds a fixed-capacity ring of timestamped records. */
+};
+
+/**
+ * @brief Enumeration of the memories the data of an area can be placed in.
+ */
+enum class AreaPlacement : uint8_t {
+    INTERNAL = 0, /**< Static arena in internal DRAM, also reachable while the flash cache is disabled. */
+    EXTERNAL,     /**< PSRAM, frees internal memory for stacks and DMA buffers. Falls back to INTERNAL without PSRAM. */
+};
+
+/**
+ * @brief Header stored in front of every record of a ring area.
+ */
+struct RingRecordHeader {
+    uint32_t sequence;    /**< Sequence number of the record, the cursor used to read it. */
+    uint16_t length;      /**< Length of the record payload that follows the header. */
+    uint16_t reserved;    /**< Padding, keeps the timestamp aligned. */
+    int64_t timestamp_us; /**< Time since boot when the record was appended. */
+};
+
+/**
+ * @brief Static description of a shared memory area, generated from titanium.proto.
+ */
+struct AreaDescriptor {
+    uint8_t index;                /**< Index of the area in the shared memory manager. */
+    uint16_t size;                /**< Maximum encoded size of the area message. */
+    const pb_msgdesc_t* msg_desc; /**< Nanopb descriptor of the area message. */
+    AccessType access_type;       /**< Access type of the area. */
+    ReadMode read_mode;           /**< Synchronization strategy used by the readers of the area. */
+    bool cached;                  /**< Keeps the last decoded struct next to the encoded bytes. */
+    bool persistent;              /**< Mirrors the area to NVS and restores it after a reset. */
+    bool retained;                /**< Mirrors the area to RTC memory and restores it after a deep sleep. */
+    AreaPlacement placement;      /**< Memory holding the area data. */
+    const char* owner;            /**< Name of the process that owns the area. */
+};
+
 #endif /* MEMORY_TYPES_H */
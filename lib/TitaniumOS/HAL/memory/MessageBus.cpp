@@ -0,0 +1,333 @@
+#include "MessageBus.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+
+static const char* TAG = "MessageBus";
+
+BusBuffer MessageBus::_buffers[Bus::BUFFERS];
+
+/**
+ * @brief Starts the dispatcher task and attaches the bus to the shared memory manager.
+ *
+ * From then on every completed write to an area is published, producers do
+ * not need to call Publish themselves.
+ *
+ * @param[in] stack_size Stack size of the dispatcher task, callbacks run on it.
+ * @param[in] priority Priority of the dispatcher task.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t MessageBus::Start(uint32_t stack_size, UBaseType_t priority) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+
+    do {
+        if (this->_dispatcher != nullptr) {
+            result = ESP_ERR_INVALID_STATE;
+            break;
+        }
+
+        this->_shared_memory_manager = SharedMemoryManager::GetInstance();
+
+        if (xTaskCreatePinnedToCore(MessageBus::DispatchTask, "message_bus", stack_size, this, priority,
+                                    &this->_dispatcher, 0) != pdPASS) {
+            result = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        result = this->_shared_memory_manager->SetWriteHook(MessageBus::OnAreaWritten, this);
+        if (result != ESP_OK) {
+            /* Nothing would ever be published, the bus must not look started. */
+            vTaskDelete(this->_dispatcher);
+            this->_dispatcher = nullptr;
+        }
+
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Checks if the dispatcher is running, subscribers only receive messages once it is.
+ *
+ * @return bool True if Start succeeded.
+ */
+bool MessageBus::IsStarted(void) {
+    return this->_dispatcher != nullptr;
+}
+
+/**
+ * @brief Attaches a callback to the writes of a set of areas.
+ *
+ * @param[in] area_mask Bit mask of the areas, (1 << area_index) for each area, Bus::ALL_AREAS for every area.
+ * @param[in] callback Called from the dispatcher task for every message.
+ * @param[in] context Context passed to the callback.
+ * @return subscriber_handle_t Handle of the subscriber, Bus::INVALID_SUBSCRIBER if the bus is not started or full.
+ */
+subscriber_handle_t MessageBus::Subscribe(uint32_t area_mask, bus_callback_t callback, void* context) {
+    if (callback == nullptr) {
+        return Bus::INVALID_SUBSCRIBER;
+    }
+
+    return this->AddSubscriber(area_mask, callback, context, nullptr);
+}
+
+/**
+ * @brief Attaches a queue to the writes of a set of areas.
+ *
+ * The queue must be created with MessageBus::QUEUE_ITEM_SIZE items and
+ * drained with Receive. Each queued item holds a buffer of the pool, a queue
+ * that is not drained starves the other subscribers.
+ *
+ * @param[in] area_mask Bit mask of the areas, (1 << area_index) for each area, Bus::ALL_AREAS for every area.
+ * @param[in] queue Queue receiving the messages.
+ * @return subscriber_handle_t Handle of the subscriber, Bus::INVALID_SUBSCRIBER if the bus is not started or full.
+ */
+subscriber_handle_t MessageBus::Subscribe(uint32_t area_mask, QueueHandle_t queue) {
+    if (queue == nullptr) {
+        return Bus::INVALID_SUBSCRIBER;
+    }
+
+    return this->AddSubscriber(area_mask, nullptr, nullptr, queue);
+}
+
+/**
+ * @brief Stops delivering messages to a subscriber.
+ *
+ * A message being dispatched while the subscriber is removed may still be
+ * delivered. The slot is not reused.
+ *
+ * @param[in] subscriber Handle returned by Subscribe.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t MessageBus::Unsubscribe(subscriber_handle_t subscriber) {
+    if (subscriber >= this->_num_subscribers.load()) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    this->_subscribers[subscriber].area_mask.store(0, std::memory_order_release);
+    return ESP_OK;
+}
+
+/**
+ * @brief Announces a write to an area.
+ *
+ * Only needed for areas written outside the shared memory manager, the
+ * manager publishes its own writes once the bus is started.
+ *
+ * @param[in] area_index Index of the area that was written.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t MessageBus::Publish(uint8_t area_index) {
+    if (area_index >= Bus::MAXIMUM_AREAS) {
+        return Error::INVALID_MEMORY_AREA;
+    }
+
+    if (this->_dispatcher == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xTaskNotify(this->_dispatcher, 1UL << area_index, eSetBits);
+    return ESP_OK;
+}
+
+/**
+ * @brief Takes the next message posted to a subscriber queue.
+ *
+ * @param[in] queue Queue given to Subscribe.
+ * @param[out] message Receives the message, the queued reference is moved into it.
+ * @param[in] timeout Maximum amount of ticks to wait.
+ * @return bool True if a message was received.
+ */
+bool MessageBus::Receive(QueueHandle_t queue, BusMessage& message, TickType_t timeout) {
+    BusBuffer* buffer = nullptr;
+
+    if (xQueueReceive(queue, &buffer, timeout) != pdTRUE) {
+        return false;
+    }
+
+    message = BusMessage(buffer);
+    return true;
+}
+
+/**
+ * @brief Retrieves the messages a queue subscriber lost because its queue was full.
+ *
+ * @param[in] subscriber Handle returned by Subscribe.
+ * @return uint32_t Amount of dropped messages.
+ */
+uint32_t MessageBus::GetDroppedMessages(subscriber_handle_t subscriber) {
+    if (subscriber >= this->_num_subscribers.load()) {
+        return 0;
+    }
+
+    return this->_subscribers[subscriber].dropped.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retrieves the writes that could not be dispatched because every buffer was in flight.
+ *
+ * @return uint32_t Amount of skipped dispatches.
+ */
+uint32_t MessageBus::GetExhaustedBuffers(void) {
+    return this->_exhausted.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Dispatcher loop, fans out every area written since the last wakeup.
+ *
+ * @param[in] parameters Pointer to the MessageBus.
+ */
+void MessageBus::DispatchTask(void* parameters) {
+    auto bus               = static_cast<MessageBus*>(parameters);
+    uint32_t written_areas = 0;
+
+    while (1) {
+        if (xTaskNotifyWait(0, UINT32_MAX, &written_areas, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        while (written_areas != 0) {
+            auto area_index = static_cast<uint8_t>(__builtin_ctz(written_areas));
+            written_areas &= written_areas - 1;
+
+            bus->Dispatch(area_index);
+        }
+    }
+}
+
+/**
+ * @brief Publishes the writes completed through the shared memory manager.
+ *
+ * @param[in] context Pointer to the MessageBus.
+ * @param[in] area_index Index of the area that was written.
+ */
+void MessageBus::OnAreaWritten(void* context, uint8_t area_index) {
+    static_cast<MessageBus*>(context)->Publish(area_index);
+}
+
+/**
+ * @brief Copies an area once and hands the copy to every interested subscriber.
+ *
+ * An area still locked after Bus::LOCK_TIMEOUT_MS is announced without payload.
+ *
+ * @param[in] area_index Index of the area that was written.
+ */
+void MessageBus::Dispatch(uint8_t area_index) {
+    uint32_t area_bit = 1UL << area_index;
+    uint8_t count     = this->_num_subscribers.load();
+    bool interested   = false;
+
+    if (count > Bus::MAXIMUM_SUBSCRIBERS) {
+        count = Bus::MAXIMUM_SUBSCRIBERS;
+    }
+
+    for (uint8_t i = 0; (i < count) && (!interested); i++) {
+        interested = (this->_subscribers[i].area_mask.load(std::memory_order_acquire) & area_bit) != 0;
+    }
+
+    if (!interested) {
+        return;
+    }
+
+    auto buffer = this->AcquireBuffer();
+    if (buffer == nullptr) {
+        this->_exhausted.fetch_add(1, std::memory_order_relaxed);
+        ESP_LOGW(TAG, "No buffer left, write to area %d not dispatched", area_index);
+        return;
+    }
+
+    buffer->area_index  = area_index;
+    buffer->has_payload = false;
+    buffer->size        = 0;
+
+    /* A writer stuck on this area must not hold back the messages of the others. */
+    auto view          = this->_shared_memory_manager->Borrow(area_index, pdMS_TO_TICKS(Bus::LOCK_TIMEOUT_MS));
+    buffer->generation = this->_shared_memory_manager->GetGeneration(area_index);
+
+    if (view.valid() && (this->_shared_memory_manager->GetAreaKind(area_index) == AreaKind::LATEST) &&
+        (view.size() <= Bus::BUFFER_SIZE)) {
+        memcpy(buffer->data, view.data(), view.size());
+        buffer->size        = view.size();
+        buffer->has_payload = true;
+    }
+    view.Release();
+
+    BusMessage message(buffer);
+
+    for (uint8_t i = 0; i < count; i++) {
+        auto& subscriber = this->_subscribers[i];
+
+        if ((subscriber.area_mask.load(std::memory_order_acquire) & area_bit) == 0) {
+            continue;
+        }
+
+        if (subscriber.callback != nullptr) {
+            subscriber.callback(message, subscriber.context);
+            continue;
+        }
+
+        /* The queued pointer owns a reference, handed over to the BusMessage built by Receive. */
+        buffer->references.fetch_add(1, std::memory_order_relaxed);
+        if (xQueueSend(subscriber.queue, &buffer, 0) != pdTRUE) {
+            buffer->references.fetch_sub(1, std::memory_order_relaxed);
+            subscriber.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Takes a free buffer from the pool.
+ *
+ * @return BusBuffer* Buffer holding one reference, nullptr if every buffer is in flight.
+ */
+BusBuffer* MessageBus::AcquireBuffer(void) {
+    for (auto& buffer : MessageBus::_buffers) {
+        uint8_t free = 0;
+        if (buffer.references.compare_exchange_strong(free, 1, std::memory_order_acquire)) {
+            return &buffer;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Fills a free subscriber slot and publishes it to the dispatcher.
+ *
+ * @return subscriber_handle_t Handle of the subscriber, Bus::INVALID_SUBSCRIBER if the bus is not started or every slot is in use.
+ */
+subscriber_handle_t MessageBus::AddSubscriber(uint32_t area_mask, bus_callback_t callback, void* context,
+                                              QueueHandle_t queue) {
+    /* Nothing would ever be delivered, fail here rather than leave the subscriber waiting. */
+    if (!this->IsStarted()) {
+        return Bus::INVALID_SUBSCRIBER;
+    }
+
+    auto subscriber = this->_num_subscribers.fetch_add(1);
+
+    if (subscriber >= Bus::MAXIMUM_SUBSCRIBERS) {
+        this->_num_subscribers.store(Bus::MAXIMUM_SUBSCRIBERS);
+        return Bus::INVALID_SUBSCRIBER;
+    }
+
+    this->_subscribers[subscriber].callback = callback;
+    this->_subscribers[subscriber].context  = context;
+    this->_subscribers[subscriber].queue    = queue;
+    this->_subscribers[subscriber].area_mask.store(area_mask, std::memory_order_release);
+
+    return subscriber;
+}
+
+/**
+ * @brief Retrieves the singleton instance of MessageBus.
+ *
+ * @return MessageBus* Pointer to the singleton instance of MessageBus.
+ */
+MessageBus* MessageBus::GetInstance(void) {
+    if (singleton_pointer_ == nullptr) {
+        singleton_pointer_ = new MessageBus();
+    }
+
+    return singleton_pointer_;
+}
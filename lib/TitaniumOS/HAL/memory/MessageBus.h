@@ -0,0 +1,247 @@
+#ifndef MESSAGE_BUS_H
+#define MESSAGE_BUS_H
+
+#include <freertos/FreeRTOS.h>
+#include "freertos/queue.h"
+#include <freertos/task.h>
+
+#include <stdint.h>
+#include <atomic>
+
+#include "Application/error/error_enum.h"
+#include "SharedMemoryManager.h"
+
+#ifndef TITANIUM_BUS_BUFFERS
+#define TITANIUM_BUS_BUFFERS 8 /**< Overridable with a build flag when many queue subscribers hold messages. */
+#endif
+
+#ifndef TITANIUM_BUS_BUFFER_SIZE
+#define TITANIUM_BUS_BUFFER_SIZE 256 /**< Overridable with a build flag to carry the payload of larger areas. */
+#endif
+
+/**
+ * @brief Handle identifying a subscriber of the message bus.
+ */
+typedef uint8_t subscriber_handle_t;
+
+namespace Bus {
+    constexpr uint8_t BUFFERS             = TITANIUM_BUS_BUFFERS;     /**< Messages that can be in flight at once. */
+    constexpr uint16_t BUFFER_SIZE        = TITANIUM_BUS_BUFFER_SIZE; /**< Largest payload carried by a message. */
+    constexpr uint8_t MAXIMUM_SUBSCRIBERS = 16;                       /**< Callbacks and queues attached to the bus. */
+    constexpr uint8_t MAXIMUM_AREAS       = 32;                       /**< Areas addressable by a 32 bits area mask. */
+    constexpr uint32_t ALL_AREAS          = UINT32_MAX;               /**< Area mask matching every memory area. */
+    constexpr subscriber_handle_t INVALID_SUBSCRIBER = 0xFF;          /**< Handle returned when no subscriber slot is available. */
+    constexpr uint32_t LOCK_TIMEOUT_MS    = 50;                       /**< Longest wait for a written area, the message then goes out without payload. */
+}  // namespace Bus
+
+/**
+ * @brief Refcounted storage of a message, owned by the bus pool.
+ *
+ * A reference count of 0 means the buffer is free.
+ */
+struct BusBuffer {
+    std::atomic<uint8_t> references{0}; /**< Messages pointing to the buffer. */
+    uint8_t area_index   = 0;           /**< Index of the area the message comes from. */
+    bool has_payload     = false;       /**< True if data holds the content of the area. */
+    uint16_t size        = 0;           /**< Valid bytes in data. */
+    uint32_t generation  = 0;           /**< Generation of the area when it was copied. */
+    alignas(4) uint8_t data[Bus::BUFFER_SIZE]; /**< Content of the area. */
+};
+
+/**
+ * @brief Handle over a message published on the bus.
+ *
+ * Copying a message only takes a reference on its buffer, so every
+ * subscriber sees the same bytes without another copy. The buffer goes back
+ * to the pool when the last handle is released or destroyed. The payload is
+ * read only.
+ */
+class BusMessage {
+   public:
+    BusMessage() = default;
+
+    BusMessage(const BusMessage& other) : _buffer(other._buffer) {
+        if (this->_buffer != nullptr) {
+            this->_buffer->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    BusMessage(BusMessage&& other) : _buffer(other._buffer) {
+        other._buffer = nullptr;
+    }
+
+    BusMessage& operator=(const BusMessage& other) {
+        if (this != &other) {
+            this->Release();
+            this->_buffer = other._buffer;
+            if (this->_buffer != nullptr) {
+                this->_buffer->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return *this;
+    }
+
+    BusMessage& operator=(BusMessage&& other) {
+        if (this != &other) {
+            this->Release();
+            this->_buffer = other._buffer;
+            other._buffer = nullptr;
+        }
+        return *this;
+    }
+
+    ~BusMessage() {
+        this->Release();
+    }
+
+    /**
+     * @brief Checks if the handle holds a message.
+     *
+     * @return bool True if the message can be read.
+     */
+    bool valid(void) const {
+        return this->_buffer != nullptr;
+    }
+
+    /**
+     * @brief Retrieves the index of the area that was written.
+     *
+     * @return uint8_t Index of the area, 0 if the message is not valid.
+     */
+    uint8_t area(void) const {
+        return this->valid() ? this->_buffer->area_index : 0;
+    }
+
+    /**
+     * @brief Retrieves the generation of the area carried by the message.
+     *
+     * Writes landing while the bus is busy are coalesced, so generations may
+     * skip values.
+     *
+     * @return uint32_t Generation of the area, 0 if the message is not valid.
+     */
+    uint32_t generation(void) const {
+        return this->valid() ? this->_buffer->generation : 0;
+    }
+
+    /**
+     * @brief Checks if the message carries the content of the area.
+     *
+     * Ring areas, write only areas, areas larger than Bus::BUFFER_SIZE and
+     * areas held past Bus::LOCK_TIMEOUT_MS are announced without payload,
+     * subscribers read them from the area.
+     *
+     * @return bool True if data() holds the content of the area.
+     */
+    bool has_payload(void) const {
+        return this->valid() && this->_buffer->has_payload;
+    }
+
+    /**
+     * @brief Retrieves the content of the area.
+     *
+     * @return const uint8_t* Pointer to the payload, nullptr if the message has none.
+     */
+    const uint8_t* data(void) const {
+        return this->has_payload() ? this->_buffer->data : nullptr;
+    }
+
+    /**
+     * @brief Retrieves the size of the payload.
+     *
+     * @return uint16_t Amount of valid bytes, 0 if the message has no payload.
+     */
+    uint16_t size(void) const {
+        return this->has_payload() ? this->_buffer->size : 0;
+    }
+
+    /**
+     * @brief Drops the reference before the handle goes out of scope.
+     */
+    void Release(void) {
+        if (this->_buffer != nullptr) {
+            this->_buffer->references.fetch_sub(1, std::memory_order_acq_rel);
+            this->_buffer = nullptr;
+        }
+    }
+
+   private:
+    friend class MessageBus;
+
+    /**
+     * @brief Adopts a reference already taken on the buffer.
+     */
+    explicit BusMessage(BusBuffer* buffer) : _buffer(buffer) {}
+
+    BusBuffer* _buffer = nullptr; /**< Referenced buffer, nullptr once released. */
+};
+
+/**
+ * @brief In-process publish/subscribe bus layered over the shared memory areas.
+ *
+ * Every completed write to an area sets its bit in the notification value of
+ * the dispatcher task. The dispatcher copies each written area once into a
+ * pooled buffer and hands references to it to every interested subscriber,
+ * either by calling it or by posting to its queue, so a single wakeup serves
+ * all the subscribers. Writes landing before the dispatcher runs are
+ * coalesced, subscribers always see the latest content of the area.
+ */
+class MessageBus {
+   public:
+    /**
+     * @brief Callback invoked from the dispatcher task for every message. Keep it short, copy the message to
+     *        keep the payload beyond the call.
+     */
+    typedef void (*bus_callback_t)(const BusMessage& message, void* context);
+
+    /**
+     * @brief Size of the items of a subscriber queue, create the queue with xQueueCreate(depth, QUEUE_ITEM_SIZE).
+     */
+    static constexpr UBaseType_t QUEUE_ITEM_SIZE = sizeof(BusBuffer*);
+
+    MessageBus(const MessageBus& obj) = delete;
+    static MessageBus* GetInstance(void);
+
+    titan_err_t Start(uint32_t stack_size, UBaseType_t priority);
+    bool IsStarted(void);
+    subscriber_handle_t Subscribe(uint32_t area_mask, bus_callback_t callback, void* context);
+    subscriber_handle_t Subscribe(uint32_t area_mask, QueueHandle_t queue);
+    titan_err_t Unsubscribe(subscriber_handle_t subscriber);
+    titan_err_t Publish(uint8_t area_index);
+    static bool Receive(QueueHandle_t queue, BusMessage& message, TickType_t timeout);
+    uint32_t GetDroppedMessages(subscriber_handle_t subscriber);
+    uint32_t GetExhaustedBuffers(void);
+
+   private:
+    MessageBus() {};
+    static MessageBus* singleton_pointer_;
+    static void DispatchTask(void* parameters);
+    static void OnAreaWritten(void* context, uint8_t area_index);
+    void Dispatch(uint8_t area_index);
+    BusBuffer* AcquireBuffer(void);
+    subscriber_handle_t AddSubscriber(uint32_t area_mask, bus_callback_t callback, void* context, QueueHandle_t queue);
+
+    /**
+     * @brief Callback or queue attached to the bus.
+     *
+     * The slot is filled before its mask is published, so the dispatcher never
+     * sees a half written subscriber.
+     */
+    struct Subscriber {
+        std::atomic<uint32_t> area_mask{0};  /**< Areas the subscriber is interested in, 0 if unused. */
+        bus_callback_t callback = nullptr;   /**< Called for every message, nullptr for queue subscribers. */
+        void* context           = nullptr;   /**< Context passed to the callback. */
+        QueueHandle_t queue     = nullptr;   /**< Receives a reference to every message, nullptr for callbacks. */
+        std::atomic<uint32_t> dropped{0};    /**< Messages lost because the queue was full. */
+    };
+
+   private:
+    static BusBuffer _buffers[Bus::BUFFERS];
+    Subscriber _subscribers[Bus::MAXIMUM_SUBSCRIBERS];
+    std::atomic<uint8_t> _num_subscribers{0};
+    std::atomic<uint32_t> _exhausted{0};                  /**< Areas not dispatched because every buffer was in flight. */
+    TaskHandle_t _dispatcher                    = nullptr; /**< Task fanning the messages out. */
+    SharedMemoryManager* _shared_memory_manager = nullptr;
+};
+
+#endif /* MESSAGE_BUS_H */
@@ -5,7 +5,10 @@
 #include "freertos/semphr.h"
 #include <freertos/task.h>
 
+#include <atomic>
+
 #include "Application/error/error_enum.h"
+#include "FieldPatch.h"
 #include "MemoryHandlers.h"
 #include "MemoryTypes.h"
 
@@ -13,30 +16,354 @@
 #include "pb_encode.h"
 
 #include "esp_log.h"
+#include "esp_timer.h"
+
+#ifndef TITANIUM_AREA_STATISTICS
+#define TITANIUM_AREA_STATISTICS 0 /**< Set to 1 with a build flag to collect the contention and latency counters of the areas. */
+#endif
+
+namespace AreaLock {
+    constexpr TickType_t WAIT_FOREVER  = portMAX_DELAY; /**< Blocks until the area mutex is available. */
+    constexpr TickType_t NO_WAIT       = 0;             /**< Fails at once if the area mutex is taken. */
+    constexpr UBaseType_t NO_CEILING   = 0;             /**< Holders keep their own priority. */
+}  // namespace AreaLock
+
+/**
+ * @brief Contention and latency counters of a memory area.
+ *
+ * Waits only account for the mutex acquisitions that found the mutex taken,
+ * codec times for the pb_encode and pb_decode calls that did not hit the
+ * decoded cache. Counters are 32 bits wide and wrap around.
+ */
+struct AreaCounters {
+    uint32_t reads;                              /**< Completed reads, views included. */
+    uint32_t writes;                             /**< Completed writes, leases and ring records included. */
+    uint32_t locks;                              /**< Mutex acquisitions. */
+    uint32_t contended;                          /**< Mutex acquisitions that had to wait for another task. */
+    uint32_t timeouts;                           /**< Mutex acquisitions that gave up before the mutex was released. */
+    uint32_t wait_min_us;                        /**< Shortest contended wait, 0 if none. */
+    uint32_t wait_max_us;                        /**< Longest contended wait. */
+    uint32_t wait_total_us;                      /**< Sum of the contended waits. */
+    uint32_t codecs;                             /**< Messages encoded or decoded. */
+    uint32_t codec_max_us;                       /**< Longest encode or decode. */
+    uint32_t codec_total_us;                     /**< Sum of the encode and decode times. */
+    uint32_t bytes_read;                         /**< Bytes read from the area. */
+    uint32_t bytes_written;                      /**< Bytes written to the area, whole slots for ring areas. */
+    char last_writer[configMAX_TASK_NAME_LEN];   /**< Name of the task that wrote the area last. */
+};
 
 /**
  * @brief Template for a memory area.
+ *
+ * Writers are always serialized by the area mutex. Every write is bracketed by
+ * a sequence counter that is odd while the write is in progress, which allows
+ * areas configured with ReadMode::OPTIMISTIC to be read without taking the
+ * mutex: the reader copies or decodes the data and retries if the counter
+ * changed meanwhile.
  */
 class SharedMemory {
    public:
+    /**
+     * @brief Callback invoked when a committed write lease is released.
+     */
+    typedef void (*commit_callback_t)(void* context, uint8_t area_index);
+
+    /**
+     * @brief Read-only view over the storage of a memory area.
+     *
+     * The view holds the area mutex until it is released or destroyed, so the
+     * data can be serialized straight from the area without an intermediate
+     * copy. Writers of the area block while a view is alive, keep it short.
+     */
+    class ReadView {
+       public:
+        ReadView() = default;
+        ReadView(const ReadView&)            = delete;
+        ReadView& operator=(const ReadView&) = delete;
+
+        ReadView(ReadView&& other) : _area(other._area) {
+            other._area = nullptr;
+        }
+
+        ReadView& operator=(ReadView&& other) {
+            if (this != &other) {
+                this->Release();
+                this->_area = other._area;
+                other._area = nullptr;
+            }
+            return *this;
+        }
+
+        ~ReadView() {
+            this->Release();
+        }
+
+        /**
+         * @brief Checks if the view holds the area.
+         *
+         * @return bool True if the area could be borrowed.
+         */
+        bool valid(void) const {
+            return this->_area != nullptr;
+        }
+
+        /**
+         * @brief Retrieves the area storage.
+         *
+         * @return const uint8_t* Pointer to the area data, nullptr if the view is not valid.
+         */
+        const uint8_t* data(void) const {
+            return this->valid() ? this->_area->_data : nullptr;
+        }
+
+        /**
+         * @brief Retrieves the amount of valid bytes in the area.
+         *
+         * @return uint16_t The written bytes, 0 if the view is not valid.
+         */
+        uint16_t size(void) const {
+            return this->valid() ? this->_area->_written_bytes : 0;
+        }
+
+        /**
+         * @brief Gives the area back before the view goes out of scope.
+         */
+        void Release(void) {
+            if (this->_area != nullptr) {
+                this->_area->Unlock();
+                this->_area = nullptr;
+            }
+        }
+
+       private:
+        friend class SharedMemory;
+
+        explicit ReadView(SharedMemory* area) : _area(area) {}
+
+        SharedMemory* _area = nullptr; /**< Borrowed area, nullptr once released. */
+    };
+
+    /**
+     * @brief Writable lease over the storage of a memory area.
+     *
+     * The lease holds the area mutex and keeps the sequence counter odd until
+     * it is released or destroyed, so optimistic readers retry instead of
+     * observing a partial write. Only a committed lease counts as a write:
+     * the generation moves forward and the commit callback runs. A lease
+     * released without Commit is aborted and nobody is notified. The
+     * generation is only left as it was if the storage was never handed out:
+     * once data() or Append was called the storage may be torn, so the
+     * generation still moves forward and the decoded cache is dropped, making
+     * overlapping optimistic readers retry.
+     */
+    class WriteLease {
+       public:
+        WriteLease() = default;
+        WriteLease(const WriteLease&)            = delete;
+        WriteLease& operator=(const WriteLease&) = delete;
+
+        WriteLease(WriteLease&& other)
+            : _area(other._area), _on_commit(other._on_commit), _context(other._context), _cursor(other._cursor),
+              _committed(other._committed), _touched(other._touched) {
+            other._area = nullptr;
+        }
+
+        WriteLease& operator=(WriteLease&& other) {
+            if (this != &other) {
+                this->Release();
+                this->_area      = other._area;
+                this->_on_commit = other._on_commit;
+                this->_context   = other._context;
+                this->_cursor    = other._cursor;
+                this->_committed = other._committed;
+                this->_touched   = other._touched;
+                other._area      = nullptr;
+            }
+            return *this;
+        }
+
+        ~WriteLease() {
+            this->Release();
+        }
+
+        /**
+         * @brief Checks if the lease holds the area.
+         *
+         * @return bool True if the area could be leased.
+         */
+        bool valid(void) const {
+            return this->_area != nullptr;
+        }
+
+        /**
+         * @brief Retrieves the area storage.
+         *
+         * From then on the lease counts as having modified the storage, see WriteLease.
+         *
+         * @return uint8_t* Pointer to the area data, nullptr if the lease is not valid.
+         */
+        uint8_t* data(void) {
+            if (!this->valid()) {
+                return nullptr;
+            }
+
+            this->_touched = true;
+            return this->_area->_data;
+        }
+
+        /**
+         * @brief Retrieves the amount of bytes that can be written in the area.
+         *
+         * @return uint16_t The area size, 0 if the lease is not valid.
+         */
+        uint16_t capacity(void) const {
+            return this->valid() ? this->_area->_size : 0;
+        }
+
+        /**
+         * @brief Retrieves the amount of valid bytes the area held when it was leased.
+         *
+         * Lets a producer update the current content in place, e.g. to apply a
+         * delta, instead of rewriting it.
+         *
+         * @return uint16_t The amount of written bytes, 0 if the lease is not valid.
+         */
+        uint16_t size(void) const {
+            return this->valid() ? this->_area->_written_bytes : 0;
+        }
+
+        /**
+         * @brief Copies a chunk right after the previously appended ones.
+         *
+         * Lets a producer stream a payload larger than its own buffers into the
+         * area, readers only see it once the lease is committed.
+         *
+         * @param[in] buffer Chunk to append.
+         * @param[in] length Size of the chunk in bytes.
+         * @return titan_err_t Error code indicating the result of the operation.
+         */
+        titan_err_t Append(const uint8_t* buffer, uint16_t length) {
+            if ((!this->valid()) || (buffer == nullptr)) {
+                return Error::NULL_PTR;
+            }
+
+            if (length > this->_area->_size - this->_cursor) {
+                return Error::BUFFER_OUT_OF_SPACE;
+            }
+
+            this->_touched = true;
+            memcpy(this->_area->_data + this->_cursor, buffer, length);
+            this->_cursor += length;
+
+            return Error::NO_ERROR;
+        }
+
+        /**
+         * @brief Publishes the chunks appended so far.
+         *
+         * @return titan_err_t Error code indicating the result of the operation.
+         */
+        titan_err_t Commit(void) {
+            return this->Commit(this->_cursor);
+        }
+
+        /**
+         * @brief Publishes the amount of valid bytes written through the lease.
+         *
+         * @param[in] written_bytes Amount of bytes written at the beginning of the area.
+         * @return titan_err_t Error code indicating the result of the operation.
+         */
+        titan_err_t Commit(uint16_t written_bytes) {
+            if (!this->valid()) {
+                return Error::NULL_PTR;
+            }
+
+            if (written_bytes > this->_area->_size) {
+                return Error::BUFFER_OUT_OF_SPACE;
+            }
+
+            this->_area->SetWrittenBytes(written_bytes);
+            this->_committed = true;
+
+            return Error::NO_ERROR;
+        }
+
+        /**
+         * @brief Gives the area back before the lease goes out of scope.
+         *
+         * A lease that was not committed is aborted, see WriteLease.
+         */
+        void Release(void) {
+            if (this->_area == nullptr) {
+                return;
+            }
+
+            auto area_index = this->_area->_index;
+
+            if (this->_committed) {
+                this->_area->EndWrite();
+            } else {
+                this->_area->AbortWrite(this->_touched);
+            }
+            this->_area->Unlock();
+            this->_area = nullptr;
+
+            if (this->_committed && (this->_on_commit != nullptr)) {
+                this->_on_commit(this->_context, area_index);
+            }
+        }
+
+       private:
+        friend class SharedMemory;
+
+        WriteLease(SharedMemory* area, commit_callback_t on_commit, void* context)
+            : _area(area), _on_commit(on_commit), _context(context) {}
+
+        SharedMemory* _area          = nullptr; /**< Leased area, nullptr once released. */
+        commit_callback_t _on_commit = nullptr; /**< Called after a committed lease is released. */
+        void* _context               = nullptr; /**< Context passed to the commit callback. */
+        uint16_t _cursor             = 0;       /**< Amount of bytes appended so far. */
+        bool _committed              = false;   /**< True once Commit succeeded. */
+        bool _touched                = false;   /**< True once the storage was handed out or appended to. */
+    };
+
     /**
      * @brief Constructs a new SharedMemory object.
      *
+     * The area does not allocate: the data buffer is provided by the caller,
+     * usually carved out of the SharedMemoryManager arena, and the mutex is
+     * created in storage owned by the object.
+     *
      * @param index Index of the memory area.
+     * @param data Buffer holding the data of the area, at least size bytes long.
      * @param size Size of the memory area.
      * @param access_type Access type of the memory area.
+     * @param read_mode Synchronization strategy used by the readers of the area.
      */
-    SharedMemory(uint8_t index, uint16_t size, AccessType access_type) {
+    SharedMemory(uint8_t index, uint8_t* data, uint16_t size, AccessType access_type, ReadMode read_mode = ReadMode::LOCKED) {
         this->_index         = index;
         this->_size          = size;
         this->_access_type   = access_type;
-        this->_has_update    = false;
-        this->_mutex         = xSemaphoreCreateMutex();
+        this->_read_mode     = read_mode;
+        this->_mutex         = xSemaphoreCreateMutexStatic(&this->_mutex_buffer);
         this->_written_bytes = 0;
-        this->_data          = new uint8_t[size];
+        this->_data          = data;
 
         this->Clear();
     }
+
+    SharedMemory(const SharedMemory&)            = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    /**
+     * @brief Releases the mutex of the memory area, the data buffer is owned by the caller.
+     */
+    ~SharedMemory() {
+        if (this->_mutex != nullptr) {
+            vSemaphoreDelete(this->_mutex);
+        }
+    }
+
     /**
      * @brief Clears the memory area by setting all its data to zero.
      *
@@ -72,6 +399,15 @@ class SharedMemory {
         return this->_access_type;
     }
 
+    /**
+     * @brief Retrieves the read mode of the memory area.
+     *
+     * @return ReadMode The synchronization strategy used by the readers.
+     */
+    ReadMode GetReadMode(void) {
+        return this->_read_mode;
+    }
+
     /**
      * @brief Retrieves the index of the memory area.
      *
@@ -82,107 +418,1050 @@ class SharedMemory {
     }
 
     /**
-     * @brief Retrieves if an area was read.
+     * @brief Retrieves the current value of the write sequence counter.
+     *
+     * The counter is incremented twice per write, so an odd value means that
+     * a write is in progress.
+     *
+     * @return uint32_t The current sequence counter.
+     */
+    uint32_t GetSequence(void) {
+        return this->_sequence.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Retrieves the generation of the memory area.
+     *
+     * The generation is the amount of completed writes, consumers compare it
+     * against the last generation they have seen to detect updates.
+     *
+     * @return uint32_t The amount of completed writes.
+     */
+    uint32_t GetGeneration(void) {
+        return this->GetSequence() >> 1;
+    }
+
+    /**
+     * @brief Computes the size of a ring slot, the header plus the payload rounded up to the header alignment.
+     *
+     * @param[in] record_size Maximum payload size of a record.
+     * @return uint32_t Size of a slot in bytes.
+     */
+    static constexpr uint32_t RingSlotSize(uint16_t record_size) {
+        return (sizeof(RingRecordHeader) + record_size + alignof(RingRecordHeader) - 1) & ~(alignof(RingRecordHeader) - 1);
+    }
+
+    /**
+     * @brief Computes the storage needed by a ring area.
      *
-     * @return bool True if the area has been read already, false otherwise.
+     * @param[in] record_size Maximum payload size of a record.
+     * @param[in] capacity Amount of records kept by the ring.
+     * @return uint32_t Size of the area in bytes.
      */
-    bool GetAreaHasUpdated(void) {
-        return this->_has_update;
+    static constexpr uint32_t RingStorageSize(uint16_t record_size, uint16_t capacity) {
+        return RingSlotSize(record_size) * capacity;
+    }
+
+    /**
+     * @brief Turns the area into a ring of timestamped records.
+     *
+     * Must be called before the area is used. The ring keeps as many records as
+     * fit in the area, once it is full every Append overwrites the oldest one.
+     *
+     * @param[in] record_size Maximum payload size of a record.
+     * @return titan_err_t Error code indicating the result of the operation.
+     */
+    titan_err_t ConfigureRing(uint16_t record_size) {
+        auto slot_size = RingSlotSize(record_size);
+
+        if ((slot_size > this->_size) || (this->GetSequence() != 0)) {
+            return Error::BUFFER_OUT_OF_SPACE;
+        }
+
+        this->_kind          = AreaKind::RING;
+        this->_slot_size     = slot_size;
+        this->_ring_capacity = this->_size / slot_size;
+
+        return Error::NO_ERROR;
+    }
+
+    /**
+     * @brief Appends a timestamped record to a ring area.
+     *
+     * @param[in] data Payload of the record.
+     * @param[in] length Size of the payload, no greater than the record size of the ring.
+     * @return titan_err_t Error code indicating the result of the operation.
+     */
+    titan_err_t Append(const uint8_t* data, uint16_t length) {
+        auto result = Error::UNKNOW_FAIL;
+
+        if ((this->_kind != AreaKind::RING) || (this->_access_type == READ_ONLY) || (data == nullptr)) {
+            return result;
+        }
+
+        if (sizeof(RingRecordHeader) + length > this->_slot_size) {
+            this->_rejected_records.fetch_add(1, std::memory_order_relaxed);
+            return Error::BUFFER_OUT_OF_SPACE;
+        }
+
+        if (this->_mutex != nullptr) {
+            if (this->Lock(AreaLock::WAIT_FOREVER)) {
+                this->BeginWrite();
+
+                auto slot   = this->_data + (this->_ring_head % this->_ring_capacity) * this->_slot_size;
+                auto header = reinterpret_cast<RingRecordHeader*>(slot);
+
+                if (this->_ring_head >= this->_ring_capacity) {
+                    this->_overwritten_records++;
+                }
+
+                header->sequence     = this->_ring_head;
+                header->length       = length;
+                header->reserved     = 0;
+                header->timestamp_us = esp_timer_get_time();
+                memcpy(slot + sizeof(RingRecordHeader), data, length);
+
+                this->_ring_head++;
+                auto stored          = this->_ring_head < this->_ring_capacity ? this->_ring_head : this->_ring_capacity;
+                this->_written_bytes = stored * this->_slot_size;
+
+                this->EndWrite();
+                result = Error::NO_ERROR;
+
+                this->Unlock();
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Copies the records appended since a cursor.
+     *
+     * Records are copied back to back, each one as a RingRecordHeader followed
+     * by its payload, until the buffer cannot hold the next one. The cursor is
+     * the sequence of the next record to read, start with 0 and keep passing the
+     * updated value. A reader that falls more than the ring capacity behind
+     * resumes from the oldest record kept.
+     *
+     * @param[in,out] cursor Sequence of the next record to read, advanced past the copied records.
+     * @param[out] buffer Buffer receiving the records.
+     * @param[in] buffer_size Size of the buffer in bytes.
+     * @param[out] missed Optional counter incremented by the records overwritten before being read.
+     * @return uint16_t Amount of bytes copied.
+     */
+    uint16_t ReadSince(uint32_t& cursor, uint8_t* buffer, uint16_t buffer_size, uint32_t* missed = nullptr) {
+        uint16_t copied = 0;
+
+        if ((this->_kind != AreaKind::RING) || (this->_access_type == WRITE_ONLY) || (buffer == nullptr)) {
+            return copied;
+        }
+
+        if (this->_mutex != nullptr) {
+            if (this->Lock(AreaLock::WAIT_FOREVER)) {
+                uint32_t lag = this->_ring_head - cursor;
+
+                if (lag > this->_ring_head) {
+                    /* The cursor is ahead of the ring, nothing was appended since. */
+                    cursor = this->_ring_head;
+                } else if (lag > this->_ring_capacity) {
+                    if (missed != nullptr) {
+                        *missed += lag - this->_ring_capacity;
+                    }
+                    cursor = this->_ring_head - this->_ring_capacity;
+                }
+
+                while (cursor != this->_ring_head) {
+                    auto slot   = this->_data + (cursor % this->_ring_capacity) * this->_slot_size;
+                    auto header = reinterpret_cast<RingRecordHeader*>(slot);
+                    auto length = sizeof(RingRecordHeader) + header->length;
+
+                    if (copied + length > buffer_size) {
+                        break;
+                    }
+
+                    memcpy(buffer + copied, slot, length);
+                    copied += length;
+                    cursor++;
+                }
+
+                this->CountRead(copied);
+                this->Unlock();
+            }
+        }
+
+        return copied;
+    }
+
+    /**
+     * @brief Retrieves the layout of the memory area.
+     *
+     * @return AreaKind The kind of the area.
+     */
+    AreaKind GetKind(void) {
+        return this->_kind;
+    }
+
+    /**
+     * @brief Retrieves the amount of records kept by a ring area.
+     *
+     * @return uint16_t The ring capacity, 0 if the area is not a ring.
+     */
+    uint16_t GetRingCapacity(void) {
+        return this->_ring_capacity;
+    }
+
+    /**
+     * @brief Retrieves the sequence the next appended record will get.
+     *
+     * @return uint32_t The amount of records appended so far.
+     */
+    uint32_t GetRingHead(void) {
+        return this->_ring_head;
+    }
+
+    /**
+     * @brief Retrieves the amount of records overwritten because the ring was full.
+     *
+     * @return uint32_t The overwritten records.
+     */
+    uint32_t GetOverwrittenRecords(void) {
+        return this->_overwritten_records;
+    }
+
+    /**
+     * @brief Retrieves the amount of records rejected because they did not fit in a slot.
+     *
+     * @return uint32_t The rejected records.
+     */
+    uint32_t GetRejectedRecords(void) {
+        return this->_rejected_records.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Attaches a buffer keeping the last decoded message of the area.
+     *
+     * Reads of an unchanged area then copy the cached struct instead of running
+     * pb_decode. The cache is only used by reads and writes with the same
+     * message descriptor and struct size, and is invalidated by the generation.
+     *
+     * @param[in] cache Buffer holding the decoded struct, at least cache_size bytes long.
+     * @param[in] cache_size Size of the decoded struct.
+     * @param[in] msg_desc Descriptor of the message stored in the area.
+     */
+    void AttachCache(uint8_t* cache, uint16_t cache_size, const pb_msgdesc_t* msg_desc) {
+        this->_cached_generation.store(NO_CACHED_GENERATION, std::memory_order_relaxed);
+        this->_cache_desc = msg_desc;
+        this->_cache_size = cache_size;
+        this->_cache      = cache;
+    }
+
+    /**
+     * @brief Retrieves the size of the decoded struct cache.
+     *
+     * @return uint16_t The size of the cache, 0 if the area has no cache.
+     */
+    uint16_t GetCacheSize(void) {
+        return this->_cache == nullptr ? 0 : this->_cache_size;
     }
 
     template <typename T>
-    titan_err_t Write(T& protobuf, const pb_msgdesc_t& msg_desc) {
-        if (this->_access_type == READ_ONLY) {
+    titan_err_t Write(T& protobuf, const pb_msgdesc_t& msg_desc, TickType_t timeout = AreaLock::WAIT_FOREVER) {
+        uint16_t written_bytes = 0;
+
+        if (!this->IsWritable()) {
             return Error::UNKNOW_FAIL;
         }
 
         if (this->_mutex != NULL) {
-            if (xSemaphoreTake(this->_mutex, portMAX_DELAY) == pdTRUE) {
-                memset_s(this->_data, 0, this->_size);
-                pb_ostream_t ostream = pb_ostream_from_buffer(this->_data, this->_size);
-                auto ret = pb_encode(&ostream, ((pb_msgdesc_t*)&msg_desc), &protobuf);
-                
-                this->_has_update    = true;
-                this->_written_bytes = ret ? ostream.bytes_written : 0;
+            if (!this->Lock(timeout)) {
+                return Error::LOCK_TIMEOUT;
+            }
+
+            this->BeginWrite();
+
+            auto start           = StatisticsClock();
+            pb_ostream_t ostream = pb_ostream_from_buffer(this->_data, this->_size);
+            auto ret = pb_encode(&ostream, ((pb_msgdesc_t*)&msg_desc), &protobuf);
+            this->CountCodec(start);
+
+            this->SetWrittenBytes(ret ? ostream.bytes_written : 0);
+
+            auto cached = ret && this->CacheMatches<T>(msg_desc);
+            if (cached) {
+                memcpy(this->_cache, &protobuf, sizeof(T));
+            }
 
-                xSemaphoreGive(this->_mutex);
+            this->EndWrite();
+
+            if (cached) {
+                this->_cached_generation.store(this->GetGeneration(), std::memory_order_release);
             }
+            written_bytes = this->_written_bytes;
+            this->Unlock();
         }
-        return this->_written_bytes > 0 ? Error::NO_ERROR : Error::WRITTEN_LESS_THAN_ZERO;
+        return written_bytes > 0 ? Error::NO_ERROR : Error::WRITTEN_LESS_THAN_ZERO;
     }
- 
-    titan_err_t Write(char* buffer, uint16_t written_bytes) {
 
-        if ((this->_access_type == READ_ONLY) || (buffer == nullptr)) {
+    titan_err_t Write(char* buffer, uint16_t written_bytes, TickType_t timeout = AreaLock::WAIT_FOREVER) {
+
+        if ((!this->IsWritable()) || (buffer == nullptr) || (this->_mutex == nullptr)) {
             return Error::UNKNOW_FAIL;
         }
 
-        if (this->_mutex != NULL) {
-            if (xSemaphoreTake(this->_mutex, portMAX_DELAY) == pdTRUE) {
-                memset_s(this->_data, 0, this->_size);
-                memcpy(this->_data, buffer, written_bytes);
+        if (!this->Lock(timeout)) {
+            return Error::LOCK_TIMEOUT;
+        }
 
-                this->_has_update    = true;
-                this->_written_bytes = written_bytes;
+        this->BeginWrite();
 
-                xSemaphoreGive(this->_mutex);
-            }
+        memcpy(this->_data, buffer, written_bytes);
+
+        this->SetWrittenBytes(written_bytes);
+
+        this->EndWrite();
+        this->Unlock();
+
+        return written_bytes > 0 ? Error::NO_ERROR : Error::UNKNOW_FAIL;
+    }
+
+    /**
+     * @brief Updates a single field of the message stored in the area.
+     *
+     * The stored message is taken from the decoded cache when it is up to
+     * date, decoded otherwise, patched and encoded back, all under the area
+     * mutex so concurrent patches of different fields are not lost.
+     *
+     * @param[in] path Path to the field, see FieldPath.
+     * @param[in] value Value to assign.
+     * @param[in] size Size of the value in bytes.
+     * @param[in] msg_desc Descriptor of the message stored in the area.
+     * @return titan_err_t Error code indicating the result of the operation, see PatchField.
+     */
+    template <typename T>
+    titan_err_t WriteField(FieldPath path, const void* value, size_t size, const pb_msgdesc_t& msg_desc,
+                           TickType_t timeout = AreaLock::WAIT_FOREVER) {
+        auto result = Error::UNKNOW_FAIL;
+
+        if ((!this->IsWritable()) || (this->_mutex == nullptr)) {
+            return result;
+        }
+
+        if (!this->Lock(timeout)) {
+            return Error::LOCK_TIMEOUT;
         }
-        return this->_written_bytes > 0 ? Error::NO_ERROR : Error::UNKNOW_FAIL;
+
+        do {
+            T protobuf{};
+            auto cached = this->CacheMatches<T>(msg_desc);
+
+            if (cached && (this->_cached_generation.load(std::memory_order_relaxed) == this->GetGeneration())) {
+                memcpy(&protobuf, this->_cache, sizeof(T));
+            } else if (this->_written_bytes > 0) {
+                auto start           = StatisticsClock();
+                pb_istream_t istream = pb_istream_from_buffer(this->_data, this->_written_bytes);
+                auto decoded         = pb_decode(&istream, &msg_desc, &protobuf);
+                this->CountCodec(start);
+
+                if (!decoded) {
+                    result = Error::DESERIALIZE_ERROR;
+                    break;
+                }
+            }
+
+            result = PatchField(&msg_desc, &protobuf, path, value, size);
+            if (result != ESP_OK) {
+                break;
+            }
+
+            /* The area is left untouched if the patched message does not fit. */
+            size_t encoded_size = 0;
+            if ((!pb_get_encoded_size(&encoded_size, &msg_desc, &protobuf)) || (encoded_size > this->_size)) {
+                result = Error::BUFFER_OUT_OF_SPACE;
+                break;
+            }
+
+            this->BeginWrite();
+
+            auto start           = StatisticsClock();
+            pb_ostream_t ostream = pb_ostream_from_buffer(this->_data, this->_size);
+            auto encoded         = pb_encode(&ostream, &msg_desc, &protobuf);
+            this->CountCodec(start);
+
+            this->SetWrittenBytes(encoded ? ostream.bytes_written : 0);
+
+            if (encoded && cached) {
+                memcpy(this->_cache, &protobuf, sizeof(T));
+            }
+
+            this->EndWrite();
+
+            if (encoded && cached) {
+                this->_cached_generation.store(this->GetGeneration(), std::memory_order_release);
+            }
+
+            result = encoded ? Error::NO_ERROR : Error::SERIALIZE_ERROR;
+
+        } while (0);
+
+        this->Unlock();
+
+        return result;
     }
 
     template <typename T>
-    titan_err_t Read(T& protobuf, const pb_msgdesc_t& msg_desc, bool silent) {
+    titan_err_t Read(T& protobuf, const pb_msgdesc_t& msg_desc, TickType_t timeout = AreaLock::WAIT_FOREVER) {
         auto result = Error::UNKNOW_FAIL;
 
         if (this->_access_type == WRITE_ONLY) {
             return result;
         }
 
+        if (this->_read_mode == ReadMode::OPTIMISTIC) {
+            for (uint8_t attempt = 0; attempt < MAXIMUM_OPTIMISTIC_ATTEMPTS; attempt++) {
+                uint32_t sequence = 0;
+                if (!this->BeginOptimisticRead(sequence)) {
+                    continue;
+                }
+
+                if (this->CacheMatches<T>(msg_desc)) {
+                    /* A stale cache is refreshed under the mutex, so the next readers hit it. */
+                    if (this->_cached_generation.load(std::memory_order_acquire) != (sequence >> 1)) {
+                        break;
+                    }
+
+                    memcpy(&protobuf, this->_cache, sizeof(T));
+
+                    if (this->ValidateOptimisticRead(sequence)) {
+                        this->CountRead(this->GetBoundedWrittenBytes());
+                        return Error::NO_ERROR;
+                    }
+                    continue;
+                }
+
+                auto start           = StatisticsClock();
+                auto written_bytes   = this->GetBoundedWrittenBytes();
+                pb_istream_t istream = pb_istream_from_buffer(this->_data, written_bytes);
+                auto decoded         = pb_decode(&istream, ((pb_msgdesc_t*)&msg_desc), &protobuf);
+
+                if (this->ValidateOptimisticRead(sequence)) {
+                    this->CountCodec(start);
+                    this->CountRead(written_bytes);
+                    return decoded ? Error::NO_ERROR : Error::DESERIALIZE_ERROR;
+                }
+            }
+        }
+
         if (this->_mutex != NULL) {
-            if (xSemaphoreTake(this->_mutex, portMAX_DELAY) == pdTRUE) {
+            if (!this->Lock(timeout)) {
+                return Error::LOCK_TIMEOUT;
+            }
+
+            auto cache_valid = this->CacheMatches<T>(msg_desc) &&
+                               (this->_cached_generation.load(std::memory_order_relaxed) == this->GetGeneration());
+
+            if (cache_valid) {
+                memcpy(&protobuf, this->_cache, sizeof(T));
+                result = Error::NO_ERROR;
+            } else {
+                auto start           = StatisticsClock();
                 pb_istream_t istream = pb_istream_from_buffer(this->_data, this->_written_bytes);
-                result               = pb_decode(&istream, ((pb_msgdesc_t*)&msg_desc), &protobuf);
+                auto decoded         = pb_decode(&istream, ((pb_msgdesc_t*)&msg_desc), &protobuf);
+                this->CountCodec(start);
 
-                if (!silent) {
-                    this->_has_update = false;
+                result = decoded ? Error::NO_ERROR : Error::DESERIALIZE_ERROR;
+                if (decoded && this->CacheMatches<T>(msg_desc)) {
+                    memcpy(this->_cache, &protobuf, sizeof(T));
+                    this->_cached_generation.store(this->GetGeneration(), std::memory_order_release);
                 }
-                xSemaphoreGive(this->_mutex);
             }
+
+            this->Unlock();
         }
 
-        return result ? Error::NO_ERROR : Error::DESERIALIZE_ERROR;
+        return result;
     }
 
-    titan_err_t Read(char* buffer, bool silent) {
+    titan_err_t Read(char* buffer, TickType_t timeout = AreaLock::WAIT_FOREVER) {
         auto result = Error::UNKNOW_FAIL;
 
         if ((this->_access_type == WRITE_ONLY) || (buffer == nullptr)) {
             return result;
         }
 
+        if (this->_read_mode == ReadMode::OPTIMISTIC) {
+            for (uint8_t attempt = 0; attempt < MAXIMUM_OPTIMISTIC_ATTEMPTS; attempt++) {
+                uint32_t sequence = 0;
+                if (!this->BeginOptimisticRead(sequence)) {
+                    continue;
+                }
+
+                auto written_bytes = this->GetBoundedWrittenBytes();
+                auto copied        = memcpy_s(buffer, this->_data, written_bytes);
+
+                if (this->ValidateOptimisticRead(sequence)) {
+                    this->CountRead(written_bytes);
+                    return copied;
+                }
+            }
+        }
+
+        if (this->_mutex != nullptr) {
+            if (!this->Lock(timeout)) {
+                return Error::LOCK_TIMEOUT;
+            }
+
+            result = memcpy_s(buffer, this->_data, this->_written_bytes);
+            this->CountRead(this->_written_bytes);
+
+            this->Unlock();
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Writes a chunk of the area content at the given offset.
+     *
+     * The content ends right after the chunk, so a payload is streamed by
+     * writing consecutive chunks starting at offset 0. Each chunk is a
+     * complete write for the readers.
+     *
+     * @param[in] offset Position of the chunk, no greater than the written bytes.
+     * @param[in] buffer Chunk to write.
+     * @param[in] length Size of the chunk in bytes.
+     * @return titan_err_t Error code indicating the result of the operation.
+     *         - ESP_ERR_INVALID_ARG if the chunk would leave a gap after the content.
+     *         - Error::BUFFER_OUT_OF_SPACE if the chunk ends past the area.
+     */
+    titan_err_t WriteChunk(uint16_t offset, const uint8_t* buffer, uint16_t length) {
+        auto result = Error::UNKNOW_FAIL;
+
+        if ((!this->IsWritable()) || (buffer == nullptr)) {
+            return result;
+        }
+
+        if ((uint32_t)offset + length > this->_size) {
+            return Error::BUFFER_OUT_OF_SPACE;
+        }
+
         if (this->_mutex != nullptr) {
-            if (xSemaphoreTake(this->_mutex, portMAX_DELAY) == pdTRUE) {
-                result = memcpy_s(buffer, this->_data, this->_written_bytes);
+            if (this->Lock(AreaLock::WAIT_FOREVER)) {
+                if (offset <= this->_written_bytes) {
+                    this->BeginWrite();
+
+                    memcpy(this->_data + offset, buffer, length);
+                    this->SetWrittenBytes(offset + length);
 
-                if (!silent) {
-                    this->_has_update = false;
+                    this->EndWrite();
+                    result = Error::NO_ERROR;
+                } else {
+                    result = ESP_ERR_INVALID_ARG;
                 }
-                xSemaphoreGive(this->_mutex);
+
+                this->Unlock();
             }
         }
 
         return result;
     }
 
+    /**
+     * @brief Copies a chunk of the area content starting at the given offset.
+     *
+     * @param[in] offset Position of the first byte to copy.
+     * @param[out] buffer Buffer receiving the chunk.
+     * @param[in] length Size of the buffer in bytes.
+     * @return uint16_t Amount of bytes copied, 0 once the offset reaches the written bytes.
+     */
+    uint16_t ReadChunk(uint16_t offset, uint8_t* buffer, uint16_t length) {
+        uint16_t copied = 0;
+
+        if ((this->_access_type == WRITE_ONLY) || (buffer == nullptr)) {
+            return copied;
+        }
+
+        if (this->_read_mode == ReadMode::OPTIMISTIC) {
+            for (uint8_t attempt = 0; attempt < MAXIMUM_OPTIMISTIC_ATTEMPTS; attempt++) {
+                uint32_t sequence = 0;
+                if (!this->BeginOptimisticRead(sequence)) {
+                    continue;
+                }
+
+                copied = this->CopyChunk(offset, buffer, length, this->GetBoundedWrittenBytes());
+
+                if (this->ValidateOptimisticRead(sequence)) {
+                    this->CountRead(copied);
+                    return copied;
+                }
+            }
+        }
+
+        if (this->_mutex != nullptr) {
+            if (this->Lock(AreaLock::WAIT_FOREVER)) {
+                copied = this->CopyChunk(offset, buffer, length, this->_written_bytes);
+                this->CountRead(copied);
+
+                this->Unlock();
+            }
+        }
+
+        return copied;
+    }
+
+    /**
+     * @brief Borrows the area storage for reading without copying it.
+     *
+     * @return ReadView View holding the area mutex, not valid if the area is write only.
+     */
+    ReadView Borrow(TickType_t timeout = AreaLock::WAIT_FOREVER) {
+        if ((this->_access_type == WRITE_ONLY) || (this->_mutex == nullptr)) {
+            return ReadView();
+        }
+
+        if (!this->Lock(timeout)) {
+            return ReadView();
+        }
+
+        this->CountRead(this->_written_bytes);
+        return ReadView(this);
+    }
+
+    /**
+     * @brief Leases the area storage for writing in place.
+     *
+     * @param[in] on_commit Optional callback invoked after a committed lease is released.
+     * @param[in] context Context passed to the callback.
+     * @return WriteLease Lease holding the area mutex, not valid if the area is read only.
+     */
+    WriteLease Lease(commit_callback_t on_commit = nullptr, void* context = nullptr,
+                     TickType_t timeout = AreaLock::WAIT_FOREVER) {
+        if ((!this->IsWritable()) || (this->_mutex == nullptr)) {
+            return WriteLease();
+        }
+
+        if (!this->Lock(timeout)) {
+            return WriteLease();
+        }
+
+        this->BeginWrite();
+
+        return WriteLease(this, on_commit, context);
+    }
+
+    /**
+     * @brief Copies the contention and latency counters of the area.
+     *
+     * The counters are sampled without the mutex, they may be slightly
+     * inconsistent with each other while the area is in use.
+     *
+     * @param[out] counters The counters of the area.
+     * @return titan_err_t ESP_ERR_NOT_SUPPORTED if the firmware is built without TITANIUM_AREA_STATISTICS.
+     */
+    titan_err_t GetCounters(AreaCounters& counters) {
+#if TITANIUM_AREA_STATISTICS
+        uint32_t wait_min_us = this->_counters.wait_min_us.load(std::memory_order_relaxed);
+
+        counters.reads          = this->_counters.reads.load(std::memory_order_relaxed);
+        counters.writes         = this->_counters.writes.load(std::memory_order_relaxed);
+        counters.locks          = this->_counters.locks.load(std::memory_order_relaxed);
+        counters.contended      = this->_counters.contended.load(std::memory_order_relaxed);
+        counters.timeouts       = this->_counters.timeouts.load(std::memory_order_relaxed);
+        counters.wait_min_us    = wait_min_us == UINT32_MAX ? 0 : wait_min_us;
+        counters.wait_max_us    = this->_counters.wait_max_us.load(std::memory_order_relaxed);
+        counters.wait_total_us  = this->_counters.wait_total_us.load(std::memory_order_relaxed);
+        counters.codecs         = this->_counters.codecs.load(std::memory_order_relaxed);
+        counters.codec_max_us   = this->_counters.codec_max_us.load(std::memory_order_relaxed);
+        counters.codec_total_us = this->_counters.codec_total_us.load(std::memory_order_relaxed);
+        counters.bytes_read     = this->_counters.bytes_read.load(std::memory_order_relaxed);
+        counters.bytes_written  = this->_counters.bytes_written.load(std::memory_order_relaxed);
+
+        memcpy(counters.last_writer, this->_counters.last_writer, sizeof(counters.last_writer));
+        counters.last_writer[sizeof(counters.last_writer) - 1] = '\0';
+
+        return ESP_OK;
+#else
+        memset(&counters, 0, sizeof(counters));
+        return ESP_ERR_NOT_SUPPORTED;
+#endif
+    }
+
+    /**
+     * @brief Sets the priority the area mutex holder runs at.
+     *
+     * FreeRTOS mutexes already lend the priority of a blocked waiter to the
+     * holder, but only once the waiter blocks. With a ceiling the holder is
+     * raised as soon as it takes the mutex, so middle priority tasks cannot
+     * preempt a write: optimistic readers do not fall back to the mutex and
+     * high priority waiters only wait for the critical section itself. Set it
+     * to the priority of the highest task using the area. A task holding
+     * several areas runs at the highest ceiling it reached until it gives
+     * the last one back, in any order.
+     *
+     * @param[in] ceiling Priority of the holder, AreaLock::NO_CEILING to disable it.
+     */
+    void SetPriorityCeiling(UBaseType_t ceiling) {
+        this->_priority_ceiling = ceiling;
+    }
+
+   private:
+    /**
+     * @brief Amount of optimistic attempts before a reader falls back to the mutex.
+     *
+     * Falling back guarantees progress when a lower priority writer is
+     * preempted in the middle of a write, since the mutex applies priority
+     * inheritance to the writer.
+     */
+    static constexpr uint8_t MAXIMUM_OPTIMISTIC_ATTEMPTS = 4;
+
+    /**
+     * @brief Cached generation meaning that the cache holds no decoded struct.
+     */
+    static constexpr uint32_t NO_CACHED_GENERATION = UINT32_MAX;
+
+    /**
+     * @brief Checks if the decoded struct cache can hold a message of type T.
+     *
+     * @param[in] msg_desc Descriptor of the message being read or written.
+     * @return bool True if the area has a cache for this message.
+     */
+    template <typename T>
+    bool CacheMatches(const pb_msgdesc_t& msg_desc) {
+        return (this->_cache != nullptr) && (this->_cache_desc == &msg_desc) && (this->_cache_size == sizeof(T));
+    }
+
+    /**
+     * @brief Takes the area mutex, measuring the wait when it is contended.
+     *
+     * The mutex is first tried without blocking, so an uncontended lock never
+     * enters the scheduler. On success the holder is raised to the priority
+     * ceiling of the area, see SetPriorityCeiling().
+     *
+     * @param[in] timeout Maximum amount of ticks to wait for the mutex.
+     * @return bool True if the mutex was taken.
+     */
+    bool Lock(TickType_t timeout) {
+#if TITANIUM_AREA_STATISTICS
+        this->_counters.locks.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+        if (xSemaphoreTake(this->_mutex, 0) == pdTRUE) {
+            this->RaisePriority();
+            return true;
+        }
+
+#if TITANIUM_AREA_STATISTICS
+        auto start = esp_timer_get_time();
+#endif
+        if ((timeout == AreaLock::NO_WAIT) || (xSemaphoreTake(this->_mutex, timeout) != pdTRUE)) {
+#if TITANIUM_AREA_STATISTICS
+            this->_counters.timeouts.fetch_add(1, std::memory_order_relaxed);
+#endif
+            return false;
+        }
+
+#if TITANIUM_AREA_STATISTICS
+        /* The wait counters are only updated with the mutex held. */
+        uint32_t wait_us = esp_timer_get_time() - start;
+        this->_counters.contended.fetch_add(1, std::memory_order_relaxed);
+        this->_counters.wait_total_us.fetch_add(wait_us, std::memory_order_relaxed);
+        if (wait_us < this->_counters.wait_min_us.load(std::memory_order_relaxed)) {
+            this->_counters.wait_min_us.store(wait_us, std::memory_order_relaxed);
+        }
+        if (wait_us > this->_counters.wait_max_us.load(std::memory_order_relaxed)) {
+            this->_counters.wait_max_us.store(wait_us, std::memory_order_relaxed);
+        }
+#endif
+
+        this->RaisePriority();
+        return true;
+    }
+
+    /**
+     * @brief Gives the area mutex back, restoring the priority of the holder with its last ceiling area.
+     */
+    void Unlock(void) {
+        if (this->_ceiling_held) {
+            this->_ceiling_held = false;
+
+            auto& task_ceiling = SharedMemory::_task_ceiling;
+            if ((--task_ceiling.depth == 0) && (task_ceiling.priority != task_ceiling.base_priority)) {
+                vTaskPrioritySet(nullptr, task_ceiling.base_priority);
+            }
+        }
+        xSemaphoreGive(this->_mutex);
+    }
+
+    /**
+     * @brief Raises the task that just took the mutex to the priority ceiling of the area.
+     *
+     * The priority is sampled once, by the first ceiling area the task takes,
+     * and only restored when it gives the last one back, so areas released out
+     * of order never drop the task below a ceiling it still holds. Kernels
+     * before 10.6.0 have no uxTaskBasePriorityGet, there the sample includes a
+     * priority lent by a waiter of another mutex the task holds.
+     */
+    void RaisePriority(void) {
+        auto ceiling = this->_priority_ceiling;
+
+        if (ceiling == AreaLock::NO_CEILING) {
+            return;
+        }
+
+        auto& task_ceiling = SharedMemory::_task_ceiling;
+        if (task_ceiling.depth++ == 0) {
+#if (tskKERNEL_VERSION_MAJOR > 10) || ((tskKERNEL_VERSION_MAJOR == 10) && (tskKERNEL_VERSION_MINOR >= 6))
+            task_ceiling.base_priority = uxTaskBasePriorityGet(nullptr);
+#else
+            task_ceiling.base_priority = uxTaskPriorityGet(nullptr);
+#endif
+            task_ceiling.priority = task_ceiling.base_priority;
+        }
+        this->_ceiling_held = true;
+
+        if (task_ceiling.priority < ceiling) {
+            task_ceiling.priority = ceiling;
+            vTaskPrioritySet(nullptr, ceiling);
+        }
+    }
+
+    /**
+     * @brief Samples the clock used by the codec counters.
+     *
+     * @return int64_t Current time in microseconds, 0 when the counters are disabled.
+     */
+    static int64_t StatisticsClock(void) {
+#if TITANIUM_AREA_STATISTICS
+        return esp_timer_get_time();
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Accounts for an encode or a decode of the area message.
+     *
+     * @param[in] start Time returned by StatisticsClock before the encode or decode.
+     */
+    void CountCodec(int64_t start) {
+#if TITANIUM_AREA_STATISTICS
+        uint32_t codec_us = esp_timer_get_time() - start;
+        this->_counters.codecs.fetch_add(1, std::memory_order_relaxed);
+        this->_counters.codec_total_us.fetch_add(codec_us, std::memory_order_relaxed);
+
+        /* Optimistic readers decode concurrently, the maximum needs a compare and swap. */
+        uint32_t codec_max_us = this->_counters.codec_max_us.load(std::memory_order_relaxed);
+        while ((codec_us > codec_max_us) &&
+               (!this->_counters.codec_max_us.compare_exchange_weak(codec_max_us, codec_us, std::memory_order_relaxed))) {
+        }
+#else
+        (void)start;
+#endif
+    }
+
+    /**
+     * @brief Accounts for a completed read.
+     *
+     * @param[in] bytes Amount of bytes read.
+     */
+    void CountRead(uint32_t bytes) {
+#if TITANIUM_AREA_STATISTICS
+        this->_counters.reads.fetch_add(1, std::memory_order_relaxed);
+        this->_counters.bytes_read.fetch_add(bytes, std::memory_order_relaxed);
+#else
+        (void)bytes;
+#endif
+    }
+
+    /**
+     * @brief Accounts for a completed write, must be called with the mutex held.
+     */
+    void CountWrite(void) {
+#if TITANIUM_AREA_STATISTICS
+        uint32_t bytes = this->_kind == AreaKind::RING ? this->_slot_size : this->_written_bytes;
+
+        this->_counters.writes.fetch_add(1, std::memory_order_relaxed);
+        this->_counters.bytes_written.fetch_add(bytes, std::memory_order_relaxed);
+        strncpy(this->_counters.last_writer, pcTaskGetName(nullptr), sizeof(this->_counters.last_writer));
+#endif
+    }
+
+    /**
+     * @brief Marks the beginning of a write, must be called with the mutex held.
+     */
+    void BeginWrite(void) {
+        this->_sequence.store(this->_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /**
+     * @brief Marks the end of a write, must be called with the mutex held.
+     */
+    void EndWrite(void) {
+        this->_sequence.store(this->_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        this->CountWrite();
+    }
+
+    /**
+     * @brief Cancels a write, must be called with the mutex held. The write is not counted.
+     *
+     * Rolling the sequence counter back to its value before BeginWrite is only
+     * safe if no byte was written: an optimistic reader that sampled that value
+     * before the write would otherwise accept the torn bytes. A write that may
+     * have touched the storage ends like EndWrite, the generation moves forward
+     * and the decoded cache no longer matches the content.
+     *
+     * @param[in] touched True if the storage may have been modified.
+     */
+    void AbortWrite(bool touched) {
+        if (!touched) {
+            this->_sequence.store(this->_sequence.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+            return;
+        }
+
+        this->_cached_generation.store(NO_CACHED_GENERATION, std::memory_order_relaxed);
+        this->_sequence.store(this->_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Starts an optimistic read by sampling the sequence counter.
+     *
+     * @param[out] sequence The sampled sequence counter.
+     * @return bool False if a write is in progress and the read must be retried.
+     */
+    bool BeginOptimisticRead(uint32_t& sequence) {
+        sequence = this->_sequence.load(std::memory_order_acquire);
+        return (sequence & 1) == 0;
+    }
+
+    /**
+     * @brief Checks that no write happened since BeginOptimisticRead.
+     *
+     * @param[in] sequence The sequence counter sampled when the read started.
+     * @return bool True if the data copied in between is consistent.
+     */
+    bool ValidateOptimisticRead(uint32_t sequence) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return this->_sequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+    /**
+     * @brief Sets the length of the content and zeroes what is left of the previous one.
+     *
+     * Only the stale tail is cleared instead of the whole area, so a write
+     * costs the size of the message rather than the size of the area. Must be
+     * called with the mutex held.
+     *
+     * @param[in] written_bytes Length of the new content.
+     */
+    void SetWrittenBytes(uint16_t written_bytes) {
+        if (written_bytes < this->_written_bytes) {
+            memset(this->_data + written_bytes, 0, this->_written_bytes - written_bytes);
+        }
+        this->_written_bytes = written_bytes;
+    }
+
+    /**
+     * @brief Checks if the content of the area can be replaced by a write.
+     *
+     * Ring areas only accept Append, a plain write would corrupt the records.
+     *
+     * @return bool True if the area is writable and holds the latest value.
+     */
+    bool IsWritable(void) {
+        return (this->_access_type != READ_ONLY) && (this->_kind == AreaKind::LATEST);
+    }
+
+    /**
+     * @brief Retrieves the written bytes clamped to the area size.
+     *
+     * Optimistic readers may observe a torn value, clamping keeps the copy
+     * inside the buffer until the read is discarded by the validation step.
+     *
+     * @return uint16_t The written bytes, never greater than the area size.
+     */
+    uint16_t GetBoundedWrittenBytes(void) {
+        uint16_t written_bytes = this->_written_bytes;
+        return written_bytes > this->_size ? this->_size : written_bytes;
+    }
+
+    /**
+     * @brief Copies the part of the content that overlaps the requested chunk.
+     *
+     * @param[in] offset Position of the first byte to copy.
+     * @param[out] buffer Buffer receiving the chunk.
+     * @param[in] length Size of the buffer in bytes.
+     * @param[in] written_bytes Valid bytes of the area.
+     * @return uint16_t Amount of bytes copied.
+     */
+    uint16_t CopyChunk(uint16_t offset, uint8_t* buffer, uint16_t length, uint16_t written_bytes) {
+        if (offset >= written_bytes) {
+            return 0;
+        }
+
+        uint16_t available = written_bytes - offset;
+        uint16_t copied    = available < length ? available : length;
+        memcpy(buffer, this->_data + offset, copied);
+
+        return copied;
+    }
+
    protected:
-    uint8_t _index;                     /**< Index of the memory area. */
-    AccessType _access_type;            /**< Access type of the memory area. */
-    uint8_t* _data;                     /**< Pointer to the data buffer. */
-    uint8_t _has_update;                /**< Flag indicating if the area has been updated. */
-    uint8_t _written_bytes;             /**< Number of valid bytes written in that area. */
-    uint16_t _size;                     /**< Size of the memory area. */
-    SemaphoreHandle_t _mutex = nullptr; /**< Mutex semaphore for thread safety. */
+    uint8_t _index;                      /**< Index of the memory area. */
+    AccessType _access_type;             /**< Access type of the memory area. */
+    ReadMode _read_mode;                 /**< Synchronization strategy used by the readers. */
+    uint8_t* _data;                      /**< Pointer to the data buffer. */
+    uint16_t _written_bytes;             /**< Number of valid bytes written in that area. */
+    uint16_t _size;                      /**< Size of the memory area. */
+    SemaphoreHandle_t _mutex = nullptr;  /**< Mutex semaphore for thread safety. */
+    StaticSemaphore_t _mutex_buffer;     /**< Storage of the mutex, avoids a heap allocation per area. */
+    std::atomic<uint32_t> _sequence{0};  /**< Write sequence counter, odd while a write is in progress. */
+    uint8_t* _cache                 = nullptr; /**< Last decoded struct, nullptr if the area has no cache. */
+    uint16_t _cache_size            = 0;       /**< Size of the decoded struct. */
+    const pb_msgdesc_t* _cache_desc = nullptr; /**< Descriptor of the cached message. */
+    std::atomic<uint32_t> _cached_generation{NO_CACHED_GENERATION}; /**< Generation held by the cache. */
+    AreaKind _kind                  = AreaKind::LATEST; /**< Layout of the area. */
+    uint16_t _slot_size             = 0;       /**< Size of a ring slot, header included. */
+    uint16_t _ring_capacity         = 0;       /**< Amount of records kept by the ring. */
+    uint32_t _ring_head             = 0;       /**< Sequence of the next appended record. */
+    uint32_t _overwritten_records   = 0;       /**< Records overwritten because the ring was full. */
+    std::atomic<uint32_t> _rejected_records{0}; /**< Records rejected because they did not fit in a slot, counted without the mutex. */
+    UBaseType_t _priority_ceiling   = AreaLock::NO_CEILING; /**< Priority given to the mutex holder. */
+    bool _ceiling_held              = false;   /**< True if the holder counted this area in its ceiling depth. */
+
+    /**
+     * @brief Ceiling areas held by the calling task, shared by every area.
+     */
+    struct TaskCeiling {
+        UBaseType_t base_priority; /**< Priority of the task before its first ceiling area. */
+        UBaseType_t priority;      /**< Highest ceiling the task was raised to, base_priority if none. */
+        uint8_t depth;             /**< Ceiling areas the task holds. */
+    };
+    static inline thread_local TaskCeiling _task_ceiling = {};
+
+#if TITANIUM_AREA_STATISTICS
+    /**
+     * @brief Live counters of the area, see AreaCounters.
+     *
+     * Optimistic readers update them without the mutex, so they are atomics.
+     */
+    struct {
+        std::atomic<uint32_t> reads{0};
+        std::atomic<uint32_t> writes{0};
+        std::atomic<uint32_t> locks{0};
+        std::atomic<uint32_t> contended{0};
+        std::atomic<uint32_t> timeouts{0};
+        std::atomic<uint32_t> wait_min_us{UINT32_MAX};
+        std::atomic<uint32_t> wait_max_us{0};
+        std::atomic<uint32_t> wait_total_us{0};
+        std::atomic<uint32_t> codecs{0};
+        std::atomic<uint32_t> codec_max_us{0};
+        std::atomic<uint32_t> codec_total_us{0};
+        std::atomic<uint32_t> bytes_read{0};
+        std::atomic<uint32_t> bytes_written{0};
+        char last_writer[configMAX_TASK_NAME_LEN] = {};
+    } _counters;
+#endif
 };
 
 #endif /* SHARED_MEMORY_H */
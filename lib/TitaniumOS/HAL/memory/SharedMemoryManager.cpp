@@ -1,28 +1,145 @@
 #include "SharedMemoryManager.h"
 
+#include <new>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+
+static const char* TAG = "SharedMemoryManager";
+
+static_assert(configTASK_NOTIFICATION_ARRAY_ENTRIES > MemoryConsumer::NOTIFICATION_INDEX,
+              "CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES must leave a slot for the area updates");
+
+alignas(SharedMemory) uint8_t SharedMemoryManager::_area_storage[SharedMemoryManager::_maximum_shared_memory][sizeof(SharedMemory)];
+alignas(MemoryArena::ALIGNMENT) uint8_t SharedMemoryManager::_arena[MemoryArena::SIZE];
+uint8_t SharedMemoryManager::_persistence_buffer[Persistence::MAXIMUM_AREA_SIZE];
+area_diagnostics_t SharedMemoryManager::_diagnostics;
+RTC_NOINIT_ATTR SharedMemoryManager::RetainedMemory SharedMemoryManager::_retained;
+
+/**
+ * @brief Builds the NVS key of a persistent area.
+ *
+ * @param[in] area_index Index of the area.
+ * @param[out] key Buffer receiving the key, NVS keys are limited to 15 characters.
+ */
+static void PersistenceKey(uint8_t area_index, char (&key)[NVS_KEY_NAME_MAX_SIZE]) {
+    snprintf(key, sizeof(key), "area_%u", area_index);
+}
+
+/**
+ * @brief Sorts a set of areas in the global locking order, dropping duplicates.
+ *
+ * @param[in] areas Areas requested by the caller.
+ * @param[out] sorted Areas in ascending index order.
+ * @return uint8_t Amount of distinct areas, 0 if there are more than AreaSet::MAXIMUM_AREAS.
+ */
+static uint8_t SortAreas(std::initializer_list<uint8_t> areas, uint8_t* sorted) {
+    uint8_t count = 0;
+
+    for (auto area : areas) {
+        uint8_t position = 0;
+        while ((position < count) && (sorted[position] < area)) {
+            position++;
+        }
+
+        if ((position < count) && (sorted[position] == area)) {
+            continue;
+        }
+
+        if (count == AreaSet::MAXIMUM_AREAS) {
+            return 0;
+        }
+
+        for (uint8_t i = count; i > position; i--) {
+            sorted[i] = sorted[i - 1];
+        }
+        sorted[position] = area;
+        count++;
+    }
+
+    return count;
+}
+
 /**
  * @brief Initializes the MemoryManager.
  *
+ * Destroys any area signed up before and gives the whole arena and the PSRAM blocks back.
+ *
  * @return titan_err_t ESP_OK if initialization is successful, otherwise an error code.
  */
 titan_err_t SharedMemoryManager::Initialize(void) {
     for (uint16_t i = 0; i < this->_maximum_shared_memory; i++) {
+        if (this->_shared_memory_array[i] != nullptr) {
+            this->_shared_memory_array[i]->~SharedMemory();
+        }
+        if (this->_external_data[i] != nullptr) {
+            heap_caps_free(this->_external_data[i]);
+        }
         this->_shared_memory_array[i] = nullptr;
+        this->_external_data[i]       = nullptr;
+        this->_area_offset[i]         = 0;
+    }
+
+    if (this->_persistence_mutex == nullptr) {
+        this->_persistence_mutex = xSemaphoreCreateMutexStatic(&this->_persistence_mutex_buffer);
+    }
+
+    if (this->_flush_mutex == nullptr) {
+        this->_flush_mutex = xSemaphoreCreateMutexStatic(&this->_flush_mutex_buffer);
     }
 
+    if (this->_flush_timer == nullptr) {
+        this->_flush_timer = xTimerCreateStatic("area_flush", pdMS_TO_TICKS(Persistence::FLUSH_DELAY_MS), pdFALSE,
+                                                this, SharedMemoryManager::OnFlushTimer, &this->_flush_timer_buffer);
+    } else {
+        xTimerStop(this->_flush_timer, 0);
+    }
+
+    if (this->_diagnostics_timer != nullptr) {
+        xTimerStop(this->_diagnostics_timer, 0);
+    }
+
+    this->_persistent_areas.store(0);
+    this->_dirty_areas.store(0);
+    this->_pending_restore.store(0);
+    this->_retained_areas.store(0);
+    this->_restored_areas.store(0);
+
+    this->ValidateRetainedMemory();
+
+    this->_num_areas     = 0;
+    this->_arena_used    = 0;
+    this->_external_used = 0;
+    this->_has_psram     = heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0;
+
     return ESP_OK;
 }
 
 /**
  * @brief Registers a shared memory area.
  *
+ * The area data is carved out of the static arena, starting on a cache line
+ * boundary, and the area object is constructed in its static slot, so signing
+ * up an internal area never touches the heap. External areas are allocated in
+ * PSRAM instead when the build enables it, the arena is sized without them so
+ * signing up fails if PSRAM is missing or full. Builds without PSRAM support
+ * keep them in the arena. Optimistic areas always stay internal: their readers
+ * spin on the data without the mutex and PSRAM would widen the window in which
+ * they retry.
+ *
  * @param index Index of the shared memory area.
  * @param size_in_bytes Size of the shared memory area in bytes.
  * @param access_type Access type of the shared memory area.
+ * @param read_mode Synchronization strategy used by the readers of the area.
+ * @param placement Memory holding the area data.
  * @return titan_err_t Error code indicating the result of the operation.
  */
 titan_err_t SharedMemoryManager::SignUpSharedArea(uint8_t index, uint16_t size_in_bytes,
-                                                AccessType access_type) {
+                                                AccessType access_type, ReadMode read_mode, AreaPlacement placement) {
     titan_err_t result = Error::UNKNOW_FAIL;
 
     do {
@@ -36,8 +153,25 @@ titan_err_t SharedMemoryManager::SignUpSharedArea(uint8_t index, uint16_t size_i
             break;
         }
 
-        this->_shared_memory_array[index] = std::make_unique<SharedMemory>(index, size_in_bytes, access_type);
-        result                            = ESP_OK;
+        auto offset   = this->_external_used;
+        uint8_t* data = nullptr;
+
+        if (MemoryArena::Holds(placement, read_mode)) {
+            offset = this->_arena_used;
+            data   = this->CarveArena(index, size_in_bytes);
+        } else {
+            data = this->AllocateExternal(index, size_in_bytes);
+        }
+
+        if (data == nullptr) {
+            result = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        this->_shared_memory_array[index] = new (SharedMemoryManager::_area_storage[index])
+            SharedMemory(index, data, size_in_bytes, access_type, read_mode);
+        this->_area_offset[index] = offset;
+        result = ESP_OK;
         this->_num_areas++;
 
     } while (0);
@@ -46,47 +180,1346 @@ titan_err_t SharedMemoryManager::SignUpSharedArea(uint8_t index, uint16_t size_i
 }
 
 /**
- * @brief Checks if the data in a memory area was updated.
+ * @brief Registers a ring area keeping the last records appended to it.
+ *
+ * Unlike the other areas, which hold only the latest value, a ring keeps
+ * up to capacity timestamped records, so a slow consumer can catch up with
+ * a fast producer instead of losing the intermediate values.
+ *
+ * @param index Index of the shared memory area.
+ * @param record_size Maximum payload size of a record.
+ * @param capacity Amount of records kept by the ring.
+ * @param access_type Access type of the shared memory area.
+ * @param placement Memory holding the records, long histories fit better in PSRAM.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::SignUpRingArea(uint8_t index, uint16_t record_size, uint16_t capacity,
+                                                AccessType access_type, AreaPlacement placement) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+
+    do {
+        auto size_in_bytes = SharedMemory::RingStorageSize(record_size, capacity);
+        if ((capacity == 0) || (size_in_bytes > UINT16_MAX)) {
+            result = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+
+        result = this->SignUpSharedArea(index, size_in_bytes, access_type, ReadMode::LOCKED, placement);
+        if (result != ESP_OK) {
+            break;
+        }
+
+        result = this->_shared_memory_array[index]->ConfigureRing(record_size);
+
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Appends a record to a ring area and notifies its subscribers.
+ *
+ * @param[in] area_index The index of the ring area.
+ * @param[in] data Payload of the record.
+ * @param[in] length Size of the payload.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::Append(uint8_t area_index, const uint8_t* data, uint16_t length) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+
+    do {
+        if (area_index >= this->_maximum_shared_memory) {
+            result = Error::INVALID_MEMORY_AREA;
+            break;
+        }
+
+        if (this->_shared_memory_array[area_index] == nullptr) {
+            result = Error::NULL_PTR;
+            break;
+        }
+
+        result = this->_shared_memory_array[area_index]->Append(data, length);
+
+        if (result == Error::NO_ERROR) {
+            this->OnAreaWritten(area_index);
+        }
+
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Copies the records appended to a ring area since a cursor.
+ *
+ * @param[in] area_index The index of the ring area.
+ * @param[in,out] cursor Sequence of the next record to read, advanced past the copied records.
+ * @param[out] buffer Buffer receiving the records, each one a RingRecordHeader followed by its payload.
+ * @param[in] buffer_size Size of the buffer in bytes.
+ * @param[out] missed Optional counter incremented by the records overwritten before being read.
+ * @return uint16_t Amount of bytes copied.
+ */
+uint16_t SharedMemoryManager::ReadSince(uint8_t area_index, uint32_t& cursor, uint8_t* buffer, uint16_t buffer_size,
+                                        uint32_t* missed) {
+    if ((area_index >= this->_maximum_shared_memory) || (this->_shared_memory_array[area_index] == nullptr)) {
+        return 0;
+    }
+
+    return this->_shared_memory_array[area_index]->ReadSince(cursor, buffer, buffer_size, missed);
+}
+
+/**
+ * @brief Attaches a decoded struct cache to a signed up area.
+ *
+ * The cache is carved out of the arena next to the area data and keeps the
+ * last decoded message, so reading an unchanged area is a struct copy
+ * instead of a pb_decode.
+ *
+ * @param area_index Index of the shared memory area.
+ * @param msg_desc Descriptor of the message stored in the area.
+ * @param struct_size Size of the decoded struct.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::EnableDecodedCache(uint8_t area_index, const pb_msgdesc_t* msg_desc, uint16_t struct_size) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+
+    do {
+        if ((area_index >= this->_maximum_shared_memory) || (msg_desc == nullptr)) {
+            result = ESP_ERR_INVALID_ARG;
+            break;
+        }
+
+        auto area = this->_shared_memory_array[area_index];
+        if ((area == nullptr) || (area->GetCacheSize() != 0)) {
+            result = ESP_ERR_INVALID_STATE;
+            break;
+        }
+
+        auto cache = this->CarveArena(area_index, struct_size);
+        if (cache == nullptr) {
+            result = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        area->AttachCache(cache, struct_size, msg_desc);
+        result = ESP_OK;
+
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Takes a cache line aligned block from the arena.
+ *
+ * @param index Index of the area the block belongs to, used for logging.
+ * @param size_in_bytes Size of the block in bytes.
+ * @return uint8_t* Start of the block, nullptr if the arena is exhausted.
+ */
+uint8_t* SharedMemoryManager::CarveArena(uint8_t index, uint16_t size_in_bytes) {
+    auto aligned_size = MemoryArena::Align(size_in_bytes);
+
+    if (this->_arena_used + aligned_size > MemoryArena::SIZE) {
+        ESP_LOGE(TAG, "Area %d of %d bytes does not fit in the arena, %lu bytes left",
+                 index, size_in_bytes, MemoryArena::SIZE - this->_arena_used);
+        return nullptr;
+    }
+
+    auto block = &SharedMemoryManager::_arena[this->_arena_used];
+    this->_arena_used += aligned_size;
+
+    return block;
+}
+
+/**
+ * @brief Allocates a cache line aligned block in PSRAM, released by Initialize.
+ *
+ * Only called by builds with PSRAM support, the arena has no room left for
+ * the external areas.
+ *
+ * @param index Index of the area the block belongs to.
+ * @param size_in_bytes Size of the block in bytes.
+ * @return uint8_t* Start of the block, nullptr if the board has no PSRAM or it is exhausted.
+ */
+uint8_t* SharedMemoryManager::AllocateExternal(uint8_t index, uint16_t size_in_bytes) {
+    if (!this->_has_psram) {
+        ESP_LOGE(TAG, "Area %d of %d bytes needs PSRAM, none was found", index, size_in_bytes);
+        return nullptr;
+    }
+
+    auto aligned_size = MemoryArena::Align(size_in_bytes);
+    auto block        = static_cast<uint8_t*>(
+        heap_caps_aligned_alloc(MemoryArena::ALIGNMENT, aligned_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+
+    if (block == nullptr) {
+        ESP_LOGE(TAG, "Area %d of %d bytes does not fit in PSRAM", index, size_in_bytes);
+        return nullptr;
+    }
+
+    this->_external_data[index] = block;
+    this->_external_used += aligned_size;
+
+    return block;
+}
+
+/**
+ * @brief Registers a new consumer of shared memory areas.
+ *
+ * Each consumer keeps its own record of the last generation seen for every
+ * area, so detecting an update does not hide it from the other consumers.
+ *
+ * @return consumer_handle_t Handle of the consumer, or MemoryConsumer::INVALID_CONSUMER
+ *         if every consumer slot is already in use.
+ */
+consumer_handle_t SharedMemoryManager::RegisterConsumer(void) {
+    auto consumer = this->_num_consumers.fetch_add(1);
+
+    if (consumer >= this->_maximum_consumers) {
+        this->_num_consumers.store(this->_maximum_consumers);
+        return MemoryConsumer::INVALID_CONSUMER;
+    }
+
+    return consumer;
+}
+
+/**
+ * @brief Checks if a memory area was written since the consumer last checked it.
+ *
+ * The current generation of the area is recorded as seen by the consumer, so
+ * the next call only returns true after a new write.
  *
+ * @param[in] consumer Handle returned by RegisterConsumer.
  * @param[in] area_index Index of the memory area to check.
- * @return bool True if the data was updated, false otherwise.
+ * @return bool True if the area was written since the last check, false otherwise.
  */
-bool SharedMemoryManager::IsAreaDataUpdated(uint8_t area_index) {
-    if (this->_shared_memory_array[area_index] != nullptr)
-        return this->_shared_memory_array[area_index]->GetAreaHasUpdated();
-    return false;
+bool SharedMemoryManager::HasChangedSince(consumer_handle_t consumer, uint8_t area_index) {
+    if ((consumer >= this->_maximum_consumers) || (area_index >= this->_maximum_shared_memory)) {
+        return false;
+    }
+
+    if (this->_shared_memory_array[area_index] == nullptr) {
+        return false;
+    }
+
+    this->RestoreIfPending(area_index);
+
+    auto generation = this->_shared_memory_array[area_index]->GetGeneration();
+    auto& last_seen = this->_consumer_generation[consumer][area_index];
+
+    if (generation == last_seen) {
+        return false;
+    }
+
+    last_seen = generation;
+    return true;
 }
 
 /**
- * @brief Retrieves the size of the specified memory area.
+ * @brief Subscribes the calling task to the writes of a memory area.
  *
- * This function returns the size of the memory area at the given index within
- * the shared memory array.
+ * Every successful Write to the area sets the bit (1 << area_index) in the
+ * area notification slot of the task that registered the subscription, so the
+ * task can block in WaitForUpdate instead of polling the area. The area does
+ * not need to be signed up yet.
  *
- * @param[in] area_index The index of the memory area whose size is to be retrieved.
- *                   The index must be within the valid range of the shared memory array.
- * @return uint16_t The size of the memory area at the specified index.
+ * @param[in] consumer Handle returned by RegisterConsumer.
+ * @param[in] area_index Index of the memory area to subscribe to.
+ * @return titan_err_t Error code indicating the result of the operation.
  */
-uint16_t SharedMemoryManager::GetAreaSize(uint8_t area_index) {
-    return this->_shared_memory_array[area_index]->GetSize();
+titan_err_t SharedMemoryManager::Subscribe(consumer_handle_t consumer, uint8_t area_index) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+
+    do {
+        if (consumer >= this->_maximum_consumers) {
+            result = ESP_ERR_INVALID_ARG;
+            break;
+        }
+
+        if (area_index >= this->_maximum_shared_memory) {
+            result = Error::INVALID_MEMORY_AREA;
+            break;
+        }
+
+        this->_consumer_task[consumer] = xTaskGetCurrentTaskHandle();
+        this->_consumer_subscriptions[consumer].fetch_or(1UL << area_index);
+        result = ESP_OK;
+
+    } while (0);
+
+    return result;
 }
 
 /**
- * @brief Retrieves the size of the specified memory area.
+ * @brief Subscribes the calling task to the writes of every memory area.
  *
- * This function returns the amount of bytes written in that memory area at the given index within
- * the shared memory array.
+ * @param[in] consumer Handle returned by RegisterConsumer.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::SubscribeAll(consumer_handle_t consumer) {
+    if (consumer >= this->_maximum_consumers) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    this->_consumer_task[consumer] = xTaskGetCurrentTaskHandle();
+    this->_consumer_subscriptions[consumer].store(UINT32_MAX);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Blocks the calling task until one of its subscribed areas is written.
  *
- * @param[in] area_index The index of the memory area whose size is to be retrieved.
- *                   The index must be within the valid range of the shared memory array.
- * @return uint16_t The amount of written bytes.
+ * Updates are delivered on their own notification slot, see
+ * MemoryConsumer::NOTIFICATION_INDEX, so notifications sent to the task for
+ * other purposes are neither consumed nor mistaken for area updates.
+ *
+ * @param[in] timeout Maximum amount of ticks to wait, portMAX_DELAY to wait forever.
+ * @return uint32_t Bit mask of the areas written since the last call, 0 on timeout or after WakeConsumer.
  */
-uint16_t SharedMemoryManager::GetWrittenBytes(uint8_t area_index) {
-    return this->_shared_memory_array[area_index]->GetWrittenBytes();
+uint32_t SharedMemoryManager::WaitForUpdate(TickType_t timeout) {
+    uint32_t updated_areas = 0;
+
+    if (xTaskNotifyWaitIndexed(MemoryConsumer::NOTIFICATION_INDEX, 0, UINT32_MAX, &updated_areas, timeout) != pdTRUE) {
+        return 0;
+    }
+
+    return updated_areas;
 }
 
-uint16_t SharedMemoryManager::GetNumAreas(void) {
-    return this->_num_areas;
+/**
+ * @brief Wakes a consumer blocked in WaitForUpdate without an area update.
+ *
+ * Lets callbacks running in other tasks, e.g. event handlers, hand work back
+ * to the task of the consumer instead of writing areas themselves.
+ *
+ * @param[in] consumer Handle returned by RegisterConsumer, subscribed to at least one area.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::WakeConsumer(consumer_handle_t consumer) {
+    if ((consumer >= this->_maximum_consumers) || (this->_consumer_task[consumer] == nullptr)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xTaskNotifyIndexed(this->_consumer_task[consumer], MemoryConsumer::NOTIFICATION_INDEX, 0, eNoAction);
+    return ESP_OK;
+}
+
+/**
+ * @brief Signals every task subscribed to a memory area that it was written.
+ *
+ * @param[in] area_index Index of the memory area that was written.
+ */
+void SharedMemoryManager::NotifySubscribers(uint8_t area_index) {
+    uint32_t area_bit = 1UL << area_index;
+    uint8_t consumers = this->_num_consumers.load();
+
+    if (consumers > this->_maximum_consumers) {
+        consumers = this->_maximum_consumers;
+    }
+
+    for (uint8_t consumer = 0; consumer < consumers; consumer++) {
+        if ((this->_consumer_subscriptions[consumer].load() & area_bit) == 0) {
+            continue;
+        }
+
+        if (this->_consumer_task[consumer] != nullptr) {
+            xTaskNotifyIndexed(this->_consumer_task[consumer], MemoryConsumer::NOTIFICATION_INDEX, area_bit, eSetBits);
+        }
+    }
+}
+
+/**
+ * @brief Notifies the subscribers of an area written through a WriteLease.
+ *
+ * @param[in] context Pointer to the SharedMemoryManager that handed out the lease.
+ * @param[in] area_index Index of the memory area that was written.
+ */
+void SharedMemoryManager::OnLeaseCommitted(void* context, uint8_t area_index) {
+    static_cast<SharedMemoryManager*>(context)->OnAreaWritten(area_index);
+}
+
+/**
+ * @brief Handles a completed write: schedules the flush of persistent areas and wakes the subscribers.
+ *
+ * Persistent areas are only marked dirty here, the flush timer is started by
+ * the first write and every write landing before it expires is coalesced in
+ * the same NVS commit, keeping the flash out of the write path. Retained
+ * areas are small and copied to RTC memory right away, a deep sleep can
+ * start at any time.
+ *
+ * @param[in] area_index Index of the memory area that was written.
+ */
+void SharedMemoryManager::OnAreaWritten(uint8_t area_index) {
+    uint32_t area_bit = 1UL << area_index;
+
+    if ((this->_persistent_areas.load() & area_bit) != 0) {
+        /* The new content supersedes the copy stored in NVS. */
+        this->_pending_restore.fetch_and(~area_bit);
+        this->_dirty_areas.fetch_or(area_bit);
+
+        if ((this->_flush_timer != nullptr) && (xTimerIsTimerActive(this->_flush_timer) == pdFALSE)) {
+            xTimerStart(this->_flush_timer, 0);
+        }
+    }
+
+    if ((this->_retained_areas.load() & area_bit) != 0) {
+        this->MirrorRetainedArea(area_index);
+    }
+
+    this->NotifySubscribers(area_index);
+
+    if (this->_write_hook != nullptr) {
+        this->_write_hook(this->_write_hook_context, area_index);
+    }
+}
+
+/**
+ * @brief Installs the callback invoked after every completed write.
+ *
+ * Only one hook can be installed, it runs in the context of the writer after
+ * the area is released and must not block.
+ *
+ * @param[in] hook Callback to install, nullptr to remove it.
+ * @param[in] context Context passed to the hook.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::SetWriteHook(write_hook_t hook, void* context) {
+    if ((hook != nullptr) && (this->_write_hook != nullptr)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    this->_write_hook_context = context;
+    this->_write_hook         = hook;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Asks the housekeeping task for a flush once the coalescing delay expired.
+ *
+ * The flash write blocks on the area locks and NVS, so it is not done in the
+ * timer service task where it would delay every other timer.
+ *
+ * @param[in] timer The flush timer, its ID is the SharedMemoryManager.
+ */
+void SharedMemoryManager::OnFlushTimer(TimerHandle_t timer) {
+    auto manager = static_cast<SharedMemoryManager*>(pvTimerGetTimerID(timer));
+
+    if (manager->_housekeeping_task != nullptr) {
+        xTaskNotify(manager->_housekeeping_task, Housekeeping::FLUSH_PERSISTENT, eSetBits);
+    }
+}
+
+/**
+ * @brief Runs the flushes and the diagnostics publications requested by the timers.
+ *
+ * @param[in] parameters The SharedMemoryManager.
+ */
+void SharedMemoryManager::HousekeepingTask(void* parameters) {
+    auto manager      = static_cast<SharedMemoryManager*>(parameters);
+    uint32_t requests = 0;
+
+    while (1) {
+        if (xTaskNotifyWait(0, UINT32_MAX, &requests, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        if ((requests & Housekeeping::FLUSH_PERSISTENT) != 0) {
+            manager->FlushPersistentAreas();
+        }
+
+        if ((requests & Housekeeping::PUBLISH_DIAGNOSTICS) != 0) {
+            manager->PublishDiagnostics();
+        }
+    }
+}
+
+/**
+ * @brief Creates the housekeeping task if it is not running yet.
+ *
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::StartHousekeeping(void) {
+    if (this->_housekeeping_task != nullptr) {
+        return ESP_OK;
+    }
+
+    if (xTaskCreatePinnedToCore(SharedMemoryManager::HousekeepingTask, "area_housekeeping", Housekeeping::TASK_STACK_SIZE,
+                                this, Housekeeping::TASK_PRIORITY, &this->_housekeeping_task, 0) != pdPASS) {
+        this->_housekeeping_task = nullptr;
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Mirrors an area to NVS, or stops mirroring it.
+ *
+ * The stored copy is not read here: it is restored the first time the area
+ * is read, unless the area is written or restored from RTC memory before.
+ *
+ * @param[in] area_index Index of the memory area.
+ * @param[in] persistent True to mirror the area to NVS.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::SetPersistence(uint8_t area_index, bool persistent) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+
+    do {
+        if (area_index >= this->_maximum_shared_memory) {
+            result = Error::INVALID_MEMORY_AREA;
+            break;
+        }
+
+        auto area = this->_shared_memory_array[area_index];
+        if (area == nullptr) {
+            result = Error::NULL_PTR;
+            break;
+        }
+
+        uint32_t area_bit = 1UL << area_index;
+        if (!persistent) {
+            this->_persistent_areas.fetch_and(~area_bit);
+            this->_pending_restore.fetch_and(~area_bit);
+            this->_dirty_areas.fetch_and(~area_bit);
+            result = ESP_OK;
+            break;
+        }
+
+        if ((area->GetSize() > Persistence::MAXIMUM_AREA_SIZE) || (area->GetKind() != AreaKind::LATEST)) {
+            result = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+
+        result = this->StartHousekeeping();
+        if (result != ESP_OK) {
+            break;
+        }
+
+        /* The copy restored from RTC memory is at least as recent as the one in NVS. */
+        if ((this->_restored_areas.load() & area_bit) == 0) {
+            this->_pending_restore.fetch_or(area_bit);
+        }
+        this->_persistent_areas.fetch_or(area_bit);
+        result = ESP_OK;
+
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Writes every dirty persistent area to NVS in a single commit.
+ *
+ * Each area is copied out before the persistence mutex is taken, so writers
+ * of the area are never blocked by the flash and no area is locked while the
+ * mutex is held. Called by the housekeeping task, and can be called directly before
+ * a reset to avoid losing the last writes. Must not be called while holding
+ * a view or a lease.
+ *
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::FlushPersistentAreas(void) {
+    titan_err_t result = ESP_OK;
+
+    if ((this->_flush_mutex == nullptr) || (xSemaphoreTake(this->_flush_mutex, portMAX_DELAY) != pdTRUE)) {
+        return Error::UNKNOW_FAIL;
+    }
+
+    uint32_t dirty = this->_dirty_areas.exchange(0);
+    bool stored    = false;
+
+    for (uint8_t area_index = 0; (area_index < this->_maximum_shared_memory) && (dirty != 0); area_index++) {
+        uint32_t area_bit = 1UL << area_index;
+        auto area         = this->_shared_memory_array[area_index];
+
+        if (((dirty & area_bit) == 0) || (area == nullptr)) {
+            continue;
+        }
+        dirty &= ~area_bit;
+
+        auto view = area->Borrow();
+        if (!view.valid()) {
+            continue;
+        }
+
+        uint16_t length = view.size();
+        memcpy(SharedMemoryManager::_persistence_buffer, view.data(), length);
+        view.Release();
+
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        PersistenceKey(area_index, key);
+
+        xSemaphoreTake(this->_persistence_mutex, portMAX_DELAY);
+
+        auto written = this->OpenStorage();
+        if (written == ESP_OK) {
+            written = nvs_set_blob(this->_nvs_handle, key, SharedMemoryManager::_persistence_buffer, length);
+        }
+
+        xSemaphoreGive(this->_persistence_mutex);
+
+        if (written != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to persist area %d: %d", area_index, written);
+            this->_dirty_areas.fetch_or(area_bit);
+            result = written;
+            continue;
+        }
+        stored = true;
+    }
+
+    if (stored) {
+        xSemaphoreTake(this->_persistence_mutex, portMAX_DELAY);
+        auto committed = nvs_commit(this->_nvs_handle);
+        xSemaphoreGive(this->_persistence_mutex);
+
+        if (committed != ESP_OK) {
+            result = committed;
+        }
+    }
+
+    xSemaphoreGive(this->_flush_mutex);
+
+    return result;
+}
+
+/**
+ * @brief Opens the persistence namespace, must be called with the persistence mutex held.
+ *
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::OpenStorage(void) {
+    if (this->_nvs_opened) {
+        return ESP_OK;
+    }
+
+    auto result = nvs_open(Persistence::NVS_NAMESPACE, NVS_READWRITE, &this->_nvs_handle);
+    this->_nvs_opened = result == ESP_OK;
+
+    return result;
+}
+
+/**
+ * @brief Loads a persistent area from NVS and notifies its subscribers.
+ *
+ * The area is leased before the persistence mutex is taken, the order every
+ * NVS access follows, so a restore cannot deadlock with a flush. Concurrent
+ * readers of the area wait on the lease until the first one restored it.
+ * Nothing is restored if the area was written in the meantime.
+ *
+ * @param[in] area_index Index of the memory area.
+ */
+void SharedMemoryManager::RestoreArea(uint8_t area_index) {
+    uint32_t area_bit = 1UL << area_index;
+    auto area         = this->_shared_memory_array[area_index];
+    auto restored     = false;
+    size_t length     = 0;
+
+    if (area == nullptr) {
+        return;
+    }
+
+    auto lease = area->Lease();
+    if (!lease.valid()) {
+        return;
+    }
+
+    xSemaphoreTake(this->_persistence_mutex, portMAX_DELAY);
+
+    if (((this->_pending_restore.load() & area_bit) != 0) && (this->OpenStorage() == ESP_OK)) {
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        PersistenceKey(area_index, key);
+
+        length      = lease.capacity();
+        auto result = nvs_get_blob(this->_nvs_handle, key, lease.data(), &length);
+        if ((result != ESP_OK) && (result != ESP_ERR_NVS_NOT_FOUND)) {
+            ESP_LOGE(TAG, "Failed to restore area %d: %d", area_index, result);
+        }
+        restored = (result == ESP_OK) && (length > 0);
+    }
+
+    this->_pending_restore.fetch_and(~area_bit);
+    xSemaphoreGive(this->_persistence_mutex);
+
+    /* A lease released without Commit leaves the area and its generation untouched. */
+    if (restored) {
+        lease.Commit(length);
+    }
+    lease.Release();
+
+    if (restored) {
+        ESP_LOGI(TAG, "Area %d restored, %d bytes", area_index, length);
+        this->OnAreaWritten(area_index);
+    }
+}
+
+/**
+ * @brief Mirrors an area to RTC memory, or stops mirroring it.
+ *
+ * Every completed write is copied to RTC slow memory, which keeps its
+ * content through deep sleep. A valid copy left there before the sleep is
+ * restored right away, and a persistent area restored this way is not read
+ * back from NVS afterwards.
+ *
+ * @param[in] area_index Index of the memory area.
+ * @param[in] retained True to mirror the area to RTC memory.
+ * @return titan_err_t Error code indicating the result of the operation.
+ *         - ESP_ERR_NO_MEM if the area does not fit in the retained memory left.
+ */
+titan_err_t SharedMemoryManager::SetRetention(uint8_t area_index, bool retained) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+
+    do {
+        if (area_index >= this->_maximum_shared_memory) {
+            result = Error::INVALID_MEMORY_AREA;
+            break;
+        }
+
+        auto area = this->_shared_memory_array[area_index];
+        if (area == nullptr) {
+            result = Error::NULL_PTR;
+            break;
+        }
+
+        uint32_t area_bit = 1UL << area_index;
+        auto& slot        = SharedMemoryManager::_retained.slots[area_index];
+
+        if (!retained) {
+            this->_retained_areas.fetch_and(~area_bit);
+            /* An empty copy is never restored, the slot is kept for the next sign up. */
+            if (this->IsRetainedSlotValid(area_index, slot.capacity)) {
+                slot.written_bytes = 0;
+                slot.crc           = SharedMemoryManager::RetainedChecksum(area_index);
+            }
+            result = ESP_OK;
+            break;
+        }
+
+        if (area->GetKind() != AreaKind::LATEST) {
+            result = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+
+        uint16_t capacity = area->GetSize();
+
+        if (this->IsRetainedSlotValid(area_index, capacity)) {
+            if (slot.written_bytes > 0) {
+                auto lease = area->Lease();
+                if (lease.valid()) {
+                    memcpy(lease.data(), SharedMemoryManager::_retained.data + slot.offset, slot.written_bytes);
+                    lease.Commit(slot.written_bytes);
+                    lease.Release();
+
+                    ESP_LOGI(TAG, "Area %d restored from RTC memory, %d bytes", area_index, slot.written_bytes);
+                    this->_restored_areas.fetch_or(area_bit);
+                    this->OnAreaWritten(area_index);
+                }
+            }
+        } else {
+            /* The copy is dropped, its storage is kept unless the area outgrew it or it lies outside the block. */
+            if ((Retention::Align(capacity) > Retention::Align(slot.capacity)) ||
+                ((slot.offset + slot.capacity) > SharedMemoryManager::_retained.used)) {
+                auto aligned_size = Retention::Align(capacity);
+                if (SharedMemoryManager::_retained.used + aligned_size > Retention::SIZE) {
+                    ESP_LOGE(TAG, "Retained memory exhausted, area %d needs %lu bytes, %lu/%lu used",
+                             area_index, aligned_size, SharedMemoryManager::_retained.used, Retention::SIZE);
+                    result = ESP_ERR_NO_MEM;
+                    break;
+                }
+
+                slot.offset = SharedMemoryManager::_retained.used;
+                SharedMemoryManager::_retained.used += aligned_size;
+            }
+
+            slot.capacity      = capacity;
+            slot.written_bytes = 0;
+            slot.reserved      = 0;
+            slot.crc           = SharedMemoryManager::RetainedChecksum(area_index);
+        }
+
+        this->_retained_areas.fetch_or(area_bit);
+        result = ESP_OK;
+
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Checks if valid retained areas were found in RTC memory by Initialize.
+ *
+ * Only true when the firmware wakes up from deep sleep or after a reset that
+ * keeps RTC memory, the boot path can then skip what the retained areas
+ * already hold.
+ *
+ * @return bool True if at least one retained area holds data.
+ */
+bool SharedMemoryManager::HasRetainedState(void) {
+    return this->_retained_state;
+}
+
+/**
+ * @brief Checks the retained block left in RTC memory, laying it out again if it cannot be trusted.
+ *
+ * The copies themselves are only restored when their area is signed up.
+ */
+void SharedMemoryManager::ValidateRetainedMemory(void) {
+    auto& retained        = SharedMemoryManager::_retained;
+    this->_retained_state = false;
+
+    if ((retained.magic == Retention::MAGIC) && (retained.size == Retention::SIZE) && (retained.used <= Retention::SIZE)) {
+        for (uint8_t i = 0; i < this->_maximum_shared_memory; i++) {
+            if ((retained.slots[i].written_bytes > 0) && this->IsRetainedSlotValid(i, retained.slots[i].capacity)) {
+                this->_retained_state = true;
+            }
+        }
+    }
+
+    if (!this->_retained_state) {
+        memset(&retained, 0, offsetof(RetainedMemory, data));
+        retained.magic = Retention::MAGIC;
+        retained.size  = Retention::SIZE;
+    }
+}
+
+/**
+ * @brief Checks if the retained slot of an area holds a copy that can be trusted.
+ *
+ * @param[in] area_index Index of the memory area, must be a valid index.
+ * @param[in] capacity Size the area is signed up with.
+ * @return bool True if the slot fits the retained block, matches the size and its checksum.
+ */
+bool SharedMemoryManager::IsRetainedSlotValid(uint8_t area_index, uint16_t capacity) {
+    auto& slot = SharedMemoryManager::_retained.slots[area_index];
+
+    return (capacity != 0) && (slot.capacity == capacity) && (slot.written_bytes <= slot.capacity) &&
+           ((slot.offset + slot.capacity) <= SharedMemoryManager::_retained.used) &&
+           (slot.crc == SharedMemoryManager::RetainedChecksum(area_index));
+}
+
+/**
+ * @brief Computes the checksum of a retained slot, covering its geometry and the valid bytes of the copy.
+ *
+ * @param[in] area_index Index of the memory area, its slot must fit the retained block.
+ * @return uint32_t The checksum of the slot.
+ */
+uint32_t SharedMemoryManager::RetainedChecksum(uint8_t area_index) {
+    auto& slot = SharedMemoryManager::_retained.slots[area_index];
+    auto crc   = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&slot), offsetof(RetainedSlot, crc));
+
+    return esp_rom_crc32_le(crc, SharedMemoryManager::_retained.data + slot.offset, slot.written_bytes);
+}
+
+/**
+ * @brief Copies a retained area to RTC memory.
+ *
+ * The area stays borrowed during the copy, so concurrent writers mirror
+ * their content one at a time and the last one wins.
+ *
+ * @param[in] area_index Index of the memory area.
+ */
+void SharedMemoryManager::MirrorRetainedArea(uint8_t area_index) {
+    auto area = this->_shared_memory_array[area_index];
+    if (area == nullptr) {
+        return;
+    }
+
+    auto view = area->Borrow();
+    if (!view.valid()) {
+        return;
+    }
+
+    auto& slot      = SharedMemoryManager::_retained.slots[area_index];
+    uint16_t length = (view.size() < slot.capacity) ? view.size() : slot.capacity;
+
+    memcpy(SharedMemoryManager::_retained.data + slot.offset, view.data(), length);
+    slot.written_bytes = length;
+    slot.crc           = SharedMemoryManager::RetainedChecksum(area_index);
+}
+
+/**
+ * @brief Borrows the storage of a memory area for reading without copying it.
+ *
+ * @param[in] area_index The index of the memory area.
+ * @param[in] timeout Maximum amount of ticks to wait for the area mutex.
+ * @return SharedMemory::ReadView View over the area, not valid if the area does not exist or stayed locked.
+ */
+SharedMemory::ReadView SharedMemoryManager::Borrow(uint8_t area_index, TickType_t timeout) {
+    if ((area_index >= this->_maximum_shared_memory) || (this->_shared_memory_array[area_index] == nullptr)) {
+        return SharedMemory::ReadView();
+    }
+
+    this->RestoreIfPending(area_index);
+
+    return this->_shared_memory_array[area_index]->Borrow(timeout);
+}
+
+/**
+ * @brief Leases the storage of a memory area for writing in place.
+ *
+ * Subscribers of the area are notified when a committed lease is released.
+ *
+ * @param[in] area_index The index of the memory area.
+ * @param[in] timeout Maximum amount of ticks to wait for the area mutex.
+ * @return SharedMemory::WriteLease Lease over the area, not valid if the area does not exist or stayed locked.
+ */
+SharedMemory::WriteLease SharedMemoryManager::Lease(uint8_t area_index, TickType_t timeout) {
+    if ((area_index >= this->_maximum_shared_memory) || (this->_shared_memory_array[area_index] == nullptr)) {
+        return SharedMemory::WriteLease();
+    }
+
+    return this->_shared_memory_array[area_index]->Lease(SharedMemoryManager::OnLeaseCommitted, this, timeout);
+}
+
+/**
+ * @brief Sets the priority the holder of a memory area runs at, see SharedMemory::SetPriorityCeiling.
+ *
+ * @param[in] area_index The index of the memory area.
+ * @param[in] ceiling Priority of the highest task using the area, AreaLock::NO_CEILING to disable it.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::SetPriorityCeiling(uint8_t area_index, UBaseType_t ceiling) {
+    if (area_index >= this->_maximum_shared_memory) {
+        return Error::INVALID_MEMORY_AREA;
+    }
+
+    if (this->_shared_memory_array[area_index] == nullptr) {
+        return Error::NULL_PTR;
+    }
+
+    if (ceiling >= configMAX_PRIORITIES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    this->_shared_memory_array[area_index]->SetPriorityCeiling(ceiling);
+    return ESP_OK;
+}
+
+/**
+ * @brief Borrows several areas at once for a coherent read.
+ *
+ * The areas are locked in ascending index order, the same order used by
+ * Transaction, so concurrent snapshots and transactions cannot deadlock.
+ *
+ * @param[in] areas Indexes of the areas to read.
+ * @return AreaSnapshot Snapshot holding the areas, not valid if one of them could not be borrowed.
+ */
+AreaSnapshot SharedMemoryManager::Snapshot(std::initializer_list<uint8_t> areas) {
+    AreaSnapshot snapshot;
+    uint8_t sorted[AreaSet::MAXIMUM_AREAS];
+    uint8_t count = SortAreas(areas, sorted);
+
+    this->RestorePendingAreas(sorted, count);
+
+    for (uint8_t i = 0; i < count; i++) {
+        auto view = this->Borrow(sorted[i]);
+        if (!view.valid()) {
+            snapshot.Release();
+            return snapshot;
+        }
+
+        snapshot._areas[snapshot._count]   = sorted[i];
+        snapshot._views[snapshot._count++] = std::move(view);
+    }
+
+    snapshot._valid = count > 0;
+    return snapshot;
+}
+
+/**
+ * @brief Leases several areas at once for an atomic write.
+ *
+ * @param[in] areas Indexes of the areas to write.
+ * @return AreaTransaction Transaction holding the areas, not valid if one of them could not be leased.
+ */
+AreaTransaction SharedMemoryManager::Transaction(std::initializer_list<uint8_t> areas) {
+    AreaTransaction transaction;
+    uint8_t sorted[AreaSet::MAXIMUM_AREAS];
+    uint8_t count = SortAreas(areas, sorted);
+
+    this->RestorePendingAreas(sorted, count);
+
+    for (uint8_t i = 0; i < count; i++) {
+        auto lease = this->Lease(sorted[i]);
+        if (!lease.valid()) {
+            /* Nothing was written yet, the areas already leased keep their generation. */
+            transaction.Abort();
+            return transaction;
+        }
+
+        transaction._areas[transaction._count]    = sorted[i];
+        transaction._leases[transaction._count++] = std::move(lease);
+    }
+
+    transaction._valid = count > 0;
+    return transaction;
+}
+
+/**
+ * @brief Writes a chunk of an area at the given offset and notifies its subscribers.
+ *
+ * Streaming a payload this way wakes the subscribers once per chunk, producers
+ * that want a single notification should append the chunks to a Lease instead.
+ *
+ * @param[in] area_index The index of the memory area.
+ * @param[in] offset Position of the chunk, no greater than the written bytes.
+ * @param[in] buffer Chunk to write.
+ * @param[in] length Size of the chunk in bytes.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::WriteChunk(uint8_t area_index, uint16_t offset, const uint8_t* buffer, uint16_t length) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+
+    do {
+        if (area_index >= this->_maximum_shared_memory) {
+            result = Error::INVALID_MEMORY_AREA;
+            break;
+        }
+
+        if (this->_shared_memory_array[area_index] == nullptr) {
+            result = Error::NULL_PTR;
+            break;
+        }
+
+        result = this->_shared_memory_array[area_index]->WriteChunk(offset, buffer, length);
+
+        if (result == Error::NO_ERROR) {
+            this->OnAreaWritten(area_index);
+        }
+
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Copies a chunk of an area starting at the given offset.
+ *
+ * @param[in] area_index The index of the memory area.
+ * @param[in] offset Position of the first byte to copy.
+ * @param[out] buffer Buffer receiving the chunk.
+ * @param[in] length Size of the buffer in bytes.
+ * @return uint16_t Amount of bytes copied, 0 once the offset reaches the written bytes.
+ */
+uint16_t SharedMemoryManager::ReadChunk(uint8_t area_index, uint16_t offset, uint8_t* buffer, uint16_t length) {
+    if ((area_index >= this->_maximum_shared_memory) || (this->_shared_memory_array[area_index] == nullptr)) {
+        return 0;
+    }
+
+    this->RestoreIfPending(area_index);
+
+    return this->_shared_memory_array[area_index]->ReadChunk(offset, buffer, length);
+}
+
+/**
+ * @brief Retrieves the generation of the specified memory area.
+ *
+ * @param[in] area_index The index of the memory area.
+ * @return uint32_t The amount of completed writes in the area, 0 if the area does not exist.
+ */
+uint32_t SharedMemoryManager::GetGeneration(uint8_t area_index) {
+    if ((area_index >= this->_maximum_shared_memory) || (this->_shared_memory_array[area_index] == nullptr)) {
+        return 0;
+    }
+
+    return this->_shared_memory_array[area_index]->GetGeneration();
+}
+
+/**
+ * @brief Retrieves the size of the specified memory area.
+ *
+ * This function returns the size of the memory area at the given index within
+ * the shared memory array.
+ *
+ * @param[in] area_index The index of the memory area whose size is to be retrieved.
+ * @return uint16_t The size of the memory area at the specified index, 0 if the area was not signed up.
+ */
+uint16_t SharedMemoryManager::GetAreaSize(uint8_t area_index) {
+    if ((area_index >= this->_maximum_shared_memory) || (this->_shared_memory_array[area_index] == nullptr)) {
+        return 0;
+    }
+
+    return this->_shared_memory_array[area_index]->GetSize();
+}
+
+/**
+ * @brief Retrieves the size of the specified memory area.
+ *
+ * This function returns the amount of bytes written in that memory area at the given index within
+ * the shared memory array.
+ *
+ * @param[in] area_index The index of the memory area whose size is to be retrieved.
+ * @return uint16_t The amount of written bytes, 0 if the area was not signed up.
+ */
+uint16_t SharedMemoryManager::GetWrittenBytes(uint8_t area_index) {
+    if ((area_index >= this->_maximum_shared_memory) || (this->_shared_memory_array[area_index] == nullptr)) {
+        return 0;
+    }
+
+    return this->_shared_memory_array[area_index]->GetWrittenBytes();
+}
+
+/**
+ * @brief Retrieves the layout of the specified memory area.
+ *
+ * @param[in] area_index The index of the memory area.
+ * @return AreaKind The layout of the area, AreaKind::LATEST if the area was not signed up.
+ */
+AreaKind SharedMemoryManager::GetAreaKind(uint8_t area_index) {
+    if ((area_index >= this->_maximum_shared_memory) || (this->_shared_memory_array[area_index] == nullptr)) {
+        return AreaKind::LATEST;
+    }
+
+    return this->_shared_memory_array[area_index]->GetKind();
+}
+
+uint16_t SharedMemoryManager::GetNumAreas(void) {
+    return this->_num_areas;
+}
+
+/**
+ * @brief Retrieves the amount of arena bytes taken by the signed up areas.
+ *
+ * @return uint32_t The used bytes, including the alignment padding.
+ */
+uint32_t SharedMemoryManager::GetArenaUsage(void) {
+    return this->_arena_used;
+}
+
+/**
+ * @brief Retrieves the amount of PSRAM allocated for the external areas.
+ *
+ * @return uint32_t Amount of bytes, including the alignment padding.
+ */
+uint32_t SharedMemoryManager::GetExternalUsage(void) {
+    return this->_external_used;
+}
+
+/**
+ * @brief Retrieves the memory an area was actually placed in.
+ *
+ * @param[in] area_index The index of the memory area.
+ * @return AreaPlacement AreaPlacement::EXTERNAL only if the area data lives in PSRAM.
+ */
+AreaPlacement SharedMemoryManager::GetAreaPlacement(uint8_t area_index) {
+    if ((area_index >= this->_maximum_shared_memory) || (this->_external_data[area_index] == nullptr)) {
+        return AreaPlacement::INTERNAL;
+    }
+
+    return AreaPlacement::EXTERNAL;
+}
+
+/**
+ * @brief Logs the placement of every signed up area inside the arena or PSRAM.
+ *
+ * Ends with the free internal heap, what is left for the task stacks and
+ * the DMA buffers once every area is signed up.
+ */
+void SharedMemoryManager::PrintMemoryMap(void) {
+    static const char* access_names[] = {"RO", "WO", "RW"};
+
+    ESP_LOGI(TAG, "Shared memory arena at %p, %lu/%lu bytes used, %d areas",
+             SharedMemoryManager::_arena, this->_arena_used, MemoryArena::SIZE, this->_num_areas);
+    ESP_LOGI(TAG, "Retained memory at %p, %lu/%lu bytes used%s",
+             SharedMemoryManager::_retained.data, SharedMemoryManager::_retained.used, Retention::SIZE,
+             this->_retained_state ? ", restored after deep sleep" : "");
+    ESP_LOGI(TAG, "PSRAM areas %lu bytes", this->_external_used);
+
+    for (uint16_t i = 0; i < this->_maximum_shared_memory; i++) {
+        auto area = this->_shared_memory_array[i];
+        if (area == nullptr) {
+            continue;
+        }
+
+        ESP_LOGI(TAG, "  area %2d: %s offset %5lu size %5d (%5lu aligned) cache %4d %s %s%s%s",
+                 i,
+                 this->_external_data[i] != nullptr ? "psram" : "arena",
+                 this->_area_offset[i],
+                 area->GetSize(),
+                 MemoryArena::Align(area->GetSize()),
+                 area->GetCacheSize(),
+                 access_names[area->GetAccess()],
+                 area->GetReadMode() == ReadMode::OPTIMISTIC ? "optimistic" : "locked",
+                 area->GetKind() == AreaKind::RING ? " ring" : "",
+                 (this->_retained_areas.load() & (1UL << i)) != 0 ? " retained" : "");
+    }
+
+    ESP_LOGI(TAG, "Internal heap %u bytes free, largest block %u bytes, PSRAM heap %u bytes free",
+             heap_caps_get_free_size(MALLOC_CAP_INTERNAL), heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL),
+             heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+}
+
+/**
+ * @brief Retrieves the contention and latency counters of a memory area.
+ *
+ * @param[in] area_index The index of the memory area.
+ * @param[out] counters The counters of the area.
+ * @return titan_err_t Error code indicating the result of the operation.
+ *         - ESP_ERR_NOT_SUPPORTED if the firmware is built without TITANIUM_AREA_STATISTICS.
+ */
+titan_err_t SharedMemoryManager::GetAreaCounters(uint8_t area_index, AreaCounters& counters) {
+    if (area_index >= this->_maximum_shared_memory) {
+        return Error::INVALID_MEMORY_AREA;
+    }
+
+    if (this->_shared_memory_array[area_index] == nullptr) {
+        return Error::NULL_PTR;
+    }
+
+    return this->_shared_memory_array[area_index]->GetCounters(counters);
+}
+
+/**
+ * @brief Logs the counters of every signed up area.
+ */
+void SharedMemoryManager::DumpAreaCounters(void) {
+    AreaCounters counters;
+
+    for (uint16_t i = 0; i < this->_maximum_shared_memory; i++) {
+        if (this->GetAreaCounters(i, counters) != ESP_OK) {
+            continue;
+        }
+
+        ESP_LOGI(TAG, "  area %2d: reads %6lu writes %6lu contended %5lu/%6lu timeouts %lu wait %lu/%lu/%lu us "
+                      "codec %lu/%lu us bytes %lu/%lu last writer %s",
+                 i,
+                 counters.reads,
+                 counters.writes,
+                 counters.contended,
+                 counters.locks,
+                 counters.timeouts,
+                 counters.wait_min_us,
+                 counters.contended == 0 ? 0 : counters.wait_total_us / counters.contended,
+                 counters.wait_max_us,
+                 counters.codecs == 0 ? 0 : counters.codec_total_us / counters.codecs,
+                 counters.codec_max_us,
+                 counters.bytes_read,
+                 counters.bytes_written,
+                 counters.last_writer);
+    }
+}
+
+/**
+ * @brief Signs up the diagnostics area and publishes the area counters periodically.
+ *
+ * @param[in] period_ms Delay between two publications.
+ * @return titan_err_t Error code indicating the result of the operation.
+ *         - ESP_ERR_NOT_SUPPORTED if the firmware is built without TITANIUM_AREA_STATISTICS.
+ */
+titan_err_t SharedMemoryManager::EnableDiagnostics(uint32_t period_ms) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+
+    do {
+        if (!TITANIUM_AREA_STATISTICS) {
+            result = ESP_ERR_NOT_SUPPORTED;
+            break;
+        }
+
+        if (this->_shared_memory_array[MEMORY_AREAS_AREA_DIAGNOSTICS] == nullptr) {
+            result = this->SignUpSharedArea<MEMORY_AREAS_AREA_DIAGNOSTICS>();
+            if (result != ESP_OK) {
+                break;
+            }
+        }
+
+        result = this->StartHousekeeping();
+        if (result != ESP_OK) {
+            break;
+        }
+
+        if (this->_diagnostics_timer == nullptr) {
+            this->_diagnostics_timer = xTimerCreateStatic("area_diag", pdMS_TO_TICKS(period_ms), pdTRUE, this,
+                                                          SharedMemoryManager::OnDiagnosticsTimer,
+                                                          &this->_diagnostics_timer_buffer);
+        } else {
+            xTimerChangePeriod(this->_diagnostics_timer, pdMS_TO_TICKS(period_ms), 0);
+        }
+
+        result = xTimerStart(this->_diagnostics_timer, 0) == pdPASS ? ESP_OK : Error::UNKNOW_FAIL;
+
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Asks the housekeeping task for a diagnostics publication.
+ *
+ * The publication leases an area, encodes a large message and runs the write
+ * hooks, none of which belongs in the timer service task.
+ *
+ * @param[in] timer The diagnostics timer, its ID is the SharedMemoryManager.
+ */
+void SharedMemoryManager::OnDiagnosticsTimer(TimerHandle_t timer) {
+    auto manager = static_cast<SharedMemoryManager*>(pvTimerGetTimerID(timer));
+
+    if (manager->_housekeeping_task != nullptr) {
+        xTaskNotify(manager->_housekeeping_task, Housekeeping::PUBLISH_DIAGNOSTICS, eSetBits);
+    }
+}
+
+/**
+ * @brief Writes the counters of every signed up area to the diagnostics area.
+ *
+ * The message is encoded straight into the area, the counters of the other
+ * areas are sampled without locking them. A reader holding the diagnostics
+ * area longer than Housekeeping::LOCK_TIMEOUT_MS makes this publication skip.
+ *
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t SharedMemoryManager::PublishDiagnostics(void) {
+    titan_err_t result = Error::UNKNOW_FAIL;
+    constexpr pb_size_t maximum_entries = sizeof(_diagnostics.areas) / sizeof(_diagnostics.areas[0]);
+
+    do {
+        if (this->_shared_memory_array[MEMORY_AREAS_AREA_DIAGNOSTICS] == nullptr) {
+            result = Error::NULL_PTR;
+            break;
+        }
+
+        auto lease = this->Lease(MEMORY_AREAS_AREA_DIAGNOSTICS, pdMS_TO_TICKS(Housekeeping::LOCK_TIMEOUT_MS));
+        if (!lease.valid()) {
+            result = Error::LOCK_TIMEOUT;
+            break;
+        }
+
+        auto& diagnostics       = SharedMemoryManager::_diagnostics;
+        diagnostics.areas_count = 0;
+
+        for (uint8_t i = 0; (i < this->_maximum_shared_memory) && (diagnostics.areas_count < maximum_entries); i++) {
+            AreaCounters counters;
+            if (this->GetAreaCounters(i, counters) != ESP_OK) {
+                continue;
+            }
+
+            auto& entry         = diagnostics.areas[diagnostics.areas_count++];
+            entry.area          = static_cast<memory_areas_t>(i);
+            entry.reads         = counters.reads;
+            entry.writes        = counters.writes;
+            entry.contended     = counters.contended;
+            entry.wait_min_us   = counters.wait_min_us;
+            entry.wait_avg_us   = counters.contended == 0 ? 0 : counters.wait_total_us / counters.contended;
+            entry.wait_max_us   = counters.wait_max_us;
+            entry.codec_avg_us  = counters.codecs == 0 ? 0 : counters.codec_total_us / counters.codecs;
+            entry.codec_max_us  = counters.codec_max_us;
+            entry.bytes_read    = counters.bytes_read;
+            entry.bytes_written = counters.bytes_written;
+            strncpy(entry.last_writer, counters.last_writer, sizeof(entry.last_writer) - 1);
+            entry.last_writer[sizeof(entry.last_writer) - 1] = '\0';
+        }
+
+        pb_ostream_t ostream = pb_ostream_from_buffer(lease.data(), lease.capacity());
+        if (!pb_encode(&ostream, &area_diagnostics_t_msg, &diagnostics)) {
+            result = Error::SERIALIZE_ERROR;
+            break;
+        }
+
+        result = lease.Commit(ostream.bytes_written);
+
+    } while (0);
+
+    return result;
 }
 
 /**
@@ -2,35 +2,310 @@
 #define SHARED_MEMORY_MANAGER_H
 
 #include <stdint.h>
+#include <atomic>
+#include <initializer_list>
 #include <memory>
 
+#include "freertos/timers.h"
+#include "nvs.h"
+#include "sdkconfig.h"
+
 #include "Application/error/error_enum.h"
+#include "AreaSnapshot.h"
+#include "HAL/inc/AreaRegistry.hpp"
 #include "SharedMemory.h"
 
+/**
+ * @brief Handle identifying a consumer of shared memory areas.
+ */
+typedef uint8_t consumer_handle_t;
+
+namespace MemoryConsumer {
+    constexpr consumer_handle_t INVALID_CONSUMER = 0xFF; /**< Handle returned when no consumer slot is available. */
+    constexpr UBaseType_t NOTIFICATION_INDEX     = 1;    /**< Task notification slot carrying the area updates, slot 0 is left to the tasks. */
+}  // namespace MemoryConsumer
+
+#ifndef TITANIUM_MEMORY_ARENA_SIZE
+#define TITANIUM_MEMORY_ARENA_SIZE 4096 /**< Overridable with a build flag when large areas are signed up, PSRAM areas included. */
+#endif
+
+namespace Persistence {
+    constexpr const char* NVS_NAMESPACE      = "titanium"; /**< NVS namespace holding the persistent areas. */
+    constexpr uint32_t FLUSH_DELAY_MS        = 2000;       /**< Writes to persistent areas are coalesced for this long. */
+    constexpr uint16_t MAXIMUM_AREA_SIZE     = 512;        /**< Largest area that can be persisted. */
+}  // namespace Persistence
+
+namespace Housekeeping {
+    constexpr uint32_t TASK_STACK_SIZE      = 4096;     /**< Stack of the task flushing the areas and publishing the diagnostics. */
+    constexpr UBaseType_t TASK_PRIORITY     = 1;        /**< The flash writes and the diagnostics run in the background. */
+    constexpr uint32_t FLUSH_PERSISTENT     = 1UL << 0; /**< Notification bit asking for a flush of the dirty areas. */
+    constexpr uint32_t PUBLISH_DIAGNOSTICS  = 1UL << 1; /**< Notification bit asking for a diagnostics publication. */
+    constexpr uint32_t LOCK_TIMEOUT_MS      = 100;      /**< Longest wait for the diagnostics area, a late publication is skipped. */
+}  // namespace Housekeeping
+
+#ifndef TITANIUM_RETAINED_MEMORY_SIZE
+#define TITANIUM_RETAINED_MEMORY_SIZE 1024 /**< Overridable with a build flag, RTC slow memory is 8 KB in total. */
+#endif
+
+namespace Retention {
+    constexpr uint32_t SIZE      = TITANIUM_RETAINED_MEMORY_SIZE; /**< Bytes of RTC slow memory reserved for the retained areas. */
+    constexpr uint32_t MAGIC     = 0x4E544954;                    /**< Marks a retained block laid out by this firmware. */
+    constexpr uint32_t ALIGNMENT = 4;                             /**< Every retained area starts on a word. */
+
+    /**
+     * @brief Rounds a size up to the retained block alignment.
+     */
+    constexpr uint32_t Align(uint32_t size) {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+}  // namespace Retention
+
+namespace MemoryArena {
+    constexpr uint32_t ALIGNMENT = 32;   /**< Cache line size, every area starts on its own line. */
+
+    /**
+     * @brief Rounds a size up to the arena alignment.
+     */
+    constexpr uint32_t Align(uint32_t size) {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    /**
+     * @brief Checks if an area takes its data from the arena.
+     *
+     * Only builds with PSRAM support move the external areas out, optimistic
+     * areas stay internal whatever their placement.
+     */
+    constexpr bool Holds(AreaPlacement placement, ReadMode read_mode) {
+#if CONFIG_SPIRAM
+        return (placement != AreaPlacement::EXTERNAL) || (read_mode == ReadMode::OPTIMISTIC);
+#else
+        return true;
+#endif
+    }
+
+    /**
+     * @brief Checks if a registered area takes its data from the arena.
+     */
+    constexpr bool Holds(const AreaDescriptor& area) {
+        return Holds(area.placement, area.read_mode);
+    }
+
+    /**
+     * @brief Bytes of the registered areas placed in PSRAM, left out of the arena.
+     */
+    constexpr uint32_t ExternalRegistrySize(void) {
+        uint32_t size = 0;
+        for (const auto& area : AreaRegistry::AREAS) {
+            if (!Holds(area)) {
+                size += Align(area.size);
+            }
+        }
+        return size;
+    }
+
+    static_assert(ExternalRegistrySize() < TITANIUM_MEMORY_ARENA_SIZE,
+                  "PSRAM areas exceed TITANIUM_MEMORY_ARENA_SIZE, raise it");
+
+    /**
+     * @brief Bytes reserved for the data of the internal areas and the decoded caches.
+     *
+     * TITANIUM_MEMORY_ARENA_SIZE budgets every area, the share of the areas
+     * registered in PSRAM is given back to the internal heap. There is no
+     * fallback: an external area that does not fit in PSRAM fails to sign up.
+     */
+    constexpr uint32_t SIZE = TITANIUM_MEMORY_ARENA_SIZE - ExternalRegistrySize();
+}  // namespace MemoryArena
+
 /**
  * @brief Manages shared memory used for services to exchange data.
  */
 class SharedMemoryManager {
    public:
+    /**
+     * @brief Callback invoked after every completed write, see SetWriteHook.
+     */
+    typedef void (*write_hook_t)(void* context, uint8_t area_index);
+
     SharedMemoryManager(const SharedMemoryManager& obj) = delete;
     static SharedMemoryManager* GetInstance(void);
 
    public:
     titan_err_t Initialize(void);
-    titan_err_t SignUpSharedArea(uint8_t index, uint16_t size_in_bytes, AccessType access_type);
-    bool IsAreaDataUpdated(uint8_t area_index);
+    titan_err_t SignUpSharedArea(uint8_t index, uint16_t size_in_bytes, AccessType access_type,
+                                 ReadMode read_mode = ReadMode::LOCKED, AreaPlacement placement = AreaPlacement::INTERNAL);
+    titan_err_t EnableDecodedCache(uint8_t area_index, const pb_msgdesc_t* msg_desc, uint16_t struct_size);
+    titan_err_t SignUpRingArea(uint8_t index, uint16_t record_size, uint16_t capacity, AccessType access_type,
+                               AreaPlacement placement = AreaPlacement::INTERNAL);
+    titan_err_t Append(uint8_t area_index, const uint8_t* data, uint16_t length);
+    uint16_t ReadSince(uint8_t area_index, uint32_t& cursor, uint8_t* buffer, uint16_t buffer_size,
+                       uint32_t* missed = nullptr);
+    titan_err_t SetPersistence(uint8_t area_index, bool persistent);
+    titan_err_t SetRetention(uint8_t area_index, bool retained);
+    bool HasRetainedState(void);
+    titan_err_t FlushPersistentAreas(void);
+    consumer_handle_t RegisterConsumer(void);
+    bool HasChangedSince(consumer_handle_t consumer, uint8_t area_index);
+    titan_err_t Subscribe(consumer_handle_t consumer, uint8_t area_index);
+    titan_err_t SubscribeAll(consumer_handle_t consumer);
+    uint32_t WaitForUpdate(TickType_t timeout);
+    titan_err_t WakeConsumer(consumer_handle_t consumer);
+    uint32_t GetGeneration(uint8_t area_index);
+    SharedMemory::ReadView Borrow(uint8_t area_index, TickType_t timeout = AreaLock::WAIT_FOREVER);
+    SharedMemory::WriteLease Lease(uint8_t area_index, TickType_t timeout = AreaLock::WAIT_FOREVER);
+    titan_err_t SetPriorityCeiling(uint8_t area_index, UBaseType_t ceiling);
+    AreaSnapshot Snapshot(std::initializer_list<uint8_t> areas);
+    AreaTransaction Transaction(std::initializer_list<uint8_t> areas);
+    titan_err_t WriteChunk(uint8_t area_index, uint16_t offset, const uint8_t* buffer, uint16_t length);
+    uint16_t ReadChunk(uint8_t area_index, uint16_t offset, uint8_t* buffer, uint16_t length);
     uint16_t GetAreaSize(uint8_t area_index);
     uint16_t GetWrittenBytes(uint8_t area_index);
+    AreaKind GetAreaKind(uint8_t area_index);
     uint16_t GetNumAreas(void);
+    uint32_t GetArenaUsage(void);
+    uint32_t GetExternalUsage(void);
+    AreaPlacement GetAreaPlacement(uint8_t area_index);
+    void PrintMemoryMap(void);
+    titan_err_t GetAreaCounters(uint8_t area_index, AreaCounters& counters);
+    titan_err_t EnableDiagnostics(uint32_t period_ms);
+    titan_err_t PublishDiagnostics(void);
+    void DumpAreaCounters(void);
+    titan_err_t SetWriteHook(write_hook_t hook, void* context);
 
    private:
     SharedMemoryManager() {};
     static SharedMemoryManager* singleton_pointer_;
+    void NotifySubscribers(uint8_t area_index);
+    void OnAreaWritten(uint8_t area_index);
+    static void OnLeaseCommitted(void* context, uint8_t area_index);
+    static void OnFlushTimer(TimerHandle_t timer);
+    static void HousekeepingTask(void* parameters);
+    titan_err_t StartHousekeeping(void);
+    static void OnDiagnosticsTimer(TimerHandle_t timer);
+    titan_err_t OpenStorage(void);
+    void RestoreArea(uint8_t area_index);
+    void ValidateRetainedMemory(void);
+    bool IsRetainedSlotValid(uint8_t area_index, uint16_t capacity);
+    void MirrorRetainedArea(uint8_t area_index);
+    static uint32_t RetainedChecksum(uint8_t area_index);
+
+    /**
+     * @brief Restores a persistent area from NVS the first time it is accessed.
+     *
+     * @param[in] area_index Index of the area, must be a valid index.
+     */
+    void RestoreIfPending(uint8_t area_index) {
+        if ((this->_pending_restore.load(std::memory_order_relaxed) & (1UL << area_index)) != 0) {
+            this->RestoreArea(area_index);
+        }
+    }
+
+    /**
+     * @brief Restores the pending areas of a set before any of them is locked.
+     *
+     * A restore leases its area and takes the persistence mutex, doing it in
+     * the middle of a snapshot or a transaction would break the locking order.
+     *
+     * @param[in] areas Indexes of the areas.
+     * @param[in] count Amount of areas.
+     */
+    void RestorePendingAreas(const uint8_t* areas, uint8_t count) {
+        for (uint8_t i = 0; i < count; i++) {
+            if ((areas[i] < this->_maximum_shared_memory) && (this->_shared_memory_array[areas[i]] != nullptr)) {
+                this->RestoreIfPending(areas[i]);
+            }
+        }
+    }
+    uint8_t* CarveArena(uint8_t index, uint16_t size_in_bytes);
+    uint8_t* AllocateExternal(uint8_t index, uint16_t size_in_bytes);
+
+    /**
+     * @brief Validates a registered area at compile time and returns its object.
+     * @return Pointer to the area, nullptr if the area was not signed up yet.
+     */
+    template <memory_areas_t area>
+    SharedMemory* GetArea(void) {
+        static_assert(AreaRegistry::Area<area>::descriptor.index < SharedMemoryManager::_maximum_shared_memory,
+                      "Memory area index exceeds the maximum number of shared memory areas");
+        static_assert(!MemoryArena::Holds(AreaRegistry::Area<area>::descriptor) ||
+                          (AreaRegistry::Area<area>::descriptor.size <= MemoryArena::SIZE),
+                      "Memory area does not fit in the shared memory arena");
+
+        return this->_shared_memory_array[area];
+    }
 
    private:
+    /**
+     * @brief Location and checksum of a retained area inside the RTC block.
+     */
+    struct RetainedSlot {
+        uint16_t offset;        /**< Start of the area copy in RetainedMemory::data. */
+        uint16_t capacity;      /**< Size of the area when the slot was carved, 0 if the slot is free. */
+        uint16_t written_bytes; /**< Valid bytes of the copy. */
+        uint16_t reserved;      /**< Keeps the checksum on a word. */
+        uint32_t crc;           /**< CRC32 of the fields above and the valid bytes of the copy. */
+    };
+
     static constexpr uint16_t _maximum_shared_memory = 32;
+
+    /**
+     * @brief Retained areas, kept in RTC slow memory across deep sleep.
+     *
+     * The block is not initialized by the startup code, after a power on or a
+     * crash it holds garbage: the magic and every slot checksum are checked
+     * before any byte is trusted.
+     */
+    struct RetainedMemory {
+        uint32_t magic;                                                  /**< Retention::MAGIC once the block is laid out. */
+        uint32_t size;                                                   /**< Retention::SIZE of the firmware that laid it out. */
+        uint32_t used;                                                   /**< Bytes of data carved out so far. */
+        RetainedSlot slots[SharedMemoryManager::_maximum_shared_memory]; /**< One slot per area index. */
+        alignas(Retention::ALIGNMENT) uint8_t data[Retention::SIZE];     /**< Copies of the retained areas. */
+    };
+
+
+    static constexpr uint8_t _maximum_consumers      = 16;
     uint16_t _num_areas                              = 0;
-    std::unique_ptr<SharedMemory> _shared_memory_array[SharedMemoryManager::_maximum_shared_memory];
+    uint32_t _arena_used                             = 0;
+    uint32_t _external_used                          = 0;
+    bool _has_psram                                  = false; /**< True if the heap has PSRAM, checked once by Initialize. */
+    std::atomic<uint8_t> _num_consumers{0};
+    SharedMemory* _shared_memory_array[SharedMemoryManager::_maximum_shared_memory] = {};
+    uint32_t _area_offset[SharedMemoryManager::_maximum_shared_memory]              = {};
+    uint8_t* _external_data[SharedMemoryManager::_maximum_shared_memory]            = {}; /**< PSRAM block of each area, nullptr if in the arena. */
+    uint32_t _consumer_generation[SharedMemoryManager::_maximum_consumers][SharedMemoryManager::_maximum_shared_memory] = {};
+    TaskHandle_t _consumer_task[SharedMemoryManager::_maximum_consumers]                                                  = {};
+    std::atomic<uint32_t> _consumer_subscriptions[SharedMemoryManager::_maximum_consumers]                               = {};
+    std::atomic<uint32_t> _persistent_areas{0};   /**< Areas mirrored to NVS, one bit per area. */
+    std::atomic<uint32_t> _dirty_areas{0};        /**< Persistent areas written since the last flush. */
+    std::atomic<uint32_t> _pending_restore{0};    /**< Persistent areas not restored from NVS yet. */
+    std::atomic<uint32_t> _retained_areas{0};     /**< Areas mirrored to RTC memory, one bit per area. */
+    std::atomic<uint32_t> _restored_areas{0};     /**< Retained areas restored from RTC memory since Initialize. */
+    bool _retained_state = false;                   /**< True if RTC memory held a valid area at Initialize. */
+    SemaphoreHandle_t _persistence_mutex = nullptr; /**< Serializes the NVS accesses, no area is locked while it is held. */
+    StaticSemaphore_t _persistence_mutex_buffer;    /**< Storage of the persistence mutex. */
+    SemaphoreHandle_t _flush_mutex = nullptr;       /**< Serializes the flushes, guards the persistence buffer. */
+    StaticSemaphore_t _flush_mutex_buffer;          /**< Storage of the flush mutex. */
+    TimerHandle_t _flush_timer = nullptr;           /**< One-shot timer waking the persistence task. */
+    TaskHandle_t _housekeeping_task = nullptr;      /**< Flushes the dirty areas and publishes the diagnostics, created on first use. */
+    StaticTimer_t _flush_timer_buffer;              /**< Storage of the flush timer. */
+    nvs_handle_t _nvs_handle = 0;                   /**< Handle of the persistence namespace. */
+    bool _nvs_opened         = false;               /**< True once the persistence namespace is open. */
+    TimerHandle_t _diagnostics_timer = nullptr;     /**< Periodic timer publishing the area counters. */
+    StaticTimer_t _diagnostics_timer_buffer;        /**< Storage of the diagnostics timer. */
+    write_hook_t _write_hook   = nullptr;           /**< Called after every completed write, used by the message bus. */
+    void* _write_hook_context  = nullptr;           /**< Context passed to the write hook. */
+
+    /** @brief Storage of the area objects, constructed in place by SignUpSharedArea. */
+    alignas(SharedMemory) static uint8_t _area_storage[SharedMemoryManager::_maximum_shared_memory][sizeof(SharedMemory)];
+    /** @brief Data of every area, carved out in cache line aligned blocks. */
+    alignas(MemoryArena::ALIGNMENT) static uint8_t _arena[MemoryArena::SIZE];
+    /** @brief Copy of an area being flushed, keeps the area unlocked during the flash write, guarded by the flush mutex. */
+    static uint8_t _persistence_buffer[Persistence::MAXIMUM_AREA_SIZE];
+    /** @brief Counters being published, only accessed with the diagnostics area leased. */
+    static area_diagnostics_t _diagnostics;
+    /** @brief Copies of the retained areas, survives deep sleep but not a power on. */
+    static RetainedMemory _retained;
 
    public:
     /**
@@ -39,17 +314,20 @@ class SharedMemoryManager {
      * @param[in] area_index The index of the memory area to write to.
      * @param[in] size The size of the data to write.
      * @param[in] protobuf A pointer to the data to write.
+     * @param[in] timeout Maximum amount of ticks to wait for the area mutex.
      *
      * @returns An titan_err_t indicating the result of the write operation.
      *          - ESP_OK if the write operation was successful.
+     *          - Error::LOCK_TIMEOUT if the area stayed locked past the timeout.
      *          - Error::UNKNOW_FAIL if an error occurred during the write operation.
      */
     template <typename T>
-    titan_err_t Write(uint8_t area_index, T& protobuf, const pb_msgdesc_t& msg_desc) {
+    titan_err_t Write(uint8_t area_index, T& protobuf, const pb_msgdesc_t& msg_desc,
+                      TickType_t timeout = AreaLock::WAIT_FOREVER) {
         titan_err_t result = Error::UNKNOW_FAIL;
 
         do {
-            if (area_index > this->_maximum_shared_memory) {
+            if (area_index >= this->_maximum_shared_memory) {
                 result = Error::INVALID_MEMORY_AREA;
                 break;
             }
@@ -59,18 +337,23 @@ class SharedMemoryManager {
                 break;
             }
 
-            result = this->_shared_memory_array[area_index]->Write(protobuf, msg_desc);
+            result = this->_shared_memory_array[area_index]->Write(protobuf, msg_desc, timeout);
+
+            if (result == Error::NO_ERROR) {
+                this->OnAreaWritten(area_index);
+            }
 
         } while (0);
 
         return result;
     }
 
-    titan_err_t Write(uint8_t area_index, char* buffer, uint16_t written_bytes) {
+    titan_err_t Write(uint8_t area_index, char* buffer, uint16_t written_bytes,
+                      TickType_t timeout = AreaLock::WAIT_FOREVER) {
         titan_err_t result = Error::UNKNOW_FAIL;
 
         do {
-            if (area_index > this->_maximum_shared_memory) {
+            if (area_index >= this->_maximum_shared_memory) {
                 result = Error::INVALID_MEMORY_AREA;
                 break;
             }
@@ -88,7 +371,11 @@ class SharedMemoryManager {
                 break;
             }
 
-            result = this->_shared_memory_array[area_index]->Write(buffer, written_bytes);
+            result = this->_shared_memory_array[area_index]->Write(buffer, written_bytes, timeout);
+
+            if (result == Error::NO_ERROR) {
+                this->OnAreaWritten(area_index);
+            }
 
         } while (0);
 
@@ -96,11 +383,12 @@ class SharedMemoryManager {
     }
     
     template <typename T>
-    uint16_t Read(uint8_t area_index, T& protobuf, const pb_msgdesc_t& msg_desc, bool silent = false) {
+    uint16_t Read(uint8_t area_index, T& protobuf, const pb_msgdesc_t& msg_desc,
+                  TickType_t timeout = AreaLock::WAIT_FOREVER) {
         uint16_t result = 0;
 
         do {
-            if (area_index > this->_maximum_shared_memory) {
+            if (area_index >= this->_maximum_shared_memory) {
                 break;
             }
 
@@ -108,7 +396,9 @@ class SharedMemoryManager {
                 break;
             }
 
-            if (this->_shared_memory_array[area_index]->Read(protobuf, msg_desc, silent) != Error::NO_ERROR) {
+            this->RestoreIfPending(area_index);
+
+            if (this->_shared_memory_array[area_index]->Read(protobuf, msg_desc, timeout) != Error::NO_ERROR) {
                 break;
             }
 
@@ -119,11 +409,11 @@ class SharedMemoryManager {
         return result;
     }
     
-    uint16_t Read(uint8_t area_index, char* buffer, uint16_t buffer_size, bool silent = false) {
+    uint16_t Read(uint8_t area_index, char* buffer, uint16_t buffer_size, TickType_t timeout = AreaLock::WAIT_FOREVER) {
         uint16_t result = 0;
 
         do {
-            if (area_index > this->_maximum_shared_memory) {
+            if (area_index >= this->_maximum_shared_memory) {
                 break;
             }
 
@@ -137,7 +427,9 @@ class SharedMemoryManager {
                 break;
             }
 
-            if (this->_shared_memory_array[area_index]->Read(buffer, silent) != Error::NO_ERROR) {
+            this->RestoreIfPending(area_index);
+
+            if (this->_shared_memory_array[area_index]->Read(buffer, timeout) != Error::NO_ERROR) {
                 break;
             }
 
@@ -147,6 +439,143 @@ class SharedMemoryManager {
 
         return result;
     }
+
+    /**
+     * Signs up a memory area with the size, access type, read mode and placement from the area registry,
+     * attaching a decoded struct cache and mirroring it to RTC memory and NVS when the registry asks for it.
+     * Retention is set up first, so an area restored from RTC memory is not read back from NVS.
+     *
+     * @tparam area The memory area to sign up.
+     *
+     * @returns An titan_err_t indicating the result of the sign up.
+     */
+    template <memory_areas_t area>
+    titan_err_t SignUpSharedArea(void) {
+        constexpr const AreaDescriptor& descriptor = AreaRegistry::Area<area>::descriptor;
+        static_assert(descriptor.index < SharedMemoryManager::_maximum_shared_memory,
+                      "Memory area index exceeds the maximum number of shared memory areas");
+        static_assert((!descriptor.persistent) || (descriptor.size <= Persistence::MAXIMUM_AREA_SIZE),
+                      "Persistent memory area exceeds the persistence buffer");
+        static_assert((!descriptor.retained) || (descriptor.size <= Retention::SIZE),
+                      "Retained memory area does not fit in the retained memory");
+
+        auto result = this->SignUpSharedArea(descriptor.index, descriptor.size, descriptor.access_type, descriptor.read_mode,
+                                             descriptor.placement);
+
+        if ((result == ESP_OK) && descriptor.cached) {
+            result = this->EnableDecodedCache(descriptor.index, descriptor.msg_desc,
+                                              sizeof(typename AreaRegistry::Area<area>::type));
+        }
+
+        if ((result == ESP_OK) && descriptor.retained) {
+            result = this->SetRetention(descriptor.index, true);
+        }
+
+        if ((result == ESP_OK) && descriptor.persistent) {
+            result = this->SetPersistence(descriptor.index, true);
+        }
+
+        return result;
+    }
+
+    /**
+     * Writes a message to a registered memory area. The area index, the message type
+     * and its descriptor are checked at compile time against the area registry.
+     *
+     * @tparam area The memory area to write to.
+     * @param[in] protobuf The message to write.
+     * @param[in] timeout Maximum amount of ticks to wait for the area mutex.
+     *
+     * @returns An titan_err_t indicating the result of the write operation.
+     *          - ESP_OK if the write operation was successful.
+     *          - Error::NULL_PTR if the area was not signed up.
+     *          - Error::LOCK_TIMEOUT if the area stayed locked past the timeout.
+     */
+    template <memory_areas_t area>
+    titan_err_t Write(typename AreaRegistry::Area<area>::type& protobuf, TickType_t timeout = AreaLock::WAIT_FOREVER) {
+        static_assert(AreaRegistry::Area<area>::descriptor.access_type != READ_ONLY, "Memory area is read only");
+
+        titan_err_t result = Error::NULL_PTR;
+        auto shared_memory = this->GetArea<area>();
+
+        if (shared_memory != nullptr) {
+            result = shared_memory->Write(protobuf, *AreaRegistry::Area<area>::descriptor.msg_desc, timeout);
+        }
+
+        if (result == Error::NO_ERROR) {
+            this->OnAreaWritten(area);
+        }
+
+        return result;
+    }
+
+    /**
+     * Updates a single field of a registered memory area, without the caller
+     * reading and rewriting the whole message.
+     *
+     * @tparam area The memory area to patch.
+     * @param[in] path Path to the field, e.g. {CONTINUOS_PACKET_LIST_PACKET_CONFIGS_TAG, 0,
+     *                 PACKET_REQUEST_PACKET_INTERVAL_TAG}.
+     * @param[in] value Value to assign, of the exact type of the field. Strings are given as char arrays.
+     * @param[in] timeout Maximum amount of ticks to wait for the area mutex.
+     *
+     * @returns An titan_err_t indicating the result of the write operation.
+     *          - ESP_OK if the field was updated.
+     *          - Error::NULL_PTR if the area was not signed up.
+     *          - ESP_ERR_NOT_FOUND, ESP_ERR_INVALID_ARG or ESP_ERR_INVALID_SIZE if the path or the value is invalid.
+     *          - Error::LOCK_TIMEOUT if the area stayed locked past the timeout.
+     */
+    template <memory_areas_t area, typename F>
+    titan_err_t WriteField(FieldPath path, const F& value, TickType_t timeout = AreaLock::WAIT_FOREVER) {
+        static_assert(AreaRegistry::Area<area>::descriptor.access_type != READ_ONLY, "Memory area is read only");
+
+        titan_err_t result = Error::NULL_PTR;
+        auto shared_memory = this->GetArea<area>();
+
+        if (shared_memory != nullptr) {
+            /* The field is patched on top of the stored copy, not on an empty message. */
+            this->RestoreIfPending(area);
+
+            result = shared_memory->template WriteField<typename AreaRegistry::Area<area>::type>(
+                path, &value, sizeof(F), *AreaRegistry::Area<area>::descriptor.msg_desc, timeout);
+        }
+
+        if (result == Error::NO_ERROR) {
+            this->OnAreaWritten(area);
+        }
+
+        return result;
+    }
+
+    /**
+     * Reads a message from a registered memory area. The area index, the message type
+     * and its descriptor are checked at compile time against the area registry.
+     *
+     * @tparam area The memory area to read from.
+     * @param[out] protobuf The message to decode into.
+     * @param[in] timeout Maximum amount of ticks to wait for the area mutex.
+     *
+     * @returns The number of bytes stored in the area, 0 if the read failed or timed out.
+     */
+    template <memory_areas_t area>
+    uint16_t Read(typename AreaRegistry::Area<area>::type& protobuf, TickType_t timeout = AreaLock::WAIT_FOREVER) {
+        static_assert(AreaRegistry::Area<area>::descriptor.access_type != WRITE_ONLY, "Memory area is write only");
+
+        uint16_t result    = 0;
+        auto shared_memory = this->GetArea<area>();
+
+        if (shared_memory == nullptr) {
+            return result;
+        }
+
+        this->RestoreIfPending(area);
+
+        if (shared_memory->Read(protobuf, *AreaRegistry::Area<area>::descriptor.msg_desc, timeout) == Error::NO_ERROR) {
+            result = shared_memory->GetWrittenBytes();
+        }
+
+        return result;
+    }
 };
 
 #endif /* SHARED_MEMORY_MANAGER_H */
\ No newline at end of file
@@ -26,7 +26,8 @@ typedef enum memory_areas {
     MEMORY_AREAS_UART_CONTINUOS_PACKET = 5, /* Memory area used for communication configuration UART settings. */
     MEMORY_AREAS_LORA_SINGLE_PACKET = 6, /* Memory area for configurations of single LoRa packets. */
     MEMORY_AREAS_LORA_CONTINUOS_PACKET = 7, /* Memory area used for communication configuration LORA settings. */
-    MEMORY_AREAS_TIME_PROCESS = 8 /* Memory Area used for time process stores the time since boot. */
+    MEMORY_AREAS_TIME_PROCESS = 8, /* Memory Area used for time process stores the time since boot. */
+    MEMORY_AREAS_AREA_DIAGNOSTICS = 9 /* Memory area publishing the contention and latency counters of the areas. */
 } memory_areas_t;
 
 /* Struct definitions */
@@ -93,6 +94,41 @@ typedef struct time_process {
     uint32_t hours;
 } time_process_t;
 
+/* Contention and latency counters of a shared memory area. Counters wrap around. */
+typedef struct area_statistics {
+    /* The memory area the counters belong to. */
+    memory_areas_t area;
+    /* Amount of reads of the area. */
+    uint32_t reads;
+    /* Amount of writes of the area. */
+    uint32_t writes;
+    /* Amount of mutex acquisitions that had to wait for another task. */
+    uint32_t contended;
+    /* Shortest wait of a contended acquisition, in microseconds. */
+    uint32_t wait_min_us;
+    /* Average wait of a contended acquisition, in microseconds. */
+    uint32_t wait_avg_us;
+    /* Longest wait of a contended acquisition, in microseconds. */
+    uint32_t wait_max_us;
+    /* Average time spent encoding or decoding the area message, in microseconds. */
+    uint32_t codec_avg_us;
+    /* Longest time spent encoding or decoding the area message, in microseconds. */
+    uint32_t codec_max_us;
+    /* Amount of bytes read from the area. */
+    uint32_t bytes_read;
+    /* Amount of bytes written to the area. */
+    uint32_t bytes_written;
+    /* Name of the task that wrote the area last. */
+    char last_writer[16];
+} area_statistics_t;
+
+/* Counters of every signed up memory area. */
+typedef struct area_diagnostics {
+    /* Counters of each area, with a maximum count of 10. */
+    pb_size_t areas_count;
+    area_statistics_t areas[10];
+} area_diagnostics_t;
+
 /* Message defining the different memory areas and their corresponding structures. */
 typedef struct memory_areas_definitions {
     /* Network credentials for connecting to a Wi-Fi network. */
@@ -111,6 +147,8 @@ typedef struct memory_areas_definitions {
     continuos_packet_list_t lora_continuos_packet;
     /* Struct that stores the time since device boot. */
     time_process_t time_process;
+    /* Contention and latency counters of the memory areas, published when diagnostics are enabled. */
+    area_diagnostics_t area_diagnostics;
 } memory_areas_definitions_t;
 
 
@@ -124,8 +162,8 @@ extern "C" {
 #define _NETWORK_STATUS_ARRAYSIZE ((network_status_t)(NETWORK_STATUS_CONNECTED+1))
 
 #define _MEMORY_AREAS_MIN MEMORY_AREAS_INVALID_MEMORY_AREA
-#define _MEMORY_AREAS_MAX MEMORY_AREAS_TIME_PROCESS
-#define _MEMORY_AREAS_ARRAYSIZE ((memory_areas_t)(MEMORY_AREAS_TIME_PROCESS+1))
+#define _MEMORY_AREAS_MAX MEMORY_AREAS_AREA_DIAGNOSTICS
+#define _MEMORY_AREAS_ARRAYSIZE ((memory_areas_t)(MEMORY_AREAS_AREA_DIAGNOSTICS+1))
 
 
 #define network_information_t_ap_connected_ENUMTYPE network_status_t
@@ -137,6 +175,11 @@ extern "C" {
 
 
 
+#define area_statistics_t_area_ENUMTYPE memory_areas_t
+
+
+
+
 
 
 /* Initializer values for message structs */
@@ -146,14 +189,18 @@ extern "C" {
 #define PACKET_REQUEST_INIT_DEFAULT              {0, _MEMORY_AREAS_MIN, _MEMORY_AREAS_MIN, 0, 0}
 #define CONTINUOS_PACKET_LIST_INIT_DEFAULT       {0, {PACKET_REQUEST_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT}}
 #define TIME_PROCESS_INIT_DEFAULT                {0, 0, 0, 0}
-#define MEMORY_AREAS_DEFINITIONS_INIT_DEFAULT    {NETWORK_CREDENTIALS_INIT_DEFAULT, NETWORK_INFORMATION_INIT_DEFAULT, BROKER_CONFIG_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, CONTINUOS_PACKET_LIST_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, CONTINUOS_PACKET_LIST_INIT_DEFAULT, TIME_PROCESS_INIT_DEFAULT}
+#define AREA_STATISTICS_INIT_DEFAULT             {_MEMORY_AREAS_MIN, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ""}
+#define AREA_DIAGNOSTICS_INIT_DEFAULT            {0, {AREA_STATISTICS_INIT_DEFAULT, AREA_STATISTICS_INIT_DEFAULT, AREA_STATISTICS_INIT_DEFAULT, AREA_STATISTICS_INIT_DEFAULT, AREA_STATISTICS_INIT_DEFAULT, AREA_STATISTICS_INIT_DEFAULT, AREA_STATISTICS_INIT_DEFAULT, AREA_STATISTICS_INIT_DEFAULT, AREA_STATISTICS_INIT_DEFAULT, AREA_STATISTICS_INIT_DEFAULT}}
+#define MEMORY_AREAS_DEFINITIONS_INIT_DEFAULT    {NETWORK_CREDENTIALS_INIT_DEFAULT, NETWORK_INFORMATION_INIT_DEFAULT, BROKER_CONFIG_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, CONTINUOS_PACKET_LIST_INIT_DEFAULT, PACKET_REQUEST_INIT_DEFAULT, CONTINUOS_PACKET_LIST_INIT_DEFAULT, TIME_PROCESS_INIT_DEFAULT, AREA_DIAGNOSTICS_INIT_DEFAULT}
 #define NETWORK_CREDENTIALS_INIT_ZERO            {"", ""}
 #define NETWORK_INFORMATION_INIT_ZERO            {_NETWORK_STATUS_MIN, _NETWORK_STATUS_MIN}
 #define BROKER_CONFIG_INIT_ZERO                  {""}
 #define PACKET_REQUEST_INIT_ZERO                 {0, _MEMORY_AREAS_MIN, _MEMORY_AREAS_MIN, 0, 0}
 #define CONTINUOS_PACKET_LIST_INIT_ZERO          {0, {PACKET_REQUEST_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, PACKET_REQUEST_INIT_ZERO}}
 #define TIME_PROCESS_INIT_ZERO                   {0, 0, 0, 0}
-#define MEMORY_AREAS_DEFINITIONS_INIT_ZERO       {NETWORK_CREDENTIALS_INIT_ZERO, NETWORK_INFORMATION_INIT_ZERO, BROKER_CONFIG_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, CONTINUOS_PACKET_LIST_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, CONTINUOS_PACKET_LIST_INIT_ZERO, TIME_PROCESS_INIT_ZERO}
+#define AREA_STATISTICS_INIT_ZERO                {_MEMORY_AREAS_MIN, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ""}
+#define AREA_DIAGNOSTICS_INIT_ZERO               {0, {AREA_STATISTICS_INIT_ZERO, AREA_STATISTICS_INIT_ZERO, AREA_STATISTICS_INIT_ZERO, AREA_STATISTICS_INIT_ZERO, AREA_STATISTICS_INIT_ZERO, AREA_STATISTICS_INIT_ZERO, AREA_STATISTICS_INIT_ZERO, AREA_STATISTICS_INIT_ZERO, AREA_STATISTICS_INIT_ZERO, AREA_STATISTICS_INIT_ZERO}}
+#define MEMORY_AREAS_DEFINITIONS_INIT_ZERO       {NETWORK_CREDENTIALS_INIT_ZERO, NETWORK_INFORMATION_INIT_ZERO, BROKER_CONFIG_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, CONTINUOS_PACKET_LIST_INIT_ZERO, PACKET_REQUEST_INIT_ZERO, CONTINUOS_PACKET_LIST_INIT_ZERO, TIME_PROCESS_INIT_ZERO, AREA_DIAGNOSTICS_INIT_ZERO}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define NETWORK_CREDENTIALS_SSID_TAG             1
@@ -171,6 +218,19 @@ extern "C" {
 #define TIME_PROCESS_SECONDS_TAG                 2
 #define TIME_PROCESS_MINUTES_TAG                 3
 #define TIME_PROCESS_HOURS_TAG                   4
+#define AREA_STATISTICS_AREA_TAG                 1
+#define AREA_STATISTICS_READS_TAG                2
+#define AREA_STATISTICS_WRITES_TAG               3
+#define AREA_STATISTICS_CONTENDED_TAG            4
+#define AREA_STATISTICS_WAIT_MIN_US_TAG          5
+#define AREA_STATISTICS_WAIT_AVG_US_TAG          6
+#define AREA_STATISTICS_WAIT_MAX_US_TAG          7
+#define AREA_STATISTICS_CODEC_AVG_US_TAG         8
+#define AREA_STATISTICS_CODEC_MAX_US_TAG         9
+#define AREA_STATISTICS_BYTES_READ_TAG           10
+#define AREA_STATISTICS_BYTES_WRITTEN_TAG        11
+#define AREA_STATISTICS_LAST_WRITER_TAG          12
+#define AREA_DIAGNOSTICS_AREAS_TAG               1
 #define MEMORY_AREAS_DEFINITIONS_NETWORK_CREDENTIALS_TAG 1
 #define MEMORY_AREAS_DEFINITIONS_NETWORK_INFORMATION_TAG 2
 #define MEMORY_AREAS_DEFINITIONS_BROKER_CONFIG_TAG 3
@@ -179,6 +239,7 @@ extern "C" {
 #define MEMORY_AREAS_DEFINITIONS_LORA_PACKET_REQUEST_TAG 6
 #define MEMORY_AREAS_DEFINITIONS_LORA_CONTINUOS_PACKET_TAG 7
 #define MEMORY_AREAS_DEFINITIONS_TIME_PROCESS_TAG 8
+#define MEMORY_AREAS_DEFINITIONS_AREA_DIAGNOSTICS_TAG 9
 
 /* Struct field encoding specification for nanopb */
 #define NETWORK_CREDENTIALS_FIELDLIST(X, a) \
@@ -221,6 +282,28 @@ X(a, STATIC,   REQUIRED, UINT32,   hours,             4)
 #define TIME_PROCESS_CALLBACK NULL
 #define TIME_PROCESS_DEFAULT NULL
 
+#define AREA_STATISTICS_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UENUM,    area,              1) \
+X(a, STATIC,   REQUIRED, UINT32,   reads,             2) \
+X(a, STATIC,   REQUIRED, UINT32,   writes,            3) \
+X(a, STATIC,   REQUIRED, UINT32,   contended,         4) \
+X(a, STATIC,   REQUIRED, UINT32,   wait_min_us,       5) \
+X(a, STATIC,   REQUIRED, UINT32,   wait_avg_us,       6) \
+X(a, STATIC,   REQUIRED, UINT32,   wait_max_us,       7) \
+X(a, STATIC,   REQUIRED, UINT32,   codec_avg_us,      8) \
+X(a, STATIC,   REQUIRED, UINT32,   codec_max_us,      9) \
+X(a, STATIC,   REQUIRED, UINT32,   bytes_read,       10) \
+X(a, STATIC,   REQUIRED, UINT32,   bytes_written,    11) \
+X(a, STATIC,   REQUIRED, STRING,   last_writer,      12)
+#define AREA_STATISTICS_CALLBACK NULL
+#define AREA_STATISTICS_DEFAULT NULL
+
+#define AREA_DIAGNOSTICS_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, MESSAGE,  areas,             1)
+#define AREA_DIAGNOSTICS_CALLBACK NULL
+#define AREA_DIAGNOSTICS_DEFAULT NULL
+#define area_diagnostics_t_areas_MSGTYPE area_statistics_t
+
 #define MEMORY_AREAS_DEFINITIONS_FIELDLIST(X, a) \
 X(a, STATIC,   REQUIRED, MESSAGE,  network_credentials,   1) \
 X(a, STATIC,   REQUIRED, MESSAGE,  network_information,   2) \
@@ -229,7 +312,8 @@ X(a, STATIC,   REQUIRED, MESSAGE,  uart_packet_request,   4) \
 X(a, STATIC,   REQUIRED, MESSAGE,  uart_continuos_packet,   5) \
 X(a, STATIC,   REQUIRED, MESSAGE,  lora_packet_request,   6) \
 X(a, STATIC,   REQUIRED, MESSAGE,  lora_continuos_packet,   7) \
-X(a, STATIC,   REQUIRED, MESSAGE,  time_process,      8)
+X(a, STATIC,   REQUIRED, MESSAGE,  time_process,      8) \
+X(a, STATIC,   REQUIRED, MESSAGE,  area_diagnostics,   9)
 #define MEMORY_AREAS_DEFINITIONS_CALLBACK NULL
 #define MEMORY_AREAS_DEFINITIONS_DEFAULT NULL
 #define memory_areas_definitions_t_network_credentials_MSGTYPE network_credentials_t
@@ -240,6 +324,7 @@ X(a, STATIC,   REQUIRED, MESSAGE,  time_process,      8)
 #define memory_areas_definitions_t_lora_packet_request_MSGTYPE packet_request_t
 #define memory_areas_definitions_t_lora_continuos_packet_MSGTYPE continuos_packet_list_t
 #define memory_areas_definitions_t_time_process_MSGTYPE time_process_t
+#define memory_areas_definitions_t_area_diagnostics_MSGTYPE area_diagnostics_t
 
 extern const pb_msgdesc_t network_credentials_t_msg;
 extern const pb_msgdesc_t network_information_t_msg;
@@ -247,6 +332,8 @@ extern const pb_msgdesc_t broker_config_t_msg;
 extern const pb_msgdesc_t packet_request_t_msg;
 extern const pb_msgdesc_t continuos_packet_list_t_msg;
 extern const pb_msgdesc_t time_process_t_msg;
+extern const pb_msgdesc_t area_statistics_t_msg;
+extern const pb_msgdesc_t area_diagnostics_t_msg;
 extern const pb_msgdesc_t memory_areas_definitions_t_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
@@ -256,12 +343,16 @@ extern const pb_msgdesc_t memory_areas_definitions_t_msg;
 #define PACKET_REQUEST_FIELDS &packet_request_t_msg
 #define CONTINUOS_PACKET_LIST_FIELDS &continuos_packet_list_t_msg
 #define TIME_PROCESS_FIELDS &time_process_t_msg
+#define AREA_STATISTICS_FIELDS &area_statistics_t_msg
+#define AREA_DIAGNOSTICS_FIELDS &area_diagnostics_t_msg
 #define MEMORY_AREAS_DEFINITIONS_FIELDS &memory_areas_definitions_t_msg
 
 /* Maximum encoded size of messages (where known) */
+#define AREA_DIAGNOSTICS_SIZE                    810
+#define AREA_STATISTICS_SIZE                     79
 #define BROKER_CONFIG_SIZE                       258
 #define CONTINUOS_PACKET_LIST_SIZE               272
-#define MEMORY_AREAS_DEFINITIONS_SIZE            1016
+#define MEMORY_AREAS_DEFINITIONS_SIZE            1829
 #define NETWORK_CREDENTIALS_SIZE                 98
 #define NETWORK_INFORMATION_SIZE                 4
 #define PACKET_REQUEST_SIZE                      32
@@ -24,4 +24,10 @@ PB_BIND(CONTINUOS_PACKET_LIST, continuos_packet_list_t, AUTO)
 PB_BIND(TIME_PROCESS, time_process_t, AUTO)
 
 
+PB_BIND(AREA_STATISTICS, area_statistics_t, AUTO)
+
+
+PB_BIND(AREA_DIAGNOSTICS, area_diagnostics_t, AUTO)
+
+
 PB_BIND(MEMORY_AREAS_DEFINITIONS, memory_areas_definitions_t, 2)
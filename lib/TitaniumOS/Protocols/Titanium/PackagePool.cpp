@@ -0,0 +1,146 @@
+#include "PackagePool.h"
+#include "TitaniumPackage.h"
+
+#include <new>
+
+static_assert(sizeof(TitaniumPackage) <= Pool::PACKAGE_SIZE, "Pool::PACKAGE_SIZE is too small for TitaniumPackage");
+
+#if TITANIUM_POOL_PACKAGES > 0
+alignas(alignof(max_align_t)) static uint8_t package_slab[Pool::PACKAGES][Pool::PACKAGE_SIZE];
+static std::atomic<bool> package_used[Pool::PACKAGES]; /**< True for each package slot taken. */
+#endif
+
+#if TITANIUM_POOL_PAYLOADS > 0
+alignas(4) static uint8_t payload_slab[Pool::PAYLOADS][Pool::PAYLOAD_SIZE];
+static std::atomic<bool> payload_used[Pool::PAYLOADS]; /**< True for each payload block taken. */
+#endif
+
+std::atomic<uint32_t> PackagePool::_package_exhausted{0};
+std::atomic<uint32_t> PackagePool::_payload_exhausted{0};
+
+/**
+ * @brief Provides the storage of a TitaniumPackage, see TitaniumPackage::operator new.
+ *
+ * @param[in] size Size requested by the allocation.
+ * @return void* Storage for the package, from the heap if no slot fits.
+ */
+void* PackagePool::AcquirePackage(size_t size) {
+#if TITANIUM_POOL_PACKAGES > 0
+    if (size <= Pool::PACKAGE_SIZE) {
+        auto slot = PackagePool::AcquireSlot(package_used, Pool::PACKAGES);
+        if (slot >= 0) {
+            return package_slab[slot];
+        }
+    }
+
+    PackagePool::_package_exhausted.fetch_add(1, std::memory_order_relaxed);
+#endif
+    return ::operator new(size);
+}
+
+/**
+ * @brief Gives back the storage of a TitaniumPackage, see TitaniumPackage::operator delete.
+ *
+ * @param[in] package Storage returned by AcquirePackage.
+ */
+void PackagePool::ReleasePackage(void* package) {
+#if TITANIUM_POOL_PACKAGES > 0
+    auto address = static_cast<uint8_t*>(package);
+
+    if ((address >= &package_slab[0][0]) && (address < &package_slab[0][0] + sizeof(package_slab))) {
+        package_used[(address - &package_slab[0][0]) / Pool::PACKAGE_SIZE].store(false, std::memory_order_release);
+        return;
+    }
+#endif
+
+    ::operator delete(package);
+}
+
+/**
+ * @brief Provides the buffer holding the payload of a package.
+ *
+ * @param[in] size Size of the payload.
+ * @return uint8_t* Buffer of at least size bytes, from the heap if no block fits.
+ */
+uint8_t* PackagePool::AcquirePayload(uint16_t size) {
+#if TITANIUM_POOL_PAYLOADS > 0
+    if (size <= Pool::PAYLOAD_SIZE) {
+        auto block = PackagePool::AcquireSlot(payload_used, Pool::PAYLOADS);
+        if (block >= 0) {
+            return payload_slab[block];
+        }
+    }
+
+    PackagePool::_payload_exhausted.fetch_add(1, std::memory_order_relaxed);
+#endif
+    return new uint8_t[size];
+}
+
+/**
+ * @brief Gives back the buffer of a payload.
+ *
+ * @param[in] payload Buffer returned by AcquirePayload, nullptr is ignored.
+ */
+void PackagePool::ReleasePayload(uint8_t* payload) {
+    if (payload == nullptr) {
+        return;
+    }
+
+#if TITANIUM_POOL_PAYLOADS > 0
+    if ((payload >= &payload_slab[0][0]) && (payload < &payload_slab[0][0] + sizeof(payload_slab))) {
+        payload_used[(payload - &payload_slab[0][0]) / Pool::PAYLOAD_SIZE].store(false, std::memory_order_release);
+        return;
+    }
+#endif
+
+    delete[] payload;
+}
+
+/**
+ * @brief Retrieves the occupancy and the exhaustion counters of the pool.
+ *
+ * @return PackagePoolStatistics Snapshot of the counters.
+ */
+PackagePoolStatistics PackagePool::GetStatistics(void) {
+    PackagePoolStatistics statistics;
+
+#if TITANIUM_POOL_PACKAGES > 0
+    statistics.packages_in_use = PackagePool::CountUsed(package_used, Pool::PACKAGES);
+#endif
+#if TITANIUM_POOL_PAYLOADS > 0
+    statistics.payloads_in_use = PackagePool::CountUsed(payload_used, Pool::PAYLOADS);
+#endif
+    statistics.package_exhausted = PackagePool::_package_exhausted.load(std::memory_order_relaxed);
+    statistics.payload_exhausted = PackagePool::_payload_exhausted.load(std::memory_order_relaxed);
+
+    return statistics;
+}
+
+/**
+ * @brief Takes the first free slot of a slab.
+ *
+ * @return int16_t Index of the slot, -1 if every slot is taken.
+ */
+int16_t PackagePool::AcquireSlot(std::atomic<bool>* used, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        bool free = false;
+        if (used[i].compare_exchange_strong(free, true, std::memory_order_acquire)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Counts the slots of a slab currently taken.
+ */
+uint8_t PackagePool::CountUsed(const std::atomic<bool>* used, uint8_t count) {
+    uint8_t in_use = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        in_use += used[i].load(std::memory_order_relaxed) ? 1 : 0;
+    }
+
+    return in_use;
+}
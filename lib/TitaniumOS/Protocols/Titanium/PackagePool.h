@@ -0,0 +1,65 @@
+#ifndef PACKAGE_POOL_H
+#define PACKAGE_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "ProtocolLayout.h"
+
+#ifndef TITANIUM_POOL_PACKAGES
+#define TITANIUM_POOL_PACKAGES 0 /**< Set with a build flag to serve packages from a static slab, 0 uses the heap. */
+#endif
+
+#ifndef TITANIUM_POOL_PAYLOADS
+#define TITANIUM_POOL_PAYLOADS 0 /**< Set with a build flag to serve payloads from a static slab, each block costs Pool::PAYLOAD_SIZE bytes of RAM. */
+#endif
+
+namespace Pool {
+    constexpr uint8_t PACKAGES      = TITANIUM_POOL_PACKAGES;         /**< TitaniumPackage objects served by the pool. */
+    constexpr uint8_t PAYLOADS      = TITANIUM_POOL_PAYLOADS;         /**< Payload blocks served by the pool. */
+    constexpr uint16_t PAYLOAD_SIZE = Protocol::MAXIMUM_MESSAGE_SIZE; /**< Size of a payload block, any valid payload fits. */
+    constexpr size_t PACKAGE_SIZE   = 32;                             /**< Size of a package slot, checked against TitaniumPackage. */
+}  // namespace Pool
+
+/**
+ * @brief Counters of the package pool.
+ */
+struct PackagePoolStatistics {
+    uint8_t packages_in_use    = 0; /**< Package slots currently taken. */
+    uint8_t payloads_in_use    = 0; /**< Payload blocks currently taken. */
+    uint32_t package_exhausted = 0; /**< Packages allocated from the heap because every slot was taken. */
+    uint32_t payload_exhausted = 0; /**< Payloads allocated from the heap because every block was taken or was too small. */
+};
+
+/**
+ * @brief Fixed storage for TitaniumPackage objects and their payloads.
+ *
+ * Packages and payloads are served from static slabs, so creating and
+ * destroying packages in long running tasks does not fragment the heap.
+ * When the slab is exhausted the heap is used instead and the exhaustion is
+ * counted, a non zero counter means the pool is undersized for the firmware.
+ * Acquire and release are lock free, any task may use them.
+ *
+ * The firmware hands frames around as views and no longer creates packages,
+ * so the slabs are empty unless TITANIUM_POOL_PACKAGES or
+ * TITANIUM_POOL_PAYLOADS are set, and every package then lives on the heap.
+ */
+class PackagePool {
+   public:
+    static void* AcquirePackage(size_t size);
+    static void ReleasePackage(void* package);
+    static uint8_t* AcquirePayload(uint16_t size);
+    static void ReleasePayload(uint8_t* payload);
+    static PackagePoolStatistics GetStatistics(void);
+
+   private:
+    static int16_t AcquireSlot(std::atomic<bool>* used, uint8_t count);
+    static uint8_t CountUsed(const std::atomic<bool>* used, uint8_t count);
+
+   private:
+    static std::atomic<uint32_t> _package_exhausted; /**< See PackagePoolStatistics. */
+    static std::atomic<uint32_t> _payload_exhausted; /**< See PackagePoolStatistics. */
+};
+
+#endif /* PACKAGE_POOL_H */
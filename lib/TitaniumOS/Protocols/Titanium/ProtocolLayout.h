@@ -0,0 +1,40 @@
+#ifndef PROTOCOL_LAYOUT_H
+#define PROTOCOL_LAYOUT_H
+
+#include <stdint.h>
+
+/**
+ * Layout of a Titanium frame: start byte, UUID, payload length, memory area
+ * and address, then the payload, the CRC32 of everything before it and the
+ * end byte. Multi-byte fields are little endian.
+ */
+namespace ProtocolAttributes {
+    constexpr uint8_t START_BYTE_OFFSET     = 0;
+    constexpr uint8_t START_BYTE_SIZE       = 1;
+    constexpr uint8_t UUID_OFFSET           = START_BYTE_OFFSET + START_BYTE_SIZE;
+    constexpr uint8_t UUID_SIZE             = 4;
+    constexpr uint8_t PAYLOAD_LENGTH_OFFSET = UUID_OFFSET + UUID_SIZE;
+    constexpr uint8_t PAYLOAD_LENGTH_SIZE   = 2;
+    constexpr uint8_t MEMORY_AREA_OFFSET    = PAYLOAD_LENGTH_OFFSET + PAYLOAD_LENGTH_SIZE;
+    constexpr uint8_t MEMORY_AREA_SIZE      = 1;
+    constexpr uint8_t ADDRESS_OFFSET        = MEMORY_AREA_OFFSET + MEMORY_AREA_SIZE;
+    constexpr uint8_t ADDRESS_SIZE          = 2;
+    constexpr uint8_t HEADER_OFFSET         = ADDRESS_OFFSET + ADDRESS_SIZE;
+    constexpr uint8_t CRC_SIZE              = 4;
+    constexpr uint8_t STATIC_MESSAGE_SIZE   = HEADER_OFFSET + CRC_SIZE;
+    constexpr uint8_t END_BYTE_SIZE         = 1;
+    constexpr uint8_t FRAME_OVERHEAD        = STATIC_MESSAGE_SIZE + END_BYTE_SIZE; /**< Bytes of a frame around its payload. */
+
+}  // namespace ProtocolAttributes
+
+namespace Protocol {
+    constexpr uint8_t START_BYTE            = 2;    /**< Start byte of the message. */
+    constexpr uint8_t END_BYTE              = 3;    /**< End byte of the message. */
+    constexpr uint16_t MAXIMUM_MESSAGE_SIZE = 1024; /**< Maximum size of a message. */
+    constexpr uint16_t MAXIMUM_FRAME_SIZE   = MAXIMUM_MESSAGE_SIZE + ProtocolAttributes::FRAME_OVERHEAD; /**< Maximum size of a whole frame. */
+    constexpr uint16_t DELTA_FLAG           = 0x8000; /**< Payload length bit marking a delta frame, rejected as oversized by older decoders. */
+    constexpr uint16_t PAYLOAD_LENGTH_MASK  = 0x7FFF; /**< Payload length bits left once the frame flags are removed. */
+
+}  // namespace Protocol
+
+#endif /* PROTOCOL_LAYOUT_H */
@@ -0,0 +1,134 @@
+#include "TitaniumFrameParser.h"
+
+#include <string.h>
+
+/**
+ * @brief Appends received bytes and emits every frame they complete.
+ *
+ * @param[in] data Bytes received, in arrival order.
+ * @param[in] size Amount of bytes received.
+ * @param[in] on_frame Called once per complete frame, in arrival order.
+ * @param[in] context Context passed to the callback.
+ * @return uint16_t Amount of frames emitted.
+ */
+uint16_t TitaniumFrameParser::Feed(const uint8_t* data, uint16_t size, frame_callback_t on_frame, void* context) {
+    uint16_t frames = 0;
+
+    if ((data == nullptr) || (on_frame == nullptr)) {
+        return frames;
+    }
+
+    /* Whatever Drain leaves is shorter than a frame, so every pass makes room. */
+    while (size > 0) {
+        uint16_t space = sizeof(this->_buffer) - this->_length;
+        uint16_t chunk = (size < space) ? size : space;
+
+        memcpy(this->_buffer + this->_length, data, chunk);
+        this->_length += chunk;
+        data += chunk;
+        size -= chunk;
+
+        frames += this->Drain(on_frame, context);
+    }
+
+    return frames;
+}
+
+/**
+ * @brief Drops the incomplete frame, if any.
+ *
+ * Used when the sender went silent in the middle of a frame, the next bytes
+ * belong to another frame.
+ */
+void TitaniumFrameParser::Reset(void) {
+    this->_discarded_bytes += this->_length;
+    this->_length = 0;
+}
+
+/**
+ * @brief Gives up on the incomplete frame and parses the bytes behind its start byte.
+ *
+ * A stray start byte followed by a plausible length makes the parser wait for
+ * a frame that never completes, while valid frames queue up behind it. Only
+ * that start byte is dropped, the rest of the buffer is searched again.
+ *
+ * @param[in] on_frame Called once per complete frame, in arrival order.
+ * @param[in] context Context passed to the callback.
+ * @return uint16_t Amount of frames emitted.
+ */
+uint16_t TitaniumFrameParser::Resync(frame_callback_t on_frame, void* context) {
+    if ((on_frame == nullptr) || (this->_length == 0)) {
+        return 0;
+    }
+
+    /* Drain leaves the buffer on a start byte, the candidate it keeps waiting for. */
+    memmove(this->_buffer, this->_buffer + 1, this->_length - 1);
+    this->_length--;
+    this->_discarded_bytes++;
+    this->_rejected_frames++;
+
+    return this->Drain(on_frame, context);
+}
+
+/**
+ * @brief Checks if bytes of an incomplete frame are buffered.
+ *
+ * @return bool True if the parser waits for the rest of a frame.
+ */
+bool TitaniumFrameParser::HasPartialFrame(void) const {
+    return this->_length > 0;
+}
+
+/**
+ * @brief Retrieves the bytes skipped while searching for a frame.
+ *
+ * @return uint32_t Amount of bytes discarded since the parser was created.
+ */
+uint32_t TitaniumFrameParser::GetDiscardedBytes(void) const {
+    return this->_discarded_bytes;
+}
+
+/**
+ * @brief Retrieves the frame candidates rejected by the parser.
+ *
+ * @return uint32_t Amount of candidates with an invalid length, end byte or CRC.
+ */
+uint32_t TitaniumFrameParser::GetRejectedFrames(void) const {
+    return this->_rejected_frames;
+}
+
+/**
+ * @brief Emits the complete frames of the buffer and keeps the trailing incomplete one.
+ *
+ * The frames are found batch by batch and each batch is dispatched before
+ * the next one is searched.
+ *
+ * @param[in] on_frame Called once per complete frame.
+ * @param[in] context Context passed to the callback.
+ * @return uint16_t Amount of frames emitted.
+ */
+uint16_t TitaniumFrameParser::Drain(frame_callback_t on_frame, void* context) {
+    uint16_t frames   = 0;
+    uint16_t position = 0;
+    TitaniumFrameBatch batch;
+
+    do {
+        this->_protocol.DecodeAll(this->_buffer + position, this->_length - position, batch);
+
+        for (uint8_t i = 0; i < batch.count; i++) {
+            on_frame(context, this->_buffer + position + batch.frames[i].offset, batch.frames[i].size);
+        }
+
+        frames += batch.count;
+        position += batch.consumed;
+        this->_discarded_bytes += batch.discarded_bytes;
+        this->_rejected_frames += batch.rejected_frames;
+    } while (batch.count == ProtocolConstants::MAXIMUM_BATCH_FRAMES);
+
+    if (position > 0) {
+        memmove(this->_buffer, this->_buffer + position, this->_length - position);
+        this->_length -= position;
+    }
+
+    return frames;
+}
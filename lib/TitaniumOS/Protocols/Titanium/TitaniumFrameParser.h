@@ -0,0 +1,47 @@
+#ifndef TITANIUM_FRAME_PARSER_H
+#define TITANIUM_FRAME_PARSER_H
+
+#include <stdint.h>
+
+#include "ProtocolLayout.h"
+#include "TitaniumProtocol.h"
+
+/**
+ * @brief Reassembles Titanium frames out of a byte stream.
+ *
+ * A driver read returns whatever arrived meanwhile: part of a frame, several
+ * frames, or noise around them. The parser keeps the start of an incomplete
+ * frame across calls and emits every frame that completes, its end byte and
+ * CRC already checked by TitaniumProtocol::DecodeAll.
+ */
+class TitaniumFrameParser {
+   public:
+    /**
+     * @brief Callback receiving each complete frame, see Feed.
+     *
+     * The frame lives in the parser buffer and is only valid during the call,
+     * the callback must not feed the parser.
+     */
+    typedef void (*frame_callback_t)(void* context, uint8_t* frame, uint16_t size);
+
+    TitaniumFrameParser() {};
+
+    uint16_t Feed(const uint8_t* data, uint16_t size, frame_callback_t on_frame, void* context);
+    void Reset(void);
+    uint16_t Resync(frame_callback_t on_frame, void* context);
+    bool HasPartialFrame(void) const;
+    uint32_t GetDiscardedBytes(void) const;
+    uint32_t GetRejectedFrames(void) const;
+
+   private:
+    uint16_t Drain(frame_callback_t on_frame, void* context);
+
+   private:
+    TitaniumProtocol _protocol;    /**< Finds the frames of the buffer. */
+    uint16_t _length          = 0; /**< Bytes buffered, the start of an incomplete frame. */
+    uint32_t _discarded_bytes = 0; /**< Bytes skipped while searching for a start byte. */
+    uint32_t _rejected_frames = 0; /**< Candidates dropped for their length, end byte or CRC. */
+    uint8_t _buffer[Protocol::MAXIMUM_FRAME_SIZE]; /**< Bytes received and not parsed yet. */
+};
+
+#endif /* TITANIUM_FRAME_PARSER_H */
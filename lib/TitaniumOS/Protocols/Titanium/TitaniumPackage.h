@@ -7,13 +7,112 @@
 #include <memory>
 
 #include "HAL/memory/MemoryHandlers.h"
+#include "PackagePool.h"
+
+/**
+ * @brief Titanium package read in place from a received frame.
+ *
+ * Holds the same metadata as TitaniumPackage, but the data points into the
+ * frame instead of an owned copy. The view is only valid while the buffer
+ * holding the frame is left untouched, it is meant for the receive path
+ * where the payload is written to its memory area right away.
+ */
+class TitaniumPackageView {
+   public:
+    TitaniumPackageView() {};
+
+    /**
+     * @brief Constructs a view over a payload.
+     *
+     * @param[in] size The size of the package data.
+     * @param[in] uuid The UUID carried by the frame.
+     * @param[in] address The address associated with the package.
+     * @param[in] memory_area The memory area identifier associated with the package.
+     * @param[in] data A pointer to the payload, it is not copied.
+     * @param[in] delta True if the data is a delta against the content of the memory area.
+     */
+    TitaniumPackageView(uint16_t size, uint32_t uuid, uint16_t address, uint8_t memory_area, uint8_t* data,
+                        bool delta = false)
+        : _size(size), _uuid(uuid), _address(address), _memory_area(memory_area), _delta(delta), _data(data) {}
+
+    /**
+     * @brief Check if the view points to a payload.
+     *
+     * @return True if the view was filled by a successful decode.
+     */
+    bool valid() const {
+        return _data != nullptr;
+    }
+
+    /**
+     * @brief Get the package data, inside the received frame.
+     *
+     * @return Pointer to the package data.
+     */
+    uint8_t* data() const {
+        return _data;
+    }
+
+    /**
+     * @brief Get the size of the package data.
+     *
+     * @return The size of the package data.
+     */
+    uint16_t size() const {
+        return _size;
+    }
+
+    /**
+     * @brief Get the UUID carried by the frame.
+     *
+     * @return The UUID associated with the package.
+     */
+    uint32_t uuid() const {
+        return _uuid;
+    }
+
+    /**
+     * @brief Get the address of the package data.
+     *
+     * @return The address of the package data.
+     */
+    uint16_t address() const {
+        return _address;
+    }
+
+    /**
+     * @brief Get the memory area identifier associated with the package.
+     *
+     * @return The memory area identifier associated with the package.
+     */
+    uint8_t memory_area() const {
+        return _memory_area;
+    }
+
+    /**
+     * @brief Check if the package carries a delta instead of the full memory area.
+     *
+     * @return True if the package data is a delta.
+     */
+    bool delta() const {
+        return _delta;
+    }
+
+   private:
+    uint16_t _size       = 0;        ///< The size of the package data.
+    uint32_t _uuid       = -1;       ///< The UUID carried by the frame.
+    uint16_t _address    = 0;        ///< The address of the transmitted package.
+    uint8_t _memory_area = -1;       ///< The memory area identifier associated with the package.
+    bool _delta          = false;    ///< True if the data is a delta against the memory area.
+    uint8_t* _data       = nullptr;  ///< The payload, inside the received frame.
+};
 
 /**
  * @brief Represents a Titanium package containing data and metadata.
  *
  * This class encapsulates a Titanium package, which consists of data along with metadata
- * such as package size, command type, and memory area. The package data is stored in a
- * dynamically allocated buffer managed by a std::unique_ptr.
+ * such as package size, command type, and memory area. The package and its data are
+ * stored in the PackagePool when it is enabled, on the heap otherwise.
  */
 class TitaniumPackage {
    public:
@@ -27,14 +126,15 @@ class TitaniumPackage {
      * @param[in] address The address associated with the package.
      * @param[in] memory_area The memory area identifier associated with the package.
      * @param[in] data A pointer to the data to be copied into the package.
+     * @param[in] delta True if the data is a delta against the content of the memory area.
      */
-    TitaniumPackage(uint16_t size, uint16_t address, uint8_t memory_area, uint8_t* data)
-        : _memory_area(memory_area) {
+    TitaniumPackage(uint16_t size, uint16_t address, uint8_t memory_area, uint8_t* data, bool delta = false)
+        : _memory_area(memory_area), _delta(delta) {
         this->_size    = size;
         this->_address = address;
-        this->_data    = std::make_unique<uint8_t[]>(size);
+        this->_data    = PackagePool::AcquirePayload(size);
         this->_uuid    = this->GenerateUUID();
-        memcpy_s(this->_data.get(), data, size);
+        memcpy_s(this->_data, data, size);
     }
     /**
      * @brief Constructs a TitaniumPackage object.
@@ -46,15 +146,43 @@ class TitaniumPackage {
      * @param[in] address The address associated with the package.
      * @param[in] memory_area The memory area identifier associated with the package.
      * @param[in] data A pointer to the data to be copied into the package.
+     * @param[in] delta True if the data is a delta against the content of the memory area.
      */
-    TitaniumPackage(uint16_t size, uint16_t address, uint8_t memory_area, char* data)
-        : _memory_area(memory_area) {
+    TitaniumPackage(uint16_t size, uint16_t address, uint8_t memory_area, char* data, bool delta = false)
+        : _memory_area(memory_area), _delta(delta) {
         this->_size    = size;
         this->_address = address;
-        this->_data    = std::make_unique<uint8_t[]>(size);
+        this->_data    = PackagePool::AcquirePayload(size);
         this->_uuid    = this->GenerateUUID();
-        memcpy_s(this->_data.get(), data, size);
+        memcpy_s(this->_data, data, size);
+    }
+
+    ~TitaniumPackage() {
+        PackagePool::ReleasePayload(this->_data);
     }
+
+    TitaniumPackage(const TitaniumPackage&)            = delete;
+    TitaniumPackage& operator=(const TitaniumPackage&) = delete;
+
+    /**
+     * @brief Allocates the package from the PackagePool.
+     *
+     * @param[in] size Size of the package object.
+     * @return Storage for the package.
+     */
+    static void* operator new(size_t size) {
+        return PackagePool::AcquirePackage(size);
+    }
+
+    /**
+     * @brief Returns the package storage to the PackagePool.
+     *
+     * @param[in] package Storage of the package object.
+     */
+    static void operator delete(void* package) {
+        PackagePool::ReleasePackage(package);
+    }
+
     /**
      * @brief Retrieves the package data.
      *
@@ -66,7 +194,7 @@ class TitaniumPackage {
     uint16_t Consume(uint8_t* data_out) {
         uint16_t result = 0;
         do {
-            if (this->_data.get() == nullptr) {
+            if (this->_data == nullptr) {
                 break;
             }
 
@@ -74,7 +202,7 @@ class TitaniumPackage {
                 break;
             }
 
-            if (memcpy_s(data_out, this->_data.get(), this->_size) != ESP_OK) {
+            if (memcpy_s(data_out, this->_data, this->_size) != ESP_OK) {
                 break;
             }
             result = this->_size;
@@ -87,6 +215,15 @@ class TitaniumPackage {
         return esp_random();
     }
 
+    /**
+     * @brief Get the package data without copying it.
+     *
+     * @return Pointer to the package data.
+     */
+    const uint8_t* data() const {
+        return _data;
+    }
+
     /**
      * @brief Get the size of the package data.
      *
@@ -114,6 +251,27 @@ class TitaniumPackage {
         return _memory_area;
     }
 
+    /**
+     * @brief Check if the package carries a delta instead of the full memory area.
+     *
+     * A delta is applied with TitaniumProtocol::ApplyDelta on top of the
+     * current content of the memory area.
+     *
+     * @return True if the package data is a delta.
+     */
+    bool delta() const {
+        return _delta;
+    }
+
+    /**
+     * @brief Get a view over the package data, without copying it.
+     *
+     * @return View valid as long as the package exists.
+     */
+    TitaniumPackageView view() const {
+        return TitaniumPackageView(_size, _uuid, _address, _memory_area, _data, _delta);
+    }
+
     /**
      * @brief Get the UUID the package, to make the protocol robust and
      *        compact we re-use the crc32 as UUID.
@@ -129,7 +287,8 @@ class TitaniumPackage {
     uint32_t _uuid       = -1;                 ///< The UUID associated with the package.
     uint16_t _address    = 0;                  ///< The address of the transmitted package.
     uint8_t _memory_area = -1;                 ///< The memory area identifier associated with the package.
-    std::unique_ptr<uint8_t[]> _data;          ///< The buffer storing the package data.
+    bool _delta          = false;              ///< True if the data is a delta against the memory area.
+    uint8_t* _data       = nullptr;            ///< The buffer storing the package data, from the PackagePool or the heap.
 };
 
 #endif /* TITANIUM_PACKAGE_H */
\ No newline at end of file
@@ -1,31 +1,28 @@
 #include "TitaniumProtocol.h"
 #include "Application/error/error_enum.h"
 #include "Protocols/Titanium/Utils/CRCUtils.h"
+#include "ProtocolLayout.h"
 
-namespace ProtocolAttributes {
-    constexpr uint8_t START_BYTE_OFFSET     = 0;
-    constexpr uint8_t START_BYTE_SIZE       = 1;
-    constexpr uint8_t UUID_OFFSET           = START_BYTE_OFFSET + START_BYTE_SIZE;
-    constexpr uint8_t UUID_SIZE             = 4;
-    constexpr uint8_t PAYLOAD_LENGTH_OFFSET = UUID_OFFSET + UUID_SIZE;
-    constexpr uint8_t PAYLOAD_LENGTH_SIZE   = 2;
-    constexpr uint8_t MEMORY_AREA_OFFSET    = PAYLOAD_LENGTH_OFFSET + PAYLOAD_LENGTH_SIZE;
-    constexpr uint8_t MEMORY_AREA_SIZE      = 1;
-    constexpr uint8_t ADDRESS_OFFSET        = MEMORY_AREA_OFFSET + MEMORY_AREA_SIZE;
-    constexpr uint8_t ADDRESS_SIZE          = 2;
-    constexpr uint8_t HEADER_OFFSET         = ADDRESS_OFFSET + ADDRESS_SIZE;
-    constexpr uint8_t CRC_SIZE              = 4;
-    constexpr uint8_t STATIC_MESSAGE_SIZE   = HEADER_OFFSET + CRC_SIZE;
-    constexpr uint8_t END_BYTE_SIZE         = 1;
-
-}  // namespace ProtocolAttributes
-
-namespace Protocol {
-    constexpr uint8_t START_BYTE            = 2;    /**< Start byte of the message. */
-    constexpr uint8_t END_BYTE              = 3;    /**< End byte of the message. */
-    constexpr uint16_t MAXIMUM_MESSAGE_SIZE = 1024; /**< Maximum size of a message. */
-
-}  // namespace Protocol
+#include <string.h>
+
+/**
+ * Layout of a delta payload: the size of the area once the delta is applied,
+ * the CRC32 of the area content the delta was built on, then one record per
+ * changed range made of its offset, its length and the new bytes.
+ */
+namespace DeltaAttributes {
+    constexpr uint8_t IMAGE_SIZE_OFFSET     = 0;
+    constexpr uint8_t IMAGE_SIZE_SIZE       = 2;
+    constexpr uint8_t BASELINE_CRC_OFFSET   = IMAGE_SIZE_OFFSET + IMAGE_SIZE_SIZE;
+    constexpr uint8_t BASELINE_CRC_SIZE     = 4;
+    constexpr uint8_t RECORDS_OFFSET        = BASELINE_CRC_OFFSET + BASELINE_CRC_SIZE;
+    constexpr uint8_t RECORD_OFFSET_SIZE    = 2;
+    constexpr uint8_t RECORD_LENGTH_SIZE    = 1;
+    constexpr uint8_t RECORD_HEADER_SIZE    = RECORD_OFFSET_SIZE + RECORD_LENGTH_SIZE;
+    constexpr uint16_t MAXIMUM_RECORD_SIZE  = 255;                /**< Longest range carried by a single record. */
+    constexpr uint8_t MERGE_GAP             = RECORD_HEADER_SIZE; /**< Unchanged bytes cheaper to resend than to open a new record. */
+
+}  // namespace DeltaAttributes
 
 namespace ProtocolInvalid {
     constexpr uint16_t INVALID_START_BYTE_OFFSET = 0xFFFF;     /**< Invalid Start Byte Offset. */
@@ -293,6 +290,24 @@ titan_err_t TitaniumProtocol::ValidateEndByte(uint8_t end_byte) {
     return end_byte == Protocol::END_BYTE ? ESP_OK : ProtocolErrors::INVALID_END_BYTE;
 }
 
+/**
+ * @brief Validate the end byte and the CRC of a complete frame.
+ *
+ * @param[in] frame Pointer to the start byte of the frame.
+ * @param[in] payload_length Payload length announced by the frame, flags removed.
+ * @return `ESP_OK` if the frame is valid, otherwise an error code.
+ */
+titan_err_t TitaniumProtocol::ValidateFrame(uint8_t* frame, uint16_t payload_length) {
+    auto frame_size = payload_length + ProtocolAttributes::FRAME_OVERHEAD;
+
+    if (this->ValidateEndByte(this->GetEndByte(frame, payload_length, frame_size)) != ESP_OK) {
+        return ProtocolErrors::INVALID_END_BYTE;
+    }
+
+    return this->ValidateCRC(this->GetCRC(frame, payload_length, frame_size), frame,
+                             ProtocolAttributes::HEADER_OFFSET + payload_length);
+}
+
 /**
  * @brief Encode the payload length into the buffer.
  *
@@ -388,6 +403,8 @@ titan_err_t TitaniumProtocol::EncodeUUID(uint8_t* buffer, uint32_t uuid) {
  * @brief Decode the received message and validate its components.
  *
  * This function decodes the message from the buffer and validates its components.
+ * The payload is copied into the package, see the TitaniumPackageView overload
+ * to read it in place.
  *
  * @param[in] buffer Pointer to the received message.
  * @param[in] size Size of the received message.
@@ -395,6 +412,26 @@ titan_err_t TitaniumProtocol::EncodeUUID(uint8_t* buffer, uint32_t uuid) {
  * @return `ESP_OK` if decoding and validation are successful, otherwise an error code.
  */
 titan_err_t TitaniumProtocol::Decode(uint8_t* buffer, size_t size, std::unique_ptr<TitaniumPackage>& package) {
+    TitaniumPackageView view;
+
+    auto result = this->Decode(buffer, size, view);
+
+    if (result == ESP_OK) {
+        package.reset(new TitaniumPackage(view.size(), view.address(), view.memory_area(), view.data(), view.delta()));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Decode the received message and validate its components, without copying the payload.
+ *
+ * @param[in] buffer Pointer to the received message.
+ * @param[in] size Size of the received message.
+ * @param[out] package View over the payload, valid while the buffer is left untouched.
+ * @return `ESP_OK` if decoding and validation are successful, otherwise an error code.
+ */
+titan_err_t TitaniumProtocol::Decode(uint8_t* buffer, size_t size, TitaniumPackageView& package) {
     titan_err_t result      = ESP_OK;
     int16_t remaining_bytes = size;
 
@@ -423,6 +460,8 @@ titan_err_t TitaniumProtocol::Decode(uint8_t* buffer, size_t size, std::unique_p
 
         remaining_bytes -= ProtocolAttributes::PAYLOAD_LENGTH_SIZE;
         auto payload_length = this->GetPayloadLength(start_message_pointer, remaining_bytes);
+        bool delta          = (payload_length & Protocol::DELTA_FLAG) != 0;
+        payload_length &= Protocol::PAYLOAD_LENGTH_MASK;
         if (this->ValidatePayloadLength(payload_length) != ESP_OK) {
             result = ProtocolErrors::INVALID_PAYLOAD_SIZE;
             break;
@@ -465,14 +504,117 @@ titan_err_t TitaniumProtocol::Decode(uint8_t* buffer, size_t size, std::unique_p
         }
 
         if (result == ESP_OK) {
-            package.reset(
-                new TitaniumPackage(payload_length, address, memory_area, payload));
+            package = TitaniumPackageView(payload_length, uuid, address, memory_area, payload, delta);
+        }
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Read a frame already validated by DecodeAll, without checking its CRC again.
+ *
+ * @param[in] frame Pointer to the start byte of the frame.
+ * @param[in] size Size of the frame, as reported by DecodeAll.
+ * @param[out] package View over the payload, valid while the frame is left untouched.
+ * @return `ESP_OK` if the frame was read, otherwise an error code.
+ */
+titan_err_t TitaniumProtocol::ViewFrame(uint8_t* frame, uint16_t size, TitaniumPackageView& package) {
+    titan_err_t result = ESP_OK;
+
+    do {
+        if ((frame == nullptr) || (size < ProtocolAttributes::FRAME_OVERHEAD) ||
+            (frame[ProtocolAttributes::START_BYTE_OFFSET] != Protocol::START_BYTE)) {
+            result = ProtocolErrors::INVALID_START_BYTE;
+            break;
         }
+
+        auto payload_length = this->GetPayloadLength(frame, size);
+        bool delta          = (payload_length & Protocol::DELTA_FLAG) != 0;
+        payload_length &= Protocol::PAYLOAD_LENGTH_MASK;
+        if (payload_length + ProtocolAttributes::FRAME_OVERHEAD != size) {
+            result = ProtocolErrors::INVALID_PAYLOAD_SIZE;
+            break;
+        }
+
+        auto address = this->GetAddress(frame, size);
+        if (this->ValidateAddress(address) != ESP_OK) {
+            result = ProtocolErrors::INVALID_ADDRESS;
+            break;
+        }
+
+        package = TitaniumPackageView(payload_length, this->GetUUID(frame, size), address,
+                                      this->GetMemoryArea(frame, size), this->GetPayload(frame, size), delta);
     } while (0);
 
     return result;
 }
 
+/**
+ * @brief Find every valid frame of a receive buffer.
+ *
+ * A single driver read may hold several frames, with noise between them and
+ * the start of the next frame at the end. The buffer is walked once, every
+ * frame passing the length, end byte and CRC checks is recorded, the other
+ * candidates are skipped one byte at a time to resynchronize on the next
+ * start byte. The walk stops at an incomplete frame or once the batch is full.
+ *
+ * @param[in] buffer Pointer to the received bytes.
+ * @param[in] size Amount of received bytes.
+ * @param[out] batch Receives the frames found and the amount of bytes parsed.
+ * @return Number of valid frames found.
+ */
+uint8_t TitaniumProtocol::DecodeAll(uint8_t* buffer, uint16_t size, TitaniumFrameBatch& batch) {
+    uint16_t position = 0;
+
+    batch.count           = 0;
+    batch.discarded_bytes = 0;
+    batch.rejected_frames = 0;
+
+    while ((buffer != nullptr) && (position < size) && (batch.count < ProtocolConstants::MAXIMUM_BATCH_FRAMES)) {
+        auto start = static_cast<uint8_t*>(memchr(buffer + position, Protocol::START_BYTE, size - position));
+        if (start == nullptr) {
+            batch.discarded_bytes += size - position;
+            position = size;
+            break;
+        }
+
+        batch.discarded_bytes += (start - buffer) - position;
+        position = start - buffer;
+
+        uint16_t remaining_bytes = size - position;
+        if (remaining_bytes < ProtocolAttributes::HEADER_OFFSET) {
+            break;
+        }
+
+        uint16_t payload_length = this->GetPayloadLength(start, remaining_bytes) & Protocol::PAYLOAD_LENGTH_MASK;
+        uint16_t frame_size     = payload_length + ProtocolAttributes::FRAME_OVERHEAD;
+
+        if (this->ValidatePayloadLength(payload_length) == ESP_OK) {
+            if (remaining_bytes < frame_size) {
+                break;
+            }
+
+            if (this->ValidateFrame(start, payload_length) == ESP_OK) {
+                batch.frames[batch.count].offset = position;
+                batch.frames[batch.count].size   = frame_size;
+                batch.count++;
+                position += frame_size;
+                continue;
+            }
+        }
+
+        /* Not a frame, or a corrupted one: search again right after its start byte. */
+        batch.rejected_frames++;
+        batch.discarded_bytes++;
+        position++;
+    }
+
+    batch.consumed = position;
+
+    return batch.count;
+}
+
 /**
  * @brief Encode the given TitaniumPackage into the buffer.
  *
@@ -484,39 +626,402 @@ titan_err_t TitaniumProtocol::Decode(uint8_t* buffer, size_t size, std::unique_p
  * @return Number of bytes written into the buffer.
  */
 uint16_t TitaniumProtocol::Encode(std::unique_ptr<TitaniumPackage>& package, uint8_t* buffer, uint16_t size) {
+    if (package == nullptr) {
+        return 0;
+    }
+
+    TitaniumSegment payload = {package.get()->data(), package.get()->size()};
+
+    return this->EncodeFrame(package.get()->uuid(),
+                             package.get()->address(),
+                             package.get()->memory_area(),
+                             &payload,
+                             1,
+                             buffer,
+                             size);
+}
+
+/**
+ * @brief Encode a payload into the buffer without building a TitaniumPackage.
+ *
+ * The payload is copied once, straight into the output buffer, so it can be
+ * serialized directly from a borrowed memory area.
+ *
+ * @param[in] address Destination address of the message.
+ * @param[in] memory_area Destination memory area of the message.
+ * @param[in] payload Pointer to the payload to encode.
+ * @param[in] payload_size Size of the payload.
+ * @param[out] buffer Pointer to the buffer where the encoded message will be stored.
+ * @param[in] size Size of the buffer.
+ * @return Number of bytes written into the buffer.
+ */
+uint16_t TitaniumProtocol::Encode(uint16_t address, uint8_t memory_area, const uint8_t* payload,
+                                  uint16_t payload_size, uint8_t* buffer, uint16_t size) {
+    TitaniumSegment segment = {payload, payload_size};
+
+    return this->EncodeFrame(esp_random(), address, memory_area, &segment, 1, buffer, size);
+}
+
+/**
+ * @brief Encode a payload gathered from several pieces into the buffer.
+ *
+ * The pieces are copied back to back as a single payload, so a message can
+ * be built from a header and an area, or from several areas, without first
+ * assembling it in a scratch buffer.
+ *
+ * @param[in] address Destination address of the message.
+ * @param[in] memory_area Destination memory area of the message.
+ * @param[in] segments Pieces of the payload, in order.
+ * @param[in] segment_count Amount of pieces.
+ * @param[out] buffer Pointer to the buffer where the encoded message will be stored.
+ * @param[in] size Size of the buffer.
+ * @return Number of bytes written into the buffer.
+ */
+uint16_t TitaniumProtocol::Encode(uint16_t address, uint8_t memory_area, const TitaniumSegment* segments,
+                                  uint8_t segment_count, uint8_t* buffer, uint16_t size) {
+    return this->EncodeFrame(esp_random(), address, memory_area, segments, segment_count, buffer, size);
+}
+
+/**
+ * @brief Encode a complete message into the buffer in a single pass.
+ *
+ * The header is written first, then each piece of the payload is copied and
+ * added to the CRC while it is still in cache, so the frame is never walked
+ * a second time to checksum it.
+ *
+ * @param[in] uuid UUID of the message.
+ * @param[in] address Destination address of the message.
+ * @param[in] memory_area Destination memory area of the message.
+ * @param[in] segments Pieces of the payload, in order.
+ * @param[in] segment_count Amount of pieces.
+ * @param[out] buffer Pointer to the buffer where the encoded message will be stored.
+ * @param[in] size Size of the buffer.
+ * @return Number of bytes written into the buffer.
+ */
+uint16_t TitaniumProtocol::EncodeFrame(uint32_t uuid, uint16_t address, uint8_t memory_area,
+                                       const TitaniumSegment* segments, uint8_t segment_count,
+                                       uint8_t* buffer, uint16_t size) {
+    uint16_t result       = 0;
+    uint32_t payload_size = 0;
+    bool valid_segments   = true;
+
+    do {
+        if ((buffer == nullptr) || ((segments == nullptr) && (segment_count > 0))) {
+            break;
+        }
+
+        for (uint8_t i = 0; i < segment_count; i++) {
+            valid_segments &= (segments[i].data != nullptr) || (segments[i].size == 0);
+            payload_size += segments[i].size;
+        }
+
+        if ((!valid_segments) || (payload_size > Protocol::MAXIMUM_MESSAGE_SIZE)) {
+            break;
+        }
+
+        if (size < payload_size + ProtocolAttributes::FRAME_OVERHEAD) {
+            break;
+        }
+
+        this->EncodeHeader(uuid, address, memory_area, payload_size, false, buffer);
+
+        uint32_t crc    = UpdateCRC32(0, buffer, ProtocolAttributes::HEADER_OFFSET);
+        uint16_t offset = ProtocolAttributes::HEADER_OFFSET;
+
+        for (uint8_t i = 0; i < segment_count; i++) {
+            if (segments[i].size == 0) {
+                continue;
+            }
+
+            memcpy(&buffer[offset], segments[i].data, segments[i].size);
+            crc = UpdateCRC32(crc, &buffer[offset], segments[i].size);
+            offset += segments[i].size;
+        }
+
+        this->EncodeCRC(buffer, offset, crc);
+        buffer[offset + ProtocolAttributes::CRC_SIZE] = Protocol::END_BYTE;
+
+        result = offset + ProtocolAttributes::CRC_SIZE + ProtocolAttributes::END_BYTE_SIZE;
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Write the header of a message.
+ *
+ * @param[in] uuid UUID of the message.
+ * @param[in] address Destination address of the message.
+ * @param[in] memory_area Destination memory area of the message.
+ * @param[in] payload_size Size of the payload following the header.
+ * @param[in] delta True if the payload is a delta.
+ * @param[out] buffer Pointer to the buffer holding the message.
+ */
+void TitaniumProtocol::EncodeHeader(uint32_t uuid, uint16_t address, uint8_t memory_area,
+                                    uint16_t payload_size, bool delta, uint8_t* buffer) {
+    buffer[ProtocolAttributes::START_BYTE_OFFSET]  = Protocol::START_BYTE;
+    buffer[ProtocolAttributes::MEMORY_AREA_OFFSET] = memory_area;
+
+    this->EncodeUUID(buffer, uuid);
+    this->EncodePayloadLength(buffer, delta ? (payload_size | Protocol::DELTA_FLAG) : payload_size);
+    this->EncodeAddress(buffer, address);
+}
+
+/**
+ * @brief Write the header, the CRC and the end byte around a payload already in the buffer.
+ *
+ * @param[in] uuid UUID of the message.
+ * @param[in] address Destination address of the message.
+ * @param[in] memory_area Destination memory area of the message.
+ * @param[in] payload_size Size of the payload stored at the header offset.
+ * @param[in] delta True if the payload is a delta.
+ * @param[out] buffer Pointer to the buffer holding the message.
+ * @return Number of bytes of the complete message.
+ */
+uint16_t TitaniumProtocol::SealFrame(uint32_t uuid, uint16_t address, uint8_t memory_area,
+                                     uint16_t payload_size, bool delta, uint8_t* buffer) {
+    this->EncodeHeader(uuid, address, memory_area, payload_size, delta, buffer);
+
+    auto end_byte_position    = payload_size + ProtocolAttributes::STATIC_MESSAGE_SIZE;
+    buffer[end_byte_position] = Protocol::END_BYTE;
+
+    uint16_t crc_offset = ProtocolAttributes::HEADER_OFFSET + payload_size;
+    this->EncodeCRC(buffer, crc_offset, CalculatedCRC32(buffer, crc_offset));
+
+    return end_byte_position + ProtocolAttributes::END_BYTE_SIZE;
+}
+
+/**
+ * @brief Encode the changes of a payload against the previously transmitted one.
+ *
+ * The frame carries only the ranges that differ from the baseline, flagged
+ * as a delta in the payload length. Nothing is encoded when the delta would
+ * not be smaller than the payload itself, the caller then falls back to a
+ * full frame with Encode.
+ *
+ * @param[in] address Destination address of the message.
+ * @param[in] memory_area Destination memory area of the message.
+ * @param[in] baseline Payload previously transmitted to the same destination.
+ * @param[in] baseline_size Size of the baseline.
+ * @param[in] payload Pointer to the payload to encode.
+ * @param[in] payload_size Size of the payload.
+ * @param[out] buffer Pointer to the buffer where the encoded message will be stored.
+ * @param[in] size Size of the buffer.
+ * @return Number of bytes written into the buffer, 0 if a full frame must be sent.
+ */
+uint16_t TitaniumProtocol::EncodeDelta(uint16_t address, uint8_t memory_area, const uint8_t* baseline,
+                                       uint16_t baseline_size, const uint8_t* payload, uint16_t payload_size,
+                                       uint8_t* buffer, uint16_t size) {
     uint16_t result = 0;
 
     do {
-        if (buffer == nullptr) {
+        if ((buffer == nullptr) || (payload == nullptr) || (baseline == nullptr)) {
+            break;
+        }
+
+        uint16_t frame_overhead = ProtocolAttributes::STATIC_MESSAGE_SIZE + ProtocolAttributes::END_BYTE_SIZE;
+        if (size <= frame_overhead) {
+            break;
+        }
+
+        if (payload_size == 0) {
+            break;
+        }
+
+        /* A delta must be strictly smaller than the payload to be worth the receiver's extra work. */
+        uint16_t limit = size - frame_overhead;
+        if (limit >= payload_size) {
+            limit = payload_size - 1;
+        }
+
+        if (limit > Protocol::MAXIMUM_MESSAGE_SIZE) {
+            limit = Protocol::MAXIMUM_MESSAGE_SIZE;
+        }
+
+        auto delta_size = this->EncodeDeltaRecords(baseline, baseline_size, payload, payload_size,
+                                                   &buffer[ProtocolAttributes::HEADER_OFFSET], limit);
+        if (delta_size == 0) {
+            break;
+        }
+
+        result = this->SealFrame(esp_random(), address, memory_area, delta_size, true, buffer);
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Write the delta payload turning the baseline into the payload.
+ *
+ * Changed bytes separated by fewer unchanged bytes than a record header are
+ * merged into the same record, so the records never cost more than resending
+ * the gap.
+ *
+ * @param[in] baseline Payload previously transmitted.
+ * @param[in] baseline_size Size of the baseline.
+ * @param[in] payload Payload to encode.
+ * @param[in] payload_size Size of the payload.
+ * @param[out] records Pointer where the delta payload is written.
+ * @param[in] limit Largest delta payload accepted.
+ * @return Size of the delta payload, 0 if it does not fit in the limit.
+ */
+uint16_t TitaniumProtocol::EncodeDeltaRecords(const uint8_t* baseline, uint16_t baseline_size,
+                                              const uint8_t* payload, uint16_t payload_size,
+                                              uint8_t* records, uint16_t limit) {
+    auto changed = [&](uint16_t index) {
+        return (index >= baseline_size) || (payload[index] != baseline[index]);
+    };
+
+    if (limit < DeltaAttributes::RECORDS_OFFSET) {
+        return 0;
+    }
+
+    auto baseline_crc = CalculatedCRC32(const_cast<uint8_t*>(baseline), baseline_size);
+
+    records[DeltaAttributes::IMAGE_SIZE_OFFSET]       = payload_size & 0xFF;
+    records[DeltaAttributes::IMAGE_SIZE_OFFSET + 1]   = (payload_size >> 8) & 0xFF;
+    records[DeltaAttributes::BASELINE_CRC_OFFSET]     = baseline_crc & 0xFF;
+    records[DeltaAttributes::BASELINE_CRC_OFFSET + 1] = (baseline_crc >> 8) & 0xFF;
+    records[DeltaAttributes::BASELINE_CRC_OFFSET + 2] = (baseline_crc >> 16) & 0xFF;
+    records[DeltaAttributes::BASELINE_CRC_OFFSET + 3] = (baseline_crc >> 24) & 0xFF;
+
+    uint16_t written = DeltaAttributes::RECORDS_OFFSET;
+    uint16_t index   = 0;
+
+    while (index < payload_size) {
+        if (!changed(index)) {
+            index++;
+            continue;
+        }
+
+        uint16_t start = index;
+        uint16_t end   = index + 1;
+
+        for (uint16_t scan = end; (scan < payload_size) && (scan - start < DeltaAttributes::MAXIMUM_RECORD_SIZE); scan++) {
+            if (changed(scan)) {
+                end = scan + 1;
+            } else if (scan - end >= DeltaAttributes::MERGE_GAP) {
+                break;
+            }
+        }
+
+        uint16_t length = end - start;
+        if (written + DeltaAttributes::RECORD_HEADER_SIZE + length > limit) {
+            return 0;
+        }
+
+        records[written]     = start & 0xFF;
+        records[written + 1] = (start >> 8) & 0xFF;
+        records[written + 2] = length;
+        memcpy(&records[written + DeltaAttributes::RECORD_HEADER_SIZE], &payload[start], length);
+
+        written += DeltaAttributes::RECORD_HEADER_SIZE + length;
+        index = end;
+    }
+
+    return written;
+}
+
+/**
+ * @brief Apply a delta package on top of the current content of a memory area.
+ *
+ * The delta is only applied if it was built on the same content, checked
+ * with the CRC32 it carries, and every record is validated before the first
+ * byte is written, so a rejected delta leaves the image untouched. A
+ * rejected delta is recovered by the next full frame of the sender.
+ *
+ * @param[in] package Decoded package flagged as a delta.
+ * @param[in,out] image Current content of the memory area, updated in place.
+ * @param[in] image_size Amount of valid bytes in the image.
+ * @param[in] capacity Size of the memory area.
+ * @param[out] applied_size Amount of valid bytes in the image once the delta is applied.
+ * @return `ESP_OK` if the delta was applied, otherwise an error code.
+ */
+titan_err_t TitaniumProtocol::ApplyDelta(std::unique_ptr<TitaniumPackage>& package, uint8_t* image,
+                                         uint16_t image_size, uint16_t capacity, uint16_t& applied_size) {
+    if (package == nullptr) {
+        return ProtocolErrors::INVALID_DELTA;
+    }
+
+    return this->ApplyDelta(package.get()->view(), image, image_size, capacity, applied_size);
+}
+
+/**
+ * @brief Apply a delta read in place from a received frame, see the TitaniumPackage overload.
+ *
+ * @param[in] package View over a package flagged as a delta.
+ * @param[in,out] image Current content of the memory area, updated in place.
+ * @param[in] image_size Amount of valid bytes in the image.
+ * @param[in] capacity Size of the memory area.
+ * @param[out] applied_size Amount of valid bytes in the image once the delta is applied.
+ * @return `ESP_OK` if the delta was applied, otherwise an error code.
+ */
+titan_err_t TitaniumProtocol::ApplyDelta(const TitaniumPackageView& package, uint8_t* image,
+                                         uint16_t image_size, uint16_t capacity, uint16_t& applied_size) {
+    titan_err_t result = ESP_OK;
+
+    do {
+        if ((!package.valid()) || (!package.delta()) || (image == nullptr)) {
+            result = ProtocolErrors::INVALID_DELTA;
             break;
         }
 
-        uint16_t expected_size = (package.get()->size() +
-                                  ProtocolAttributes::STATIC_MESSAGE_SIZE +
-                                  ProtocolAttributes::END_BYTE_SIZE);
+        auto delta      = package.data();
+        auto delta_size = package.size();
 
-        if (size < (package.get()->size() +
-                    ProtocolAttributes::STATIC_MESSAGE_SIZE +
-                    ProtocolAttributes::END_BYTE_SIZE)) {
+        if (delta_size < DeltaAttributes::RECORDS_OFFSET) {
+            result = ProtocolErrors::INVALID_DELTA;
             break;
         }
 
-        buffer[ProtocolAttributes::START_BYTE_OFFSET]  = Protocol::START_BYTE;
-        buffer[ProtocolAttributes::MEMORY_AREA_OFFSET] = package.get()->memory_area();
+        uint16_t target_size = delta[DeltaAttributes::IMAGE_SIZE_OFFSET] |
+                               (delta[DeltaAttributes::IMAGE_SIZE_OFFSET + 1] << 8);
+        uint32_t baseline_crc = delta[DeltaAttributes::BASELINE_CRC_OFFSET] |
+                                (delta[DeltaAttributes::BASELINE_CRC_OFFSET + 1] << 8) |
+                                (delta[DeltaAttributes::BASELINE_CRC_OFFSET + 2] << 16) |
+                                (static_cast<uint32_t>(delta[DeltaAttributes::BASELINE_CRC_OFFSET + 3]) << 24);
 
-        auto end_byte_position    = package.get()->size() + ProtocolAttributes::STATIC_MESSAGE_SIZE;
-        buffer[end_byte_position] = Protocol::END_BYTE;
+        if (target_size > capacity) {
+            result = ProtocolErrors::INVALID_DELTA;
+            break;
+        }
 
-        package.get()->Consume(&buffer[ProtocolAttributes::HEADER_OFFSET]);
+        if (CalculatedCRC32(image, image_size) != baseline_crc) {
+            result = ProtocolErrors::DELTA_BASELINE_MISMATCH;
+            break;
+        }
+
+        for (uint16_t cursor = DeltaAttributes::RECORDS_OFFSET; cursor < delta_size;) {
+            if (delta_size - cursor < DeltaAttributes::RECORD_HEADER_SIZE) {
+                result = ProtocolErrors::INVALID_DELTA;
+                break;
+            }
 
-        this->EncodeUUID(buffer, package.get()->uuid());
-        this->EncodePayloadLength(buffer, package.get()->size());
-        this->EncodeAddress(buffer, package.get()->address());
+            uint16_t offset = delta[cursor] | (delta[cursor + 1] << 8);
+            uint16_t length = delta[cursor + 2];
+            cursor += DeltaAttributes::RECORD_HEADER_SIZE;
 
-        uint16_t crc_offset = ProtocolAttributes::HEADER_OFFSET + package.get()->size();
-        this->EncodeCRC(buffer, crc_offset, CalculatedCRC32(buffer, crc_offset));
+            if ((length == 0) || (length > delta_size - cursor) || (offset + length > target_size)) {
+                result = ProtocolErrors::INVALID_DELTA;
+                break;
+            }
+            cursor += length;
+        }
+
+        if (result != ESP_OK) {
+            break;
+        }
+
+        for (uint16_t cursor = DeltaAttributes::RECORDS_OFFSET; cursor < delta_size;) {
+            uint16_t offset = delta[cursor] | (delta[cursor + 1] << 8);
+            uint16_t length = delta[cursor + 2];
+            cursor += DeltaAttributes::RECORD_HEADER_SIZE;
+
+            memcpy(&image[offset], &delta[cursor], length);
+            cursor += length;
+        }
 
-        result = expected_size;
+        applied_size = target_size;
     } while (0);
 
     return result;
@@ -5,9 +5,10 @@
 #include "Application/error/error_enum.h"
 
 namespace ProtocolConstants {
-    constexpr uint8_t ACK[]              = {0x02, 0x00, 0x03, 0x41, 0x00, 0x41, 0x43, 0x4B, 0xB4, 0x43, 0xBA, 0x3B, 0x03};  // "ACK"
-    constexpr uint8_t NAK[]              = {0x02, 0x00, 0x03, 0x41, 0x00, 0x4E, 0x41, 0x4B, 0x8D, 0x29, 0x9F, 0x84, 0x03};  // "NAK"
-    constexpr uint16_t BROADCAST_ADDRESS = 0;                                                                               // "Address used for broadcast operations"
+    constexpr uint8_t ACK[]                = {0x02, 0x00, 0x03, 0x41, 0x00, 0x41, 0x43, 0x4B, 0xB4, 0x43, 0xBA, 0x3B, 0x03};  // "ACK"
+    constexpr uint8_t NAK[]                = {0x02, 0x00, 0x03, 0x41, 0x00, 0x4E, 0x41, 0x4B, 0x8D, 0x29, 0x9F, 0x84, 0x03};  // "NAK"
+    constexpr uint16_t BROADCAST_ADDRESS   = 0;                                                                               // "Address used for broadcast operations"
+    constexpr uint8_t MAXIMUM_BATCH_FRAMES = 16;                                                                              // "Frames returned by a single DecodeAll call"
 }  // namespace ProtocolConstants
 
 namespace ProtocolErrors {
@@ -20,8 +21,38 @@ namespace ProtocolErrors {
     constexpr titan_err_t INVALID_CRC             = -7; /**< Error code indicating invalid CRC. */
     constexpr titan_err_t INVALID_END_BYTE        = -8; /**< Error code indicating invalid End Byte. */
     constexpr titan_err_t INVALID_UUID            = -9; /**< Error code indicating invalid UUID. */
+    constexpr titan_err_t INVALID_DELTA           = -10; /**< Error code indicating a malformed delta payload. */
+    constexpr titan_err_t DELTA_BASELINE_MISMATCH = -11; /**< Error code indicating the delta was not built on the current area content. */
 }  // namespace ProtocolErrors
 
+/**
+ * @brief Frames found by TitaniumProtocol::DecodeAll in a receive buffer.
+ *
+ * The frames are described by their position in the buffer, they are not
+ * copied. Bytes from consumed on were not parsed: the start of an incomplete
+ * frame, or the frames left once the batch is full.
+ */
+struct TitaniumFrameBatch {
+    struct Frame {
+        uint16_t offset; /**< Offset of the start byte in the buffer. */
+        uint16_t size;   /**< Size of the whole frame. */
+    };
+
+    Frame frames[ProtocolConstants::MAXIMUM_BATCH_FRAMES]; /**< Valid frames, in buffer order. */
+    uint8_t count            = 0;                          /**< Amount of valid frames. */
+    uint16_t consumed        = 0;                          /**< Bytes parsed, the rest must be kept for the next call. */
+    uint16_t discarded_bytes = 0;                          /**< Bytes skipped outside of a valid frame. */
+    uint16_t rejected_frames = 0;                          /**< Candidates dropped for their length, end byte or CRC. */
+};
+
+/**
+ * @brief Piece of a payload gathered by TitaniumProtocol::Encode.
+ */
+struct TitaniumSegment {
+    const uint8_t* data; /**< First byte of the piece. */
+    uint16_t size;       /**< Size of the piece. */
+};
+
 /**
  * @class TitaniumProtocol
  * @brief Class for encoding and decoding Titanium protocol messages.
@@ -35,7 +66,21 @@ class TitaniumProtocol {
 
    public:
     titan_err_t Decode(uint8_t* buffer, size_t size, std::unique_ptr<TitaniumPackage>& package);
+    titan_err_t Decode(uint8_t* buffer, size_t size, TitaniumPackageView& package);
+    uint8_t DecodeAll(uint8_t* buffer, uint16_t size, TitaniumFrameBatch& batch);
+    titan_err_t ViewFrame(uint8_t* frame, uint16_t size, TitaniumPackageView& package);
     uint16_t Encode(std::unique_ptr<TitaniumPackage>& package, uint8_t* buffer, uint16_t size);
+    uint16_t Encode(uint16_t address, uint8_t memory_area, const uint8_t* payload,
+                    uint16_t payload_size, uint8_t* buffer, uint16_t size);
+    uint16_t Encode(uint16_t address, uint8_t memory_area, const TitaniumSegment* segments,
+                    uint8_t segment_count, uint8_t* buffer, uint16_t size);
+    uint16_t EncodeDelta(uint16_t address, uint8_t memory_area, const uint8_t* baseline,
+                         uint16_t baseline_size, const uint8_t* payload, uint16_t payload_size,
+                         uint8_t* buffer, uint16_t size);
+    titan_err_t ApplyDelta(std::unique_ptr<TitaniumPackage>& package, uint8_t* image,
+                           uint16_t image_size, uint16_t capacity, uint16_t& applied_size);
+    titan_err_t ApplyDelta(const TitaniumPackageView& package, uint8_t* image,
+                           uint16_t image_size, uint16_t capacity, uint16_t& applied_size);
 
    private:
     uint16_t GetStarByteOffset(uint8_t* buffer, uint16_t buffer_size);
@@ -53,10 +98,21 @@ class TitaniumProtocol {
     titan_err_t ValidateAddress(uint16_t address);
     titan_err_t ValidatePayload(uint8_t* payload);
     titan_err_t ValidateCRC(uint32_t crc, uint8_t* buffer, uint16_t size);
+    titan_err_t ValidateFrame(uint8_t* frame, uint16_t payload_length);
     titan_err_t EncodeUUID(uint8_t* buffer, uint32_t uuid);
     titan_err_t EncodePayloadLength(uint8_t* buffer, uint16_t payload_length);
     titan_err_t EncodeAddress(uint8_t* buffer, uint16_t address);
     titan_err_t EncodeCRC(uint8_t* buffer, uint16_t offset, uint32_t crc);
+    uint16_t EncodeFrame(uint32_t uuid, uint16_t address, uint8_t memory_area,
+                         const TitaniumSegment* segments, uint8_t segment_count,
+                         uint8_t* buffer, uint16_t size);
+    void EncodeHeader(uint32_t uuid, uint16_t address, uint8_t memory_area,
+                      uint16_t payload_size, bool delta, uint8_t* buffer);
+    uint16_t SealFrame(uint32_t uuid, uint16_t address, uint8_t memory_area,
+                       uint16_t payload_size, bool delta, uint8_t* buffer);
+    uint16_t EncodeDeltaRecords(const uint8_t* baseline, uint16_t baseline_size,
+                                const uint8_t* payload, uint16_t payload_size,
+                                uint8_t* records, uint16_t limit);
 };
 
 #endif /* TITANIUM_PROTOCOL_H */
\ No newline at end of file
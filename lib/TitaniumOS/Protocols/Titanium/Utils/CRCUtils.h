@@ -3,6 +3,27 @@
 
 #include <stdint.h>
 
+/**
+ * @brief Implementations of the CRC32, they all return the same values.
+ */
+enum class CRC32Engine : uint8_t {
+    TABLE,        /**< One table lookup per byte, 1 KB table in RAM. */
+    SLICING_BY_8, /**< Eight lookups per 8 bytes, 8 KB of tables in flash. */
+    ROM,          /**< esp_rom_crc32_le, no table in the firmware. */
+};
+
+#ifndef TITANIUM_CRC32_ENGINE
+#define TITANIUM_CRC32_ENGINE CRC32Engine::TABLE /**< Overridable with a build flag, see test_crc_benchmark to pick one. */
+#endif
+
+/**
+ * @brief Update function of a CRC32 engine, see UpdateCRC32.
+ */
+typedef uint32_t (*crc32_update_t)(uint32_t crc, const uint8_t *buffer, uint32_t size);
+
 uint32_t CalculatedCRC32(uint8_t *initial_byte_address, uint32_t size);
+uint32_t UpdateCRC32(uint32_t crc, const uint8_t *initial_byte_address, uint32_t size);
+void SetCRC32Engine(CRC32Engine engine);
+CRC32Engine GetCRC32Engine(void);
 
-#endif /* CRC_UTILS_H */
\ No newline at end of file
+#endif /* CRC_UTILS_H */
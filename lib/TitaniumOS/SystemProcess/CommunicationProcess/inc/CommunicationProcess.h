@@ -3,14 +3,22 @@
 
 #include "Application/error/error_enum.h"
 #include "Drivers/DriverInterface/ICommunicationDriver.h"
+#include "HAL/memory/LinkBaseline.h"
 #include "HAL/memory/SharedMemoryManager.h"
 #include "Protocols/Protobuf/inc/titanium.pb.h"
+#include "Protocols/Titanium/TitaniumFrameParser.h"
 #include "Protocols/Titanium/TitaniumPackage.h"
 #include "Protocols/Titanium/TitaniumProtocol.h"
 #include "SystemProcess/Template/ProcessTemplate.h"
 
 #include <memory>
 
+namespace CommunicationTiming {
+    constexpr TickType_t AREA_LOCK_TIMEOUT = pdMS_TO_TICKS(20);  ///< Longest wait for a memory area before a frame is dropped or a transmission is retried.
+    constexpr uint64_t PARTIAL_FRAME_TIMEOUT_US = 200000;        ///< Silence after which the start of an incomplete frame is dropped.
+    constexpr uint8_t MAXIMUM_BURST_READS       = 8;             ///< Driver reads handled in one pass before the transmissions get a turn.
+}  // namespace CommunicationTiming
+
 /**
  * @brief A class that manages the serial communication process.
  */
@@ -30,6 +38,7 @@ class CommunicationProcess : public ProcessTemplate {
                               memory_areas_t single_packet,
                               memory_areas_t continuos_packet);
     void Configure(uint16_t address);
+    void EnableDeltaEncoding(void);
 
    public:
     uint32_t ack_list[32] = {0};
@@ -44,7 +53,12 @@ class CommunicationProcess : public ProcessTemplate {
 
     bool CheckAddressPackage(uint16_t address);
 
-    titan_err_t ProcessReceivedPackage(std::unique_ptr<TitaniumPackage>& package);
+    static void OnFrameReceived(void* context, uint8_t* frame, uint16_t size);
+    void HandleFrame(uint8_t* frame, uint16_t size);
+
+    titan_err_t ProcessReceivedPackage(const TitaniumPackageView& package);
+    titan_err_t TransmitArea(uint8_t area_index, uint16_t destination_address, uint8_t destination_area,
+                             bool allow_delta = false);
 
    private:
     uint8_t* _buffer_in                                         = nullptr;  ///< Buffer for communication RX.
@@ -53,7 +67,10 @@ class CommunicationProcess : public ProcessTemplate {
     IDriverInterface* _driver                                   = nullptr;  ///< Communication driver.
     std::unique_ptr<SharedMemoryManager> _shared_memory_manager = nullptr;  ///< Shared memory manager.
     TitaniumProtocol* _protocol                                 = nullptr;  ///< Protocol handler.
+    LinkBaseline* _baselines                                    = nullptr;  ///< Content last sent per continuos packet, nullptr if deltas are disabled.
+    TitaniumFrameParser* _frame_parser                          = nullptr;  ///< Reassembles the frames split or merged by the driver reads.
     uint8_t _ack_size_list                                      = 32;
+    consumer_handle_t _consumer = MemoryConsumer::INVALID_CONSUMER;         ///< Consumer handle used to track area updates.
     memory_areas_t _single_packet;
     memory_areas_t _continuos_packet;
     continuos_packet_list_t _cp_list{};
@@ -73,6 +90,7 @@ class CommunicationProcess : public ProcessTemplate {
 
    private:
     uint16_t _received_bytes = 0;       ///<
+    uint64_t _last_reception = 0;       ///< Time of the last driver read returning bytes, in microseconds.
     uint8_t _ack_retries     = 0;       ///<
     uint16_t _address        = 0xFFFF;  ///< Memory Address of this device
 };
@@ -15,7 +15,13 @@ void CommunicationProcess::Execute(void) {
     while (1) {
         this->ProcessState();
 
-        vTaskDelay(pdMS_TO_TICKS(100));
+        /* The driver has no receive notification, so the wait still times out to
+         * poll it and to serve the continuos packets, but a write to the packet
+         * areas wakes the process immediately.
+         */
+        if (this->communication_state == State::IDLE) {
+            this->_shared_memory_manager->WaitForUpdate(pdMS_TO_TICKS(100));
+        }
     }
 }
 
@@ -62,78 +68,133 @@ CommunicationProcess::State CommunicationProcess::Idle(void) {
     return next_state;
 }
 
+/**
+ * @brief Hands the bytes just read to the frame parser.
+ *
+ * A read may end in the middle of a frame or hold several of them, every
+ * frame completed by these bytes is handled in this pass. The driver is read
+ * again while it has bytes, so a burst is not spread over idle waits.
+ */
 CommunicationProcess::State CommunicationProcess::Read(void) {
-    std::unique_ptr<TitaniumPackage> package = nullptr;
-    auto result                              = this->_protocol->Decode(this->_buffer_in,
-                                                                       this->_received_bytes,
-                                                                       package);
+    uint8_t reads = 0;
+
+    do {
+        this->_frame_parser->Feed(this->_buffer_in, this->_received_bytes, CommunicationProcess::OnFrameReceived, this);
+        this->_received_bytes = 0;
+        reads++;
+    } while ((reads < CommunicationTiming::MAXIMUM_BURST_READS) && this->IsReadyToRead());
+
+    return State::IDLE;
+}
+
+/**
+ * @brief Frame parser callback, forwards the frame to the process.
+ *
+ * @param[in] context Pointer to the CommunicationProcess.
+ * @param[in] frame Complete frame, its CRC already checked.
+ * @param[in] size Size of the frame.
+ */
+void CommunicationProcess::OnFrameReceived(void* context, uint8_t* frame, uint16_t size) {
+    static_cast<CommunicationProcess*>(context)->HandleFrame(frame, size);
+}
+
+/**
+ * @brief Reads a received frame in place and writes it to its memory area.
+ *
+ * The frame was validated by the parser, its payload is written to the area
+ * straight from the parser buffer.
+ *
+ * @param[in] frame Complete frame.
+ * @param[in] size Size of the frame.
+ */
+void CommunicationProcess::HandleFrame(uint8_t* frame, uint16_t size) {
+    TitaniumPackageView package;
+    auto result = this->_protocol->ViewFrame(frame, size, package);
     if (result == ESP_OK) {
-        if (!this->CheckAddressPackage(package.get()->address())) {
-            this->ProcessReceivedPackage(package);
+        if (!this->CheckAddressPackage(package.address())) {
+            if (this->ProcessReceivedPackage(package) == Error::LOCK_TIMEOUT) {
+                ESP_LOGW("Communication Process", "Area %d busy, package dropped", package.memory_area());
+            }
         } else {
             /* Case in the future we support Daisy chain we need to
              * update this to a forwarding state.
              */
             ESP_LOGI("Communication Process", "Forwarding");
         }
-        this->_received_bytes = 0;
     } else {
         ESP_LOGE("Communication Process", "Decode Error: %d", (int)result);
     }
-
-    return State::IDLE;
 }
 
-titan_err_t CommunicationProcess::ProcessReceivedPackage(std::unique_ptr<TitaniumPackage>& package) {
-    char response_buffer[256] = {0};  // Add something in the proto to get the string maximum size;
-    auto result               = Error::UNKNOW_FAIL;
+/**
+ * @brief Writes a received package to its memory area.
+ *
+ * A full payload is copied once, from the received frame to the area. A
+ * delta is applied in place on the current content of the area.
+ *
+ * @param[in] package View over the received payload.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t CommunicationProcess::ProcessReceivedPackage(const TitaniumPackageView& package) {
+    auto result = Error::UNKNOW_FAIL;
 
     do {
-        auto received_bytes = package.get()->Consume(reinterpret_cast<uint8_t*>(response_buffer));
-        if (received_bytes == 0) {
-            result = Error::CONSUME_ERROR;
+        if (this->_shared_memory_manager->GetAreaSize(package.memory_area()) == 0) {
+            result = Error::INVALID_MEMORY_AREA;
+            break;
+        }
+
+        /* A consumer holding the area must not stall the receive path. */
+        if (!package.delta()) {
+            result = this->_shared_memory_manager->Write(package.memory_area(),
+                                                         reinterpret_cast<char*>(package.data()),
+                                                         package.size(),
+                                                         CommunicationTiming::AREA_LOCK_TIMEOUT);
+            break;
+        }
+
+        auto lease = this->_shared_memory_manager->Lease(package.memory_area(),
+                                                         CommunicationTiming::AREA_LOCK_TIMEOUT);
+        if (!lease.valid()) {
+            result = Error::LOCK_TIMEOUT;
             break;
         }
 
-        result = this->_shared_memory_manager->Write(package.get()->memory_area(),
-                                                     response_buffer,
-                                                     received_bytes);
+        uint16_t applied_bytes = 0;
 
+        result = this->_protocol->ApplyDelta(package, lease.data(), lease.size(), lease.capacity(), applied_bytes);
         if (result != ESP_OK) {
-            result = Error::DESERIALIZE_ERROR;
+            /* The sender's next full frame brings the area back in sync. */
+            ESP_LOGW("Communication Process", "Delta to area %d rejected: %d", package.memory_area(), (int)result);
             break;
         }
 
+        result = lease.Commit(applied_bytes);
+        if (result != ESP_OK) {
+            result = Error::DESERIALIZE_ERROR;
+        }
+
     } while (0);
 
     return result;
 }
 
 CommunicationProcess::State CommunicationProcess::Single(void) {
-    char response_buffer[256] = {0};  // Add something in the proto to get the string maximum size;
     packet_request_t packet_request{};
 
     this->_shared_memory_manager->Read(this->_single_packet,
                                        packet_request,
                                        packet_request_t_msg);
 
-    auto read_bytes = this->_shared_memory_manager->Read(packet_request.requested_area,
-                                                         response_buffer,
-                                                         sizeof(response_buffer));
-
-    auto packet = std::make_unique<TitaniumPackage>(
-        read_bytes,
-        packet_request.destination_address,
-        packet_request.destination_area,
-        response_buffer);
+    this->TransmitArea(packet_request.requested_area,
+                       packet_request.destination_address,
+                       packet_request.destination_area);
 
     return State::IDLE;
 }
 
 CommunicationProcess::State CommunicationProcess::Continuos(void) {
-    char response_buffer[256] = {0};  // Add something in the proto to get the string maximum size;
-
-    if (this->_shared_memory_manager->IsAreaDataUpdated(this->_continuos_packet)) {
+    if (this->_shared_memory_manager->HasChangedSince(this->_consumer, this->_continuos_packet)) {
         ESP_LOGI("Communication Process", "Continuos Packet Configuration Updated");
 
         auto read_bytes = this->_shared_memory_manager->Read(this->_continuos_packet,
@@ -143,6 +204,10 @@ CommunicationProcess::State CommunicationProcess::Continuos(void) {
         if (read_bytes == 0) {
             ESP_LOGE("Communication Process", "Couldn't read the config area!", );
         }
+
+        if (this->_baselines != nullptr) {
+            this->_baselines->Reset();
+        }
     }
 
     uint64_t current_time = esp_timer_get_time();
@@ -151,26 +216,99 @@ CommunicationProcess::State CommunicationProcess::Continuos(void) {
         if ((current_time - this->_cp_list.packet_configs[i].last_transmission) >
             this->_cp_list.packet_configs[i].packet_interval) {
 
-            auto read_bytes = this->_shared_memory_manager->Read(this->_cp_list.packet_configs[i].requested_area,
-                                                                 response_buffer,
-                                                                 sizeof(response_buffer));
-
-            auto packet = std::make_unique<TitaniumPackage>(
-                read_bytes,
-                this->_cp_list.packet_configs[i].destination_address,
-                this->_cp_list.packet_configs[i].destination_area,
-                response_buffer);
-
-            auto response_buffer_size = this->_protocol->Encode(packet, this->_buffer_out, this->_driver->buffer_size());
-            this->_driver->Write(this->_buffer_out, response_buffer_size);
+            auto result = this->TransmitArea(this->_cp_list.packet_configs[i].requested_area,
+                                             this->_cp_list.packet_configs[i].destination_address,
+                                             this->_cp_list.packet_configs[i].destination_area,
+                                             true);
 
-            this->_cp_list.packet_configs[i].last_transmission = current_time;
+            /* A busy area is retried on the next pass instead of waiting a whole interval. */
+            if (result != Error::LOCK_TIMEOUT) {
+                this->_cp_list.packet_configs[i].last_transmission = current_time;
+            }
         }
     }
 
     return State::IDLE;
 }
 
+/**
+ * @brief Encodes a memory area straight into the output buffer and transmits it.
+ *
+ * The area is borrowed only while it is encoded, the driver write happens
+ * after the area is released. When delta encoding is enabled and allowed,
+ * only the bytes changed since the previous transmission to the same
+ * destination are sent, falling back to a full frame when there is no
+ * baseline, a keyframe is due or the delta would not be smaller.
+ *
+ * @param[in] area_index Index of the memory area to transmit.
+ * @param[in] destination_address Address of the destination device.
+ * @param[in] destination_area Memory area of the destination device.
+ * @param[in] allow_delta True if the area may be sent as a delta.
+ * @return titan_err_t Error code indicating the result of the operation.
+ */
+titan_err_t CommunicationProcess::TransmitArea(uint8_t area_index, uint16_t destination_address, uint8_t destination_area,
+                                               bool allow_delta) {
+    auto result = Error::UNKNOW_FAIL;
+
+    do {
+        if (this->_shared_memory_manager->GetAreaSize(area_index) == 0) {
+            result = Error::INVALID_MEMORY_AREA;
+            break;
+        }
+
+        auto view = this->_shared_memory_manager->Borrow(area_index, CommunicationTiming::AREA_LOCK_TIMEOUT);
+        if (!view.valid()) {
+            result = Error::LOCK_TIMEOUT;
+            break;
+        }
+
+        LinkBaseline::Stream* stream = nullptr;
+        if (allow_delta && (this->_baselines != nullptr)) {
+            stream = this->_baselines->Acquire(area_index, destination_address, destination_area);
+        }
+
+        uint16_t encoded_bytes = 0;
+        bool delta             = false;
+
+        if ((stream != nullptr) && this->_baselines->CanSendDelta(stream)) {
+            encoded_bytes = this->_protocol->EncodeDelta(destination_address,
+                                                         destination_area,
+                                                         stream->image,
+                                                         stream->size,
+                                                         view.data(),
+                                                         view.size(),
+                                                         this->_buffer_out,
+                                                         this->_driver->buffer_size());
+            delta = encoded_bytes > 0;
+        }
+
+        if (!delta) {
+            encoded_bytes = this->_protocol->Encode(destination_address,
+                                                    destination_area,
+                                                    view.data(),
+                                                    view.size(),
+                                                    this->_buffer_out,
+                                                    this->_driver->buffer_size());
+        }
+
+        if ((stream != nullptr) && (encoded_bytes > 0)) {
+            this->_baselines->Store(stream, view.data(), view.size(), delta);
+        }
+        view.Release();
+
+        if (encoded_bytes == 0) {
+            result = Error::PACKAGE_ENCODE_ERROR;
+            break;
+        }
+
+        this->_driver->Write(this->_buffer_out, encoded_bytes);
+        result = Error::NO_ERROR;
+
+    } while (0);
+
+    return result;
+}
+
 /**
  * @brief Initializes the CommunicationProcess.
  *
@@ -185,7 +323,12 @@ titan_err_t CommunicationProcess::Initialize(void) {
         return Error::UNKNOW_FAIL;
     }
 
-    this->_protocol = new TitaniumProtocol();
+    this->_consumer = this->_shared_memory_manager->RegisterConsumer();
+    this->_shared_memory_manager->Subscribe(this->_consumer, this->_single_packet);
+    this->_shared_memory_manager->Subscribe(this->_consumer, this->_continuos_packet);
+
+    this->_protocol     = new TitaniumProtocol();
+    this->_frame_parser = new TitaniumFrameParser();
 
     if (this->_driver == nullptr) {
         return Error::UNKNOW_FAIL;
@@ -217,6 +360,19 @@ void CommunicationProcess::Configure(uint16_t address) {
     this->_address = address;
 }
 
+/**
+ * @brief Sends the continuos packets as deltas against their previous transmission.
+ *
+ * Meant for bandwidth constrained links, every continuos packet retains a
+ * copy of the area last sent. Received deltas are always applied, whether
+ * or not this link sends them.
+ */
+void CommunicationProcess::EnableDeltaEncoding(void) {
+    if (this->_baselines == nullptr) {
+        this->_baselines = new LinkBaseline();
+    }
+}
+
 /**
  * @brief Check if the received package is destined to this device.
  *
@@ -237,9 +393,25 @@ bool CommunicationProcess::CheckAddressPackage(uint16_t address) {
 
 bool CommunicationProcess::IsReadyToRead(void) {
     this->_received_bytes = this->_driver->Read(this->_buffer_in);
+
+    /* A failed read reports a negative length, nothing was received. */
+    if (this->_received_bytes > this->_driver->buffer_size()) {
+        this->_received_bytes = 0;
+    }
+
+    uint64_t current_time = esp_timer_get_time();
+
+    if (this->_received_bytes > 0) {
+        this->_last_reception = current_time;
+    } else if (this->_frame_parser->HasPartialFrame() &&
+               ((current_time - this->_last_reception) > CommunicationTiming::PARTIAL_FRAME_TIMEOUT_US)) {
+        /* The awaited frame never completed, only its start byte is dropped so the frames behind it still get through. */
+        this->_frame_parser->Resync(CommunicationProcess::OnFrameReceived, this);
+    }
+
     return this->_received_bytes > 0;
 }
 
 bool CommunicationProcess::IsReadyToTransmitSingle(void) {
-    return this->_shared_memory_manager->IsAreaDataUpdated(this->_single_packet);
+    return this->_shared_memory_manager->HasChangedSince(this->_consumer, this->_single_packet);
 }
\ No newline at end of file
@@ -53,6 +53,7 @@ class HTTPServerProcess : public ProcessTemplate {
     httpd_handle_t _server                      = nullptr;       /**< HTTP server handle. */
     TaskHandle_t _process_handler               = nullptr;       /**< Handle for the HTTP server process task. */
     SharedMemoryManager* _shared_memory_manager = nullptr;       /**< Pointer to shared memory manager instance. */
+    consumer_handle_t _consumer = MemoryConsumer::INVALID_CONSUMER; /**< Consumer handle used to track area updates. */
     network_information _connection_status{};                    /**< Current connection status. */
     network_information _last_connection_status{};               /**< Last recorded connection status. */
     uint8_t _server_status = NETWORK_STATUS_DISCONNECTED;        /**< Status of the HTTP server connection. */
@@ -166,7 +166,7 @@ static titan_err_t post_uri_wifi_credentials(httpd_req_t* req) {
         strcpy(credentials_proto.ssid, ssid);
         strcpy(credentials_proto.password, password);
 
-        http_server_manager->memory_manager()->Write(MEMORY_AREAS_NETWORK_CREDENTIALS, credentials_proto, network_credentials_t_msg);
+        http_server_manager->memory_manager()->Write<MEMORY_AREAS_NETWORK_CREDENTIALS>(credentials_proto);
         result = ESP_OK;
 
     } while (0);
@@ -177,7 +177,8 @@ static titan_err_t post_uri_wifi_credentials(httpd_req_t* req) {
 /**
  * @brief Main execution loop for HTTPServerProcess.
  *
- * This function runs an infinite loop with a delay of 1000 milliseconds.
+ * This function runs an infinite loop that sleeps until the network information
+ * area is written.
  */
 void HTTPServerProcess::Execute(void) {
     if (this->Initialize() != Error::NO_ERROR) {
@@ -186,9 +187,11 @@ void HTTPServerProcess::Execute(void) {
 
     while (1) {
         do {
-            this->_shared_memory_manager->Read(MEMORY_AREAS_NETWORK_INFORMATION,
-                                               this->_connection_status,
-                                               network_information_t_msg);
+            if (!this->_shared_memory_manager->HasChangedSince(this->_consumer, MEMORY_AREAS_NETWORK_INFORMATION)) {
+                break;
+            }
+
+            this->_shared_memory_manager->Read<MEMORY_AREAS_NETWORK_INFORMATION>(this->_connection_status);
             auto ap_changed =
                 this->_last_connection_status.ap_connected !=
                 this->_connection_status.ap_connected;
@@ -218,7 +221,7 @@ void HTTPServerProcess::Execute(void) {
             }
         } while (0);
 
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        this->_shared_memory_manager->WaitForUpdate(portMAX_DELAY);
     }
 }
 
@@ -235,6 +238,8 @@ titan_err_t HTTPServerProcess::Initialize(void) {
     this->_config.recv_wait_timeout = 10;
     this->_config.max_uri_handlers  = 20;
     this->_shared_memory_manager    = SharedMemoryManager::GetInstance();
+    this->_consumer                 = this->_shared_memory_manager->RegisterConsumer();
+    this->_shared_memory_manager->Subscribe(this->_consumer, MEMORY_AREAS_NETWORK_INFORMATION);
 
     result = this->InitializeRequestList();
 
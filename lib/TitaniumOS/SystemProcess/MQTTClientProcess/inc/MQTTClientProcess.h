@@ -1,6 +1,7 @@
 #ifndef MQTT_CLIENT_PROCESS_H
 #define MQTT_CLIENT_PROCESS_H
 
+#include "HAL/memory/MessageBus.h"
 #include "HAL/memory/SharedMemoryManager.h"
 #include "Application/error/error_enum.h"
 #include "Protocols/Protobuf/inc/titanium.pb.h"
@@ -9,6 +10,10 @@
 
 #include "mqtt_client.h"
 
+namespace MQTTClient {
+    constexpr UBaseType_t BUS_QUEUE_DEPTH = 4; /**< Area updates waiting to be published. */
+}  // namespace MQTTClient
+
 class MQTTClientProcess : public ProcessTemplate {
    public:
     /**
@@ -39,11 +44,15 @@ class MQTTClientProcess : public ProcessTemplate {
     titan_err_t Initialize(void);
     titan_err_t StartMQTTClient(void);
     titan_err_t StopMQTTClient(void);
+    void UpdateConnectionStatus(const BusMessage& message);
+    titan_err_t PublishMessage(const BusMessage& message);
 
    private:
     esp_mqtt_client_handle_t _client{};
     TaskHandle_t _process_handler                               = nullptr; /**< Handle for the HTTP server process task. */
     std::unique_ptr<SharedMemoryManager> _shared_memory_manager = nullptr;
+    QueueHandle_t _bus_queue        = nullptr;                  /**< Receives the area updates from the message bus. */
+    subscriber_handle_t _subscriber = Bus::INVALID_SUBSCRIBER;  /**< Subscription of the bus queue. */
     network_information _connection_status{};      /**< Current connection status. */
     network_information _last_connection_status{}; /**< Last recorded connection status. */
     broker_config _mqtt_client_proto{};
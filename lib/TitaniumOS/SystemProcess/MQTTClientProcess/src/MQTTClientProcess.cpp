@@ -43,6 +43,21 @@ titan_err_t MQTTClientProcess::Initialize(void) {
 
     this->_shared_memory_manager.reset(SharedMemoryManager::GetInstance());
 
+    /* Every publish is triggered by the bus, without its dispatcher the client would never start. */
+    if (!MessageBus::GetInstance()->IsStarted()) {
+        ESP_LOGE(TAG, "Message bus not started, enable it before the MQTT client");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Every area except the invalid one, the connection status arrives through the same queue. */
+    this->_bus_queue  = xQueueCreate(MQTTClient::BUS_QUEUE_DEPTH, MessageBus::QUEUE_ITEM_SIZE);
+    this->_subscriber = MessageBus::GetInstance()->Subscribe(Bus::ALL_AREAS & ~(1UL << MEMORY_AREAS_INVALID_MEMORY_AREA),
+                                                             this->_bus_queue);
+    if (this->_subscriber == Bus::INVALID_SUBSCRIBER) {
+        ESP_LOGE(TAG, "No message bus subscriber slot left");
+        return Error::UNKNOW_FAIL;
+    }
+
     this->_client = esp_mqtt_client_init(&mqtt_cfg);
     result += esp_mqtt_client_register_event(this->_client, MQTT_EVENT_ANY, mqtt_event_handler, this->_client);
     result += esp_mqtt_client_set_uri(this->_client, "mqtt://mqtt.eclipseprojects.io");
@@ -59,7 +74,8 @@ titan_err_t MQTTClientProcess::Initialize(void) {
 /**
  * @brief Main execution loop for HTTPServerProcess.
  *
- * This function runs an infinite loop with a delay of 1000 milliseconds.
+ * This function runs an infinite loop that sleeps until the message bus
+ * delivers a written memory area, then publishes it.
  */
 void MQTTClientProcess::Execute(void) {
     if (this->Initialize() != ESP_OK) {
@@ -67,11 +83,18 @@ void MQTTClientProcess::Execute(void) {
     }
 
     while (1) {
+        BusMessage message;
+
+        if (!MessageBus::Receive(this->_bus_queue, message, portMAX_DELAY)) {
+            continue;
+        }
+
         do {
-            this->_shared_memory_manager.get()->Read(MEMORY_AREAS_NETWORK_INFORMATION,
-                                                     this->_connection_status,
-                                                     network_information_t_msg,
-                                                     true);
+            if (message.area() != MEMORY_AREAS_NETWORK_INFORMATION) {
+                break;
+            }
+
+            this->UpdateConnectionStatus(message);
 
             auto ap_changed =
                 this->_last_connection_status.ap_connected !=
@@ -80,12 +103,6 @@ void MQTTClientProcess::Execute(void) {
                 this->_last_connection_status.sta_connected !=
                 this->_connection_status.sta_connected;
 
-            if (this->_client_status == NETWORK_STATUS_CONNECTED) {
-                for (uint8_t i = 1; i < this->_shared_memory_manager->GetNumAreas(); i++) {
-                    this->PublishMemoryArea(i);
-                }
-            }
-
             if (!ap_changed && !sta_changed) {
                 break;
             }
@@ -103,6 +120,13 @@ void MQTTClientProcess::Execute(void) {
                     ESP_LOGI(TAG, "MQTT CLIENT STARTED");
 
                     this->SubscribeMemoryArea();
+
+                    /* Areas written while disconnected were not published, catch up once. */
+                    for (uint8_t i = MEMORY_AREAS_INVALID_MEMORY_AREA + 1; i < Bus::MAXIMUM_AREAS; i++) {
+                        if ((i != message.area()) && (this->_shared_memory_manager->GetWrittenBytes(i) > 0)) {
+                            this->PublishMemoryArea(i);
+                        }
+                    }
                 }
             } else if ((ap_status == NETWORK_STATUS_DISCONNECTED) && (sta_status == NETWORK_STATUS_DISCONNECTED)) {
                 if (this->_client_status == NETWORK_STATUS_CONNECTED) {
@@ -112,7 +136,27 @@ void MQTTClientProcess::Execute(void) {
                 }
             }
         } while (0);
-        vTaskDelay(pdMS_TO_TICKS(1000));
+
+        if (this->_client_status == NETWORK_STATUS_CONNECTED) {
+            this->PublishMessage(message);
+        }
+    }
+}
+
+/**
+ * @brief Decodes the connection status carried by a bus message.
+ *
+ * @param[in] message Message of the network information area.
+ */
+void MQTTClientProcess::UpdateConnectionStatus(const BusMessage& message) {
+    if (!message.has_payload()) {
+        this->_shared_memory_manager->Read<MEMORY_AREAS_NETWORK_INFORMATION>(this->_connection_status);
+        return;
+    }
+
+    pb_istream_t istream = pb_istream_from_buffer(message.data(), message.size());
+    if (!pb_decode(&istream, &network_information_t_msg, &this->_connection_status)) {
+        ESP_LOGE(TAG, "Couldn't decode the network information");
     }
 }
 
@@ -147,27 +191,75 @@ titan_err_t MQTTClientProcess::StopMQTTClient(void) {
     return result;
 }
 
+/**
+ * @brief Publishes the content of a memory area straight from the area storage.
+ *
+ * The message is enqueued in the client outbox, which copies it, so the area
+ * is not held while the message goes through the network.
+ *
+ * @param[in] area_index Index of the memory area to publish.
+ * @return ESP_OK on success, or an error code on failure.
+ */
 titan_err_t MQTTClientProcess::PublishMemoryArea(uint8_t area_index) {
-    char response_buffer[512] = {0};
-    char topic_area[64]       = {0};
-    titan_err_t result        = Error::UNKNOW_FAIL;
+    char topic_area[64] = {0};
+    titan_err_t result  = Error::UNKNOW_FAIL;
 
     do {
+        if (snprintf(topic_area, sizeof(topic_area), "titanium_area/%d", area_index) < 0) {
+            break;
+        }
 
-        auto read_bytes = this->_shared_memory_manager->Read(area_index,
-                                                    response_buffer, 
-                                                    sizeof(response_buffer),
-                                                    true);
+        auto view = this->_shared_memory_manager->Borrow(area_index);
 
-        if (read_bytes == 0) {
-            return result;
+        if (view.size() == 0) {
+            break;
         }
 
-        if (snprintf(topic_area, sizeof(topic_area), "titanium_area/%d", area_index) < 0) {
+        if (esp_mqtt_client_enqueue(this->_client,
+                                    topic_area,
+                                    reinterpret_cast<const char*>(view.data()),
+                                    view.size(),
+                                    1, 0, true) < 0) {
             break;
         }
+        result = Error::NO_ERROR;
 
-        esp_mqtt_client_publish(this->_client, topic_area, response_buffer, 0, 1, 0);
+    } while (0);
+
+    return result;
+}
+
+/**
+ * @brief Publishes the content of a memory area carried by a bus message.
+ *
+ * The payload is enqueued straight from the bus buffer, areas announced
+ * without payload are published from the area storage.
+ *
+ * @param[in] message Message delivered by the bus.
+ * @return ESP_OK on success, or an error code on failure.
+ */
+titan_err_t MQTTClientProcess::PublishMessage(const BusMessage& message) {
+    char topic_area[64] = {0};
+    titan_err_t result  = Error::UNKNOW_FAIL;
+
+    do {
+        if (!message.has_payload()) {
+            result = this->PublishMemoryArea(message.area());
+            break;
+        }
+
+        if ((message.size() == 0) ||
+            (snprintf(topic_area, sizeof(topic_area), "titanium_area/%d", message.area()) < 0)) {
+            break;
+        }
+
+        if (esp_mqtt_client_enqueue(this->_client,
+                                    topic_area,
+                                    reinterpret_cast<const char*>(message.data()),
+                                    message.size(),
+                                    1, 0, true) < 0) {
+            break;
+        }
         result = Error::NO_ERROR;
 
     } while (0);
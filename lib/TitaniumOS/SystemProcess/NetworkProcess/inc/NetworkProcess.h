@@ -8,6 +8,8 @@
 
 #include "esp_wifi.h"
 
+#include <atomic>
+
 /**
  * @brief NetworkProcess class for handling Wi-Fi configuration and events.
  */
@@ -32,17 +34,21 @@ class NetworkProcess : public ProcessTemplate {
     titan_err_t SetStationMode(wifi_config_t* sta_config);
     titan_err_t SetAccessPointMode(wifi_config_t* ap_config);
     void SetCredentials(wifi_config_t* wifi_config);
+    void PublishConnectionStatus(void);
 
    private:
     esp_netif_t* _esp_netif_ap                  = nullptr;  ///< ESP-IDF network interface for AP mode.
     SharedMemoryManager* _shared_memory_manager = nullptr;  ///< Instance of the SharedMemoryManager.
+    consumer_handle_t _consumer = MemoryConsumer::INVALID_CONSUMER;  ///< Consumer handle used to track area updates.
     esp_netif_t* _esp_netif_sta                 = nullptr;  ///< ESP-IDF network interface for STA mode.
     TaskHandle_t _process_handler               = nullptr;  ///< Task handle for the NetworkProcess process.
     wifi_config_t _ap_config;                               ///< Wi-Fi configuration structure for AP mode.
     wifi_config_t _sta_config;                              ///< Wi-Fi configuration structure for STA mode.
     network_information _connection_proto;                  ///< Structure for credentials storage.
     network_credentials _cred_proto;                        ///< Structure for connection status storage.
-    uint8_t _need_update_network_data;                      ///< Flag indicating if network data needs updating.
+    std::atomic<network_status_t> _ap_status{NETWORK_STATUS_DISCONNECTED};   ///< AP status reported by the Wi-Fi events.
+    std::atomic<network_status_t> _sta_status{NETWORK_STATUS_DISCONNECTED};  ///< STA status reported by the Wi-Fi events.
+    std::atomic<bool> _need_update_network_data{false};  ///< Flag indicating if network data needs updating.
 };
 
 #endif /* NETWORK_MANAGER_GUARD */
\ No newline at end of file
@@ -107,11 +107,12 @@ static void WiFiAppEventHandler(void* arg, esp_event_base_t event_base,
 titan_err_t NetworkProcess::Initialize(void) {
     titan_err_t result              = ESP_OK;
     this->_shared_memory_manager    = SharedMemoryManager::GetInstance();
-    this->_need_update_network_data = 0;
+    this->_consumer                 = this->_shared_memory_manager->RegisterConsumer();
     auto wifi_mode                  = WIFI_MODE_APSTA;
     this->_connection_proto.ap_connected = NETWORK_STATUS_DISCONNECTED;
     this->_connection_proto.sta_connected = NETWORK_STATUS_DISCONNECTED;
 
+    result += this->_shared_memory_manager->Subscribe(this->_consumer, MEMORY_AREAS_NETWORK_CREDENTIALS);
     result += this->RegisterWiFiEvents();
     result += esp_netif_init();
 
@@ -139,11 +140,10 @@ titan_err_t NetworkProcess::Initialize(void) {
 
 /**
  * @brief Executes the main functionality of the NetworkProcess.
- * Continuously writes connection status to memory.
+ * Sleeps until new credentials are written or the connection status changes,
+ * reconnects the station with the new credentials and writes the status.
  */
 void NetworkProcess::Execute(void) {
-    auto shared_memory_manager = SharedMemoryManager::GetInstance();
-
     if (this->Initialize() != ESP_OK) {
         vTaskDelete(this->_process_handler);
     }
@@ -151,16 +151,16 @@ void NetworkProcess::Execute(void) {
     esp_wifi_connect();
 
     while (1) {
-        if (shared_memory_manager->IsAreaDataUpdated(MEMORY_AREAS_NETWORK_CREDENTIALS)) {
+        if (this->_shared_memory_manager->HasChangedSince(this->_consumer, MEMORY_AREAS_NETWORK_CREDENTIALS)) {
             this->SetStationMode(&this->_sta_config);
             esp_wifi_connect();
         }
 
-        if (this->_need_update_network_data) {
-            shared_memory_manager->Write(MEMORY_AREAS_NETWORK_INFORMATION, this->_connection_proto, network_information_t_msg);
-            this->_need_update_network_data = 0;
+        if (this->_need_update_network_data.exchange(false)) {
+            this->PublishConnectionStatus();
         }
-        vTaskDelay(pdMS_TO_TICKS(1000));
+
+        this->_shared_memory_manager->WaitForUpdate(portMAX_DELAY);
     }
 }
 
@@ -246,7 +246,9 @@ titan_err_t NetworkProcess::SetAccessPointMode(wifi_config_t* ap_config) {
  * @param[in] wifi_config Pointer to the Wi-Fi configuration structure.
  */
 void NetworkProcess::SetCredentials(wifi_config_t* wifi_config) {
-    this->_shared_memory_manager->Read(MEMORY_AREAS_NETWORK_CREDENTIALS, this->_cred_proto, network_credentials_t_msg);
+    /* The credentials applied here are the latest ones, mark them as seen by this process. */
+    this->_shared_memory_manager->HasChangedSince(this->_consumer, MEMORY_AREAS_NETWORK_CREDENTIALS);
+    this->_shared_memory_manager->Read<MEMORY_AREAS_NETWORK_CREDENTIALS>(this->_cred_proto);
 
     memcpy(wifi_config->sta.ssid, this->_cred_proto.ssid, strlen(this->_cred_proto.ssid) + 1);
     memcpy(wifi_config->sta.password, this->_cred_proto.password, strlen(this->_cred_proto.password) + 1);
@@ -257,8 +259,9 @@ void NetworkProcess::SetCredentials(wifi_config_t* wifi_config) {
  * @param[in] status The connection status to set.
  */
 void NetworkProcess::SetAPConnection(network_status_t status) {
-    this->_connection_proto.ap_connected = status;
-    this->_need_update_network_data = 1;
+    this->_ap_status.store(status);
+    this->_need_update_network_data.store(true);
+    this->_shared_memory_manager->WakeConsumer(this->_consumer);
 }
 
 /**
@@ -266,6 +269,19 @@ void NetworkProcess::SetAPConnection(network_status_t status) {
  * @param[in] status The connection status to set.
  */
 void NetworkProcess::SetSTAConnection(network_status_t status) {
-    this->_connection_proto.sta_connected = status;
-    this->_need_update_network_data = 1;
+    this->_sta_status.store(status);
+    this->_need_update_network_data.store(true);
+    this->_shared_memory_manager->WakeConsumer(this->_consumer);
+}
+
+/**
+ * @brief Writes the connection status to the network information area.
+ *
+ * Runs in the process task, woken by the Wi-Fi event handler, so the system
+ * event loop never blocks on the area mutex nor runs the write hooks.
+ */
+void NetworkProcess::PublishConnectionStatus(void) {
+    this->_connection_proto.ap_connected  = this->_ap_status.load();
+    this->_connection_proto.sta_connected = this->_sta_status.load();
+    this->_shared_memory_manager->Write<MEMORY_AREAS_NETWORK_INFORMATION>(this->_connection_proto);
 }
\ No newline at end of file
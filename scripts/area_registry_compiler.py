@@ -0,0 +1,224 @@
+import argparse
+import os
+import re
+
+ACCESS_TYPES = ("READ_ONLY", "WRITE_ONLY", "READ_WRITE")
+READ_MODES = ("LOCKED", "OPTIMISTIC")
+PLACEMENTS = ("INTERNAL", "EXTERNAL")
+BOOLEANS = ("true", "false")
+MAXIMUM_AREAS = 32
+
+def argument_parser():
+    """
+    Parses command-line arguments for the script.
+
+    Returns:
+        Namespace: Contains parsed arguments including the proto file path
+        and the output directory.
+    """
+    parser = argparse.ArgumentParser(description="Generate the shared memory area registry.")
+
+    parser.add_argument('-i', '--input', type=str, required=True, help="Input .proto file path")
+    parser.add_argument('-o', '--output', type=str, required=False, default="./", help="Output file path")
+
+    return parser.parse_args()
+
+def to_snake_case(name):
+    """
+    Converts a protobuf message name to the snake case used by nanopb.
+
+    Args:
+        name (str): The message name, e.g. "NetworkCredentials".
+
+    Returns:
+        str: The snake case name, e.g. "network_credentials".
+    """
+    return re.sub(r'(?<!^)(?=[A-Z])', '_', name).lower()
+
+def parse_enum(proto, enum_name):
+    """
+    Extracts the values of an enum declared in the proto file.
+
+    Args:
+        proto (str): The proto file content.
+        enum_name (str): The name of the enum to extract.
+
+    Returns:
+        dict: A dictionary mapping each value number to its name.
+    """
+    body = re.search(r'enum\s+' + enum_name + r'\s*\{(.*?)\}', proto, re.S)
+    if body is None:
+        raise ValueError(f"enum {enum_name} not found")
+
+    return {int(number): name for name, number in re.findall(r'(\w+)\s*=\s*(\d+)\s*;', body.group(1))}
+
+def parse_area_definitions(proto, message_name):
+    """
+    Extracts the area definitions from the message that maps every memory area to its content.
+    The field number is the area index and the field type is the message stored in the area.
+    Each field may be preceded by a comment with "@access", "@read_mode", "@cache", "@persist",
+    "@retain", "@placement" and "@owner" annotations.
+
+    Args:
+        proto (str): The proto file content.
+        message_name (str): The name of the message holding the definitions.
+
+    Returns:
+        list: A list of dictionaries with the index, message, access, read mode, cache, persistence,
+        retention, placement and owner of each area.
+    """
+    body = re.search(r'message\s+' + message_name + r'\s*\{(.*?)\n\}', proto, re.S)
+    if body is None:
+        raise ValueError(f"message {message_name} not found")
+
+    areas = []
+    annotations = {}
+
+    for line in body.group(1).splitlines():
+        line = line.strip()
+
+        if line.startswith("//"):
+            annotations.update(re.findall(r'@(\w+)\s+(\w+)', line))
+            continue
+
+        field = re.match(r'(?:required|optional)\s+(\w+)\s+(\w+)\s*=\s*(\d+)', line)
+        if field is None:
+            continue
+
+        areas.append({
+            "index": int(field.group(3)),
+            "message": field.group(1),
+            "field": field.group(2),
+            "access": annotations.get("access", "READ_WRITE"),
+            "read_mode": annotations.get("read_mode", "LOCKED"),
+            "cache": annotations.get("cache", "false"),
+            "persist": annotations.get("persist", "false"),
+            "retain": annotations.get("retain", "false"),
+            "placement": annotations.get("placement", "INTERNAL"),
+            "owner": annotations.get("owner", "Application"),
+        })
+        annotations = {}
+
+    return areas
+
+def validate_areas(areas, area_names):
+    """
+    Checks that every area definition refers to a known memory area and uses valid annotations.
+
+    Args:
+        areas (list): The parsed area definitions.
+        area_names (dict): The memory area enum, mapping each number to its name.
+    """
+    for area in areas:
+        if area["index"] not in area_names:
+            raise ValueError(f"field {area['field']} = {area['index']} has no matching memory area")
+        if area["index"] >= MAXIMUM_AREAS:
+            raise ValueError(f"memory area {area['index']} exceeds the maximum of {MAXIMUM_AREAS} areas")
+        if area["access"] not in ACCESS_TYPES:
+            raise ValueError(f"invalid access type {area['access']} for field {area['field']}")
+        if area["read_mode"] not in READ_MODES:
+            raise ValueError(f"invalid read mode {area['read_mode']} for field {area['field']}")
+        if area["cache"] not in BOOLEANS:
+            raise ValueError(f"invalid cache flag {area['cache']} for field {area['field']}")
+        if area["persist"] not in BOOLEANS:
+            raise ValueError(f"invalid persist flag {area['persist']} for field {area['field']}")
+        if area["retain"] not in BOOLEANS:
+            raise ValueError(f"invalid retain flag {area['retain']} for field {area['field']}")
+        if area["placement"] not in PLACEMENTS:
+            raise ValueError(f"invalid placement {area['placement']} for field {area['field']}")
+        if (area["placement"] == "EXTERNAL") and (area["read_mode"] == "OPTIMISTIC"):
+            raise ValueError(f"optimistic field {area['field']} must stay in internal memory")
+
+def generate_cpp_header(areas, area_names):
+    """
+    Generates a C++ header with a constexpr table describing every shared memory area.
+
+    Args:
+        areas (list): The parsed area definitions.
+        area_names (dict): The memory area enum, mapping each number to its name.
+
+    Returns:
+        str: The generated C++ header content.
+    """
+    header_content = []
+
+    header_content.append("/* This file is autogenerated. Do not edit manually. It is generated*/")
+    header_content.append("/* before the build process based on src/static/titanium.proto */")
+    header_content.append("#pragma once\n")
+
+    header_content.append('#include "HAL/memory/MemoryTypes.h"')
+    header_content.append('#include "Protocols/Protobuf/inc/titanium.pb.h"\n')
+
+    header_content.append("namespace AreaRegistry {\n")
+
+    header_content.append(f"    static constexpr uint8_t NUM_AREAS = {len(areas)};")
+    header_content.append("    static constexpr AreaDescriptor AREAS[] = {")
+    for area in areas:
+        name = to_snake_case(area["message"])
+        header_content.append(f"        {{MEMORY_AREAS_{area_names[area['index']]}, {name.upper()}_SIZE, "
+                              f"&{name}_t_msg, {area['access']}, ReadMode::{area['read_mode']}, {area['cache']}, "
+                              f"{area['persist']}, {area['retain']}, AreaPlacement::{area['placement']}, "
+                              f"\"{area['owner']}\"}},")
+    header_content.append("    };\n")
+
+    header_content.append("    /**")
+    header_content.append("     * @brief Compile-time description of a memory area, specialized for every registered area.")
+    header_content.append("     */")
+    header_content.append("    template <memory_areas_t area>")
+    header_content.append("    struct Area;\n")
+
+    for position, area in enumerate(areas):
+        name = to_snake_case(area["message"])
+        header_content.append("    template <>")
+        header_content.append(f"    struct Area<MEMORY_AREAS_{area_names[area['index']]}> {{")
+        header_content.append(f"        using type = {name}_t;")
+        header_content.append(f"        static constexpr const AreaDescriptor& descriptor = AREAS[{position}];")
+        header_content.append("    };\n")
+
+    header_content.append("}  // namespace AreaRegistry\n")
+
+    return "\n".join(header_content)
+
+def read_input_proto(filepath):
+    """
+    Reads a proto file and returns its content.
+
+    Args:
+        filepath (str): The path to the proto file.
+
+    Returns:
+        str: The proto file content.
+    """
+    with open(filepath, 'r') as proto_file:
+        return proto_file.read()
+
+def write_output_header(filepath, header_code):
+    """
+    Writes the generated C++ header code to a specified file.
+
+    Args:
+        filepath (str): The directory path where the header file will be saved.
+        header_code (str): The C++ header content to write to the file.
+    """
+    with open(os.path.join(filepath, "AreaRegistry.hpp"), 'w') as header_file:
+        header_file.write(header_code)
+
+def main():
+    """
+    Main function that orchestrates the parsing of arguments,
+    reading of the proto file, generating the C++ header,
+    and writing it to an output file.
+    """
+    args = argument_parser()
+
+    proto = read_input_proto(args.input)
+    area_names = parse_enum(proto, "MemoryAreas")
+    areas = parse_area_definitions(proto, "MemoryAreasDefinitions")
+
+    validate_areas(areas, area_names)
+    header_code = generate_cpp_header(areas, area_names)
+    write_output_header(args.output, header_code)
+
+
+if __name__ == "__main__":
+    main()
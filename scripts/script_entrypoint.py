@@ -6,3 +6,8 @@ env.Execute("$PYTHONEXE ./scripts/board_compiler.py \
             -b TITANIUM \
             -o ./lib/TitaniumOS/HAL/inc/ \
             ")
+
+env.Execute("$PYTHONEXE ./scripts/area_registry_compiler.py \
+            -i src/static/titanium.proto \
+            -o ./lib/TitaniumOS/HAL/inc/ \
+            ")
@@ -3,12 +3,15 @@
 int main(void) {
     Application app;
 
+    app.EnableMessageBus(4096, 6);
     app.EnableNetworkProcess(10240, 4);
     app.EnableHTTPServerProcess(10240, 2);
     app.EnableUartProcess(10240, 5);
     app.EnableLoraProcess(20240, 5, true);
     app.EnableMQTTClientProcess(10240, 5);
 
+    app.PrintMemoryMap();
+
     return 0;
 }
 
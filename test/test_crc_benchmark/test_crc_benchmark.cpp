@@ -0,0 +1,153 @@
+#include "Protocols/Titanium/ProtocolLayout.h"
+#include "Protocols/Titanium/Utils/CRCUtils.h"
+
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "string.h"
+#include "unity.h"
+
+static const char* TAG = "CRCBenchmark";
+
+namespace Benchmark {
+    constexpr uint32_t ITERATIONS    = 200;                          /**< Calls timed per size and engine. */
+    constexpr uint16_t MAXIMUM_SIZE  = Protocol::MAXIMUM_FRAME_SIZE; /**< Largest buffer exercised, a whole Titanium frame. */
+    constexpr uint8_t MISALIGNMENT   = 1;                            /**< Offset applied to the misaligned runs. */
+    constexpr uint8_t MAXIMUM_OFFSET = 8;                            /**< Start offsets checked, every alignment of an 8 bytes slice. */
+    constexpr uint32_t FIXED_POINT   = 1000;                         /**< Bytes per cycle are reported in thousandths. */
+
+    /** Sizes timed, from a small area to a whole frame. */
+    constexpr uint16_t SIZES[] = {16, 64, 256, Protocol::MAXIMUM_MESSAGE_SIZE, MAXIMUM_SIZE};
+
+    constexpr CRC32Engine ENGINES[] = {CRC32Engine::TABLE, CRC32Engine::SLICING_BY_8, CRC32Engine::ROM};
+    constexpr const char* NAMES[]   = {"table", "slicing-by-8", "rom"};
+    constexpr uint8_t ENGINE_COUNT  = sizeof(ENGINES) / sizeof(ENGINES[0]);
+}  // namespace Benchmark
+
+alignas(4) static uint8_t buffer[Benchmark::MAXIMUM_SIZE + Benchmark::MAXIMUM_OFFSET];
+
+/* Test vectors of test/test_protocol. */
+static uint8_t vector_one[] = {0x02, 0x04, 0x00, 0x57, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xDF, 0xDF, 0x9F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x9F, 0xDF, 0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFC, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xF8, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xF8, 0xFC, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xC0, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFC, 0xF8, 0xF8, 0xFC, 0xFE, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static uint8_t vector_two[]   = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x00};
+static uint8_t vector_three[] = {0x02, 0x03, 0x04};
+
+void setUp(void) {
+    // set stuff up here
+}
+
+void tearDown(void) {
+    SetCRC32Engine(TITANIUM_CRC32_ENGINE);
+}
+
+/**
+ * @brief Fills the buffer with bytes that are not a repeating pattern.
+ */
+static void FillBuffer(void) {
+    uint32_t state = 0x12345678;
+
+    for (auto& byte : buffer) {
+        state = state * 1103515245 + 12345;
+        byte  = state >> 24;
+    }
+}
+
+void test_EnginesMatchTestVectors() {
+    for (auto engine : Benchmark::ENGINES) {
+        SetCRC32Engine(engine);
+        TEST_ASSERT_EQUAL(engine, GetCRC32Engine());
+
+        TEST_ASSERT_EQUAL(0xCAE12BF3, CalculatedCRC32(vector_one, sizeof(vector_one)));
+        TEST_ASSERT_EQUAL(0x3933133A, CalculatedCRC32(vector_two, sizeof(vector_two)));
+        TEST_ASSERT_EQUAL(0xD0859AA6, CalculatedCRC32(vector_three, sizeof(vector_three)));
+    }
+}
+
+void test_EnginesMatchReferenceAtEveryAlignment() {
+    FillBuffer();
+
+    for (uint8_t offset = 0; offset < Benchmark::MAXIMUM_OFFSET; offset++) {
+        for (uint16_t size = 0; size <= Benchmark::MAXIMUM_SIZE; size += (size < 64) ? 1 : 61) {
+            SetCRC32Engine(CRC32Engine::TABLE);
+            auto reference = CalculatedCRC32(buffer + offset, size);
+
+            for (auto engine : Benchmark::ENGINES) {
+                SetCRC32Engine(engine);
+                TEST_ASSERT_EQUAL(reference, CalculatedCRC32(buffer + offset, size));
+            }
+        }
+    }
+}
+
+void test_EnginesUpdateIncrementally() {
+    FillBuffer();
+
+    for (auto engine : Benchmark::ENGINES) {
+        SetCRC32Engine(engine);
+        auto whole = CalculatedCRC32(buffer, Protocol::MAXIMUM_MESSAGE_SIZE);
+
+        for (uint16_t split = 0; split <= Protocol::MAXIMUM_MESSAGE_SIZE; split += 13) {
+            auto crc = UpdateCRC32(0, buffer, split);
+            crc      = UpdateCRC32(crc, buffer + split, Protocol::MAXIMUM_MESSAGE_SIZE - split);
+            TEST_ASSERT_EQUAL(whole, crc);
+        }
+    }
+}
+
+/**
+ * @brief Times an engine over the buffer and returns its throughput.
+ *
+ * @return uint32_t Thousandths of bytes checksummed per CPU cycle.
+ */
+static uint32_t MeasureThroughput(CRC32Engine engine, uint16_t size, uint8_t offset) {
+    uint32_t mismatches = 0;
+
+    SetCRC32Engine(engine);
+
+    /* Warm the caches before timing, the results are compared so the calls are not optimized out. */
+    auto reference = CalculatedCRC32(buffer + offset, size);
+
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < Benchmark::ITERATIONS; i++) {
+        mismatches += CalculatedCRC32(buffer + offset, size) != reference;
+    }
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+
+    TEST_ASSERT_EQUAL(0, mismatches);
+
+    if (cycles == 0) {
+        return 0;
+    }
+
+    return static_cast<uint32_t>((static_cast<uint64_t>(size) * Benchmark::ITERATIONS * Benchmark::FIXED_POINT) / cycles);
+}
+
+void test_BenchmarkEngines() {
+    FillBuffer();
+
+    for (uint8_t i = 0; i < Benchmark::ENGINE_COUNT; i++) {
+        for (auto size : Benchmark::SIZES) {
+            auto aligned    = MeasureThroughput(Benchmark::ENGINES[i], size, 0);
+            auto misaligned = MeasureThroughput(Benchmark::ENGINES[i], size, Benchmark::MISALIGNMENT);
+
+            ESP_LOGI(TAG, "%-12s %5u bytes: aligned %lu.%03lu B/cycle, misaligned %lu.%03lu B/cycle", Benchmark::NAMES[i], size,
+                     (unsigned long)(aligned / Benchmark::FIXED_POINT), (unsigned long)(aligned % Benchmark::FIXED_POINT),
+                     (unsigned long)(misaligned / Benchmark::FIXED_POINT), (unsigned long)(misaligned % Benchmark::FIXED_POINT));
+        }
+    }
+}
+
+void main_test(void) {
+    vTaskDelay(pdMS_TO_TICKS(2000));
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_EnginesMatchTestVectors);
+    RUN_TEST(test_EnginesMatchReferenceAtEveryAlignment);
+    RUN_TEST(test_EnginesUpdateIncrementally);
+    RUN_TEST(test_BenchmarkEngines);
+
+    UNITY_END();
+}
+
+extern "C" void app_main(void) { main_test(); };
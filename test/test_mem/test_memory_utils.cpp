@@ -60,6 +60,61 @@ void test_MemorySetWithNullStart() {
     TEST_ASSERT_EQUAL(memset_s(nullptr, 0, buffer_size), ESP_ERR_NO_MEM);
 }
 
+void test_MemorySetUnalignedTail() {
+    alignas(4) uint8_t test_bytes[40] = {0};
+
+    TEST_ASSERT_EQUAL(memset_s(&test_bytes[1], 0xA5, 37), ESP_OK);
+
+    TEST_ASSERT_EQUAL(test_bytes[0], 0x00);
+    for (int i = 1; i < 38; i++) {
+        TEST_ASSERT_EQUAL(test_bytes[i], 0xA5);
+    }
+    TEST_ASSERT_EQUAL(test_bytes[38], 0x00);
+    TEST_ASSERT_EQUAL(test_bytes[39], 0x00);
+}
+
+void test_MemoryCompareOK() {
+    alignas(4) uint8_t test_bytes[40]          = {0};
+    alignas(4) uint8_t test_bytes_expected[41] = {0};
+
+    for (int i = 0; i < sizeof(test_bytes); i++) {
+        test_bytes[i]              = i;
+        test_bytes_expected[i + 1] = i;
+    }
+
+    TEST_ASSERT_EQUAL(memcmp_s(test_bytes, test_bytes_expected + 1, sizeof(test_bytes)), ESP_OK);
+    TEST_ASSERT_EQUAL(memcmp_s(test_bytes + 1, test_bytes_expected + 2, sizeof(test_bytes) - 1), ESP_OK);
+}
+
+void test_MemoryCompareDifferentByte() {
+    alignas(4) uint8_t test_bytes[40]          = {0};
+    alignas(4) uint8_t test_bytes_expected[40] = {0};
+
+    /* Every offset within a word, so the leading bytes, the words and the tail are all exercised. */
+    for (int offset = 0; offset < 4; offset++) {
+        for (int i = offset; i < sizeof(test_bytes); i++) {
+            test_bytes_expected[i] = 0x01;
+            TEST_ASSERT_EQUAL(memcmp_s(test_bytes + offset, test_bytes_expected + offset, sizeof(test_bytes) - offset),
+                              Error::UNKNOW_FAIL);
+            TEST_ASSERT_EQUAL(memcmp_ct_s(test_bytes + offset, test_bytes_expected + offset, sizeof(test_bytes) - offset),
+                              Error::UNKNOW_FAIL);
+            test_bytes_expected[i] = 0x00;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(memcmp_s(test_bytes, test_bytes_expected, sizeof(test_bytes)), ESP_OK);
+    TEST_ASSERT_EQUAL(memcmp_ct_s(test_bytes, test_bytes_expected, sizeof(test_bytes)), ESP_OK);
+}
+
+void test_MemoryCompareInvalidArguments() {
+    uint8_t test_bytes[] = {0x02, 0x05, 0x00, 'W', 0x01, 'L', 'U', 'C', 'A', 'S'};
+
+    TEST_ASSERT_EQUAL(memcmp_s(test_bytes, test_bytes, 0), ESP_ERR_INVALID_SIZE);
+    TEST_ASSERT_EQUAL(memcmp_s(test_bytes, nullptr, sizeof(test_bytes)), ESP_ERR_NO_MEM);
+    TEST_ASSERT_EQUAL(memcmp_ct_s(test_bytes, test_bytes, 0), ESP_ERR_INVALID_SIZE);
+    TEST_ASSERT_EQUAL(memcmp_ct_s(nullptr, test_bytes, sizeof(test_bytes)), ESP_ERR_NO_MEM);
+}
+
 
 void main_test(void) {
     vTaskDelay(pdMS_TO_TICKS(2000));
@@ -73,6 +128,10 @@ void main_test(void) {
     RUN_TEST(test_MemorySetOK);
     RUN_TEST(test_MemorySetSizeZero);
     RUN_TEST(test_MemorySetWithNullStart);
+    RUN_TEST(test_MemorySetUnalignedTail);
+    RUN_TEST(test_MemoryCompareOK);
+    RUN_TEST(test_MemoryCompareDifferentByte);
+    RUN_TEST(test_MemoryCompareInvalidArguments);
 
     UNITY_END();
 }
@@ -0,0 +1,142 @@
+#include "HAL/memory/MemoryHandlers.h"
+#include "Protocols/Protobuf/inc/titanium.pb.h"
+
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "string.h"
+#include "unity.h"
+
+static const char* TAG = "MemoryBenchmark";
+
+namespace Benchmark {
+    constexpr uint32_t ITERATIONS      = 200;  /**< Calls timed per size and function. */
+    constexpr uint16_t MAXIMUM_SIZE    = 1024; /**< Largest buffer exercised, the maximum Titanium message. */
+    constexpr uint8_t MISALIGNMENT     = 1;    /**< Offset applied to the misaligned runs. */
+    constexpr uint32_t FIXED_POINT     = 1000; /**< Bytes per cycle are reported in thousandths. */
+
+    /** Sizes of the areas of titanium.proto, plus the largest message. */
+    constexpr uint16_t SIZES[] = {
+        NETWORK_INFORMATION_SIZE,
+        TIME_PROCESS_SIZE,
+        PACKET_REQUEST_SIZE,
+        AREA_STATISTICS_SIZE,
+        NETWORK_CREDENTIALS_SIZE,
+        BROKER_CONFIG_SIZE,
+        CONTINUOS_PACKET_LIST_SIZE,
+        AREA_DIAGNOSTICS_SIZE,
+        MAXIMUM_SIZE,
+    };
+}  // namespace Benchmark
+
+alignas(4) static uint8_t source[Benchmark::MAXIMUM_SIZE + Benchmark::MISALIGNMENT];
+alignas(4) static uint8_t destination[Benchmark::MAXIMUM_SIZE + Benchmark::MISALIGNMENT];
+
+/**
+ * @brief Function under test, called with the destination, the source and the size.
+ */
+typedef titan_err_t (*memory_operation_t)(uint8_t* destination, uint8_t* source, uint32_t size);
+
+void setUp(void) {
+    // set stuff up here
+}
+
+void tearDown(void) {
+    // clean stuff up here
+}
+
+static titan_err_t CopySafe(uint8_t* destination, uint8_t* source, uint32_t size) {
+    return memcpy_s(destination, source, size);
+}
+
+static titan_err_t SetSafe(uint8_t* destination, uint8_t* source, uint32_t size) {
+    return memset_s(destination, 0, size);
+}
+
+static titan_err_t CompareSafe(uint8_t* destination, uint8_t* source, uint32_t size) {
+    return memcmp_s(destination, source, size);
+}
+
+static titan_err_t CompareConstantTime(uint8_t* destination, uint8_t* source, uint32_t size) {
+    return memcmp_ct_s(destination, source, size);
+}
+
+static titan_err_t SetLibc(uint8_t* destination, uint8_t* source, uint32_t size) {
+    memset(destination, 0, size);
+    return ESP_OK;
+}
+
+static titan_err_t CompareLibc(uint8_t* destination, uint8_t* source, uint32_t size) {
+    return memcmp(destination, source, size) == 0 ? ESP_OK : Error::UNKNOW_FAIL;
+}
+
+/**
+ * @brief Times an operation over the same buffers and returns its throughput.
+ *
+ * The buffers hold the same bytes, so compares walk the whole size.
+ *
+ * @return uint32_t Thousandths of bytes handled per CPU cycle.
+ */
+static uint32_t MeasureThroughput(memory_operation_t operation, uint16_t size, uint8_t offset) {
+    uint8_t* destination_pointer = destination + offset;
+    uint8_t* source_pointer      = source + offset;
+
+    memset(source, 0, sizeof(source));
+    memset(destination, 0, sizeof(destination));
+
+    /* Warm the caches and check the operation before timing it. */
+    TEST_ASSERT_EQUAL(ESP_OK, operation(destination_pointer, source_pointer, size));
+
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < Benchmark::ITERATIONS; i++) {
+        operation(destination_pointer, source_pointer, size);
+    }
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+
+    if (cycles == 0) {
+        return 0;
+    }
+
+    return static_cast<uint32_t>((static_cast<uint64_t>(size) * Benchmark::ITERATIONS * Benchmark::FIXED_POINT) / cycles);
+}
+
+static void ReportThroughput(const char* name, memory_operation_t operation) {
+    for (auto size : Benchmark::SIZES) {
+        auto aligned    = MeasureThroughput(operation, size, 0);
+        auto misaligned = MeasureThroughput(operation, size, Benchmark::MISALIGNMENT);
+
+        ESP_LOGI(TAG, "%-14s %5u bytes: aligned %lu.%03lu B/cycle, misaligned %lu.%03lu B/cycle", name, size,
+                 (unsigned long)(aligned / Benchmark::FIXED_POINT), (unsigned long)(aligned % Benchmark::FIXED_POINT),
+                 (unsigned long)(misaligned / Benchmark::FIXED_POINT), (unsigned long)(misaligned % Benchmark::FIXED_POINT));
+    }
+}
+
+void test_BenchmarkCopy() {
+    ReportThroughput("memcpy_s", CopySafe);
+}
+
+void test_BenchmarkSet() {
+    ReportThroughput("memset_s", SetSafe);
+    ReportThroughput("memset", SetLibc);
+}
+
+void test_BenchmarkCompare() {
+    ReportThroughput("memcmp_s", CompareSafe);
+    ReportThroughput("memcmp_ct_s", CompareConstantTime);
+    ReportThroughput("memcmp", CompareLibc);
+}
+
+void main_test(void) {
+    vTaskDelay(pdMS_TO_TICKS(2000));
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_BenchmarkCopy);
+    RUN_TEST(test_BenchmarkSet);
+    RUN_TEST(test_BenchmarkCompare);
+
+    UNITY_END();
+}
+
+extern "C" void app_main(void) { main_test(); };
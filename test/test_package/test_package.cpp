@@ -22,6 +22,8 @@ void test_package_creation() {
     for (int i = 0; i < size; i++){
         TEST_ASSERT_EQUAL(buffer[i], buffer_consumed[i]);
     }
+
+    delete package_data;
 }
 
 void test_package_decoupling() {
@@ -50,6 +52,84 @@ void test_package_decoupling() {
         TEST_ASSERT_EQUAL(buffer_backup[i], buffer_consumed[i]);
     }
 
+    delete package_data;
+}
+
+void test_package_pool_reuse() {
+    uint8_t buffer[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+    if ((Pool::PACKAGES == 0) || (Pool::PAYLOADS == 0)) {
+        TEST_IGNORE_MESSAGE("Built without TITANIUM_POOL_PACKAGES and TITANIUM_POOL_PAYLOADS");
+    }
+
+    /* Every earlier package was released, the pool has to serve this one. */
+    auto before = PackagePool::GetStatistics();
+    TEST_ASSERT_EQUAL(0, before.packages_in_use);
+    TEST_ASSERT_EQUAL(0, before.payloads_in_use);
+
+    auto package_data = std::make_unique<TitaniumPackage>(sizeof(buffer), 0x0000, 1, buffer);
+    auto pooled       = PackagePool::GetStatistics();
+    TEST_ASSERT_EQUAL(1, pooled.packages_in_use);
+    TEST_ASSERT_EQUAL(1, pooled.payloads_in_use);
+    TEST_ASSERT_EQUAL(before.package_exhausted, pooled.package_exhausted);
+    TEST_ASSERT_EQUAL(before.payload_exhausted, pooled.payload_exhausted);
+
+    package_data.reset();
+    TEST_ASSERT_EQUAL(before.packages_in_use, PackagePool::GetStatistics().packages_in_use);
+    TEST_ASSERT_EQUAL(before.payloads_in_use, PackagePool::GetStatistics().payloads_in_use);
+
+    package_data = std::make_unique<TitaniumPackage>(sizeof(buffer), 0x0000, 1, buffer);
+    package_data.reset();
+
+    auto after = PackagePool::GetStatistics();
+    TEST_ASSERT_EQUAL(before.package_exhausted, after.package_exhausted);
+    TEST_ASSERT_EQUAL(before.payload_exhausted, after.payload_exhausted);
+    TEST_ASSERT_EQUAL(before.packages_in_use, after.packages_in_use);
+}
+
+void test_package_pool_exhaustion() {
+    constexpr uint8_t count = Pool::PACKAGES + 2;
+    std::unique_ptr<TitaniumPackage> packages[count];
+    uint8_t buffer[16];
+
+    if ((Pool::PACKAGES == 0) || (Pool::PAYLOADS == 0)) {
+        TEST_IGNORE_MESSAGE("Built without TITANIUM_POOL_PACKAGES and TITANIUM_POOL_PAYLOADS");
+    }
+
+    auto before = PackagePool::GetStatistics();
+    TEST_ASSERT_EQUAL(0, before.packages_in_use);
+    TEST_ASSERT_EQUAL(0, before.payloads_in_use);
+
+    for (uint8_t i = 0; i < count; i++) {
+        memset(buffer, i, sizeof(buffer));
+        packages[i] = std::make_unique<TitaniumPackage>(sizeof(buffer), i, 1, buffer);
+    }
+
+    auto exhausted = PackagePool::GetStatistics();
+    TEST_ASSERT_EQUAL(Pool::PACKAGES, exhausted.packages_in_use);
+    TEST_ASSERT_EQUAL(Pool::PAYLOADS, exhausted.payloads_in_use);
+    TEST_ASSERT_EQUAL(before.package_exhausted + count - (Pool::PACKAGES - before.packages_in_use),
+                      exhausted.package_exhausted);
+    TEST_ASSERT_EQUAL(before.payload_exhausted + count - (Pool::PAYLOADS - before.payloads_in_use),
+                      exhausted.payload_exhausted);
+
+    /* Packages served by the heap behave the same as pooled ones. */
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t buffer_consumed[16] = {0};
+        TEST_ASSERT_EQUAL(sizeof(buffer), packages[i]->Consume(buffer_consumed));
+        TEST_ASSERT_EQUAL(i, packages[i]->address());
+        for (auto byte : buffer_consumed) {
+            TEST_ASSERT_EQUAL(i, byte);
+        }
+    }
+
+    for (auto& package : packages) {
+        package.reset();
+    }
+
+    auto after = PackagePool::GetStatistics();
+    TEST_ASSERT_EQUAL(before.packages_in_use, after.packages_in_use);
+    TEST_ASSERT_EQUAL(before.payloads_in_use, after.payloads_in_use);
 }
 
 void main_test(void) {
@@ -58,6 +138,8 @@ void main_test(void) {
     UNITY_BEGIN();
     RUN_TEST(test_package_creation);
     RUN_TEST(test_package_decoupling);
+    RUN_TEST(test_package_pool_reuse);
+    RUN_TEST(test_package_pool_exhaustion);
     UNITY_END();
 }
 
@@ -1,3 +1,4 @@
+#include "Protocols/Titanium/TitaniumFrameParser.h"
 #include "Protocols/Titanium/TitaniumProtocol.h"
 #include "Protocols/Titanium/Utils/CRCUtils.h"
 
@@ -142,6 +143,278 @@ void test_EncodeShortBuffer() {
     TEST_ASSERT_EQUAL(0, protocol.Encode(package, test_message_buffer, sizeof(test_message_buffer)));
 }
 
+void test_EncodeRawPayloadRoundTrip() {
+    TitaniumProtocol protocol;
+    uint8_t payload[5]                       = {'L', 'U', 'C', 'A', 'S'};
+    uint8_t test_message_buffer[30]          = {0};
+    std::unique_ptr<TitaniumPackage> package = nullptr;
+
+    auto encoded_bytes = protocol.Encode(0x1015, 0x01, payload, sizeof(payload), test_message_buffer, sizeof(test_message_buffer));
+    TEST_ASSERT_EQUAL(20, encoded_bytes);
+    TEST_ASSERT_EQUAL(ESP_OK, protocol.Decode(test_message_buffer, encoded_bytes, package));
+
+    TEST_ASSERT_EQUAL(sizeof(payload), package.get()->size());
+    TEST_ASSERT_EQUAL(0x1015, package.get()->address());
+    TEST_ASSERT_EQUAL(0x01, package.get()->memory_area());
+    TEST_ASSERT_EQUAL_MEMORY(payload, package.get()->data(), sizeof(payload));
+}
+
+void test_EncodeGathersSegments() {
+    TitaniumProtocol protocol;
+    TitaniumPackageView package;
+    uint8_t header[2]               = {0xA5, 0x5A};
+    uint8_t payload[5]              = {'L', 'U', 'C', 'A', 'S'};
+    uint8_t expected[7]             = {0xA5, 0x5A, 'L', 'U', 'C', 'A', 'S'};
+    uint8_t test_message_buffer[30] = {0};
+    TitaniumSegment segments[]      = {{header, sizeof(header)}, {nullptr, 0}, {payload, sizeof(payload)}};
+
+    auto encoded_bytes = protocol.Encode(0x1015, 0x01, segments, 3, test_message_buffer, sizeof(test_message_buffer));
+    TEST_ASSERT_EQUAL(sizeof(expected) + ProtocolAttributes::FRAME_OVERHEAD, encoded_bytes);
+    TEST_ASSERT_EQUAL(ESP_OK, protocol.Decode(test_message_buffer, encoded_bytes, package));
+    TEST_ASSERT_EQUAL(sizeof(expected), package.size());
+    TEST_ASSERT_EQUAL_MEMORY(expected, package.data(), sizeof(expected));
+
+    TEST_ASSERT_EQUAL(0, protocol.Encode(0x1015, 0x01, segments, 3, test_message_buffer, encoded_bytes - 1));
+    segments[1].size = 1;
+    TEST_ASSERT_EQUAL(0, protocol.Encode(0x1015, 0x01, segments, 3, test_message_buffer, sizeof(test_message_buffer)));
+}
+
+void test_DecodeViewReadsPayloadInPlace() {
+    TitaniumProtocol protocol;
+    TitaniumPackageView package;
+    TitaniumPackageView frame_package;
+    uint8_t payload[5]              = {'L', 'U', 'C', 'A', 'S'};
+    uint8_t test_message_buffer[30] = {0};
+
+    auto encoded_bytes = protocol.Encode(0x1015, 0x01, payload, sizeof(payload), test_message_buffer, sizeof(test_message_buffer));
+    TEST_ASSERT_EQUAL(ESP_OK, protocol.Decode(test_message_buffer, encoded_bytes, package));
+
+    TEST_ASSERT_TRUE(package.valid());
+    TEST_ASSERT_TRUE(package.data() == &test_message_buffer[ProtocolAttributes::HEADER_OFFSET]);
+    TEST_ASSERT_EQUAL(sizeof(payload), package.size());
+    TEST_ASSERT_EQUAL(0x1015, package.address());
+    TEST_ASSERT_EQUAL(0x01, package.memory_area());
+    TEST_ASSERT_FALSE(package.delta());
+
+    TEST_ASSERT_EQUAL(ESP_OK, protocol.ViewFrame(test_message_buffer, encoded_bytes, frame_package));
+    TEST_ASSERT_TRUE(frame_package.data() == package.data());
+    TEST_ASSERT_EQUAL(package.uuid(), frame_package.uuid());
+    TEST_ASSERT_EQUAL(ProtocolErrors::INVALID_PAYLOAD_SIZE, protocol.ViewFrame(test_message_buffer, encoded_bytes - 1, frame_package));
+}
+
+void test_EncodeDeltaRoundTrip() {
+    TitaniumProtocol protocol;
+    uint8_t baseline[64]                     = {0};
+    uint8_t payload[64]                      = {0};
+    uint8_t image[64]                        = {0};
+    uint8_t test_message_buffer[96]          = {0};
+    std::unique_ptr<TitaniumPackage> package = nullptr;
+    uint16_t applied_bytes                   = 0;
+
+    for (int i = 0; i < sizeof(baseline); i++) {
+        baseline[i] = i;
+    }
+    memcpy(payload, baseline, sizeof(payload));
+    payload[3]  = 0xAA;
+    payload[40] = 0xBB;
+    payload[41] = 0xCC;
+
+    auto encoded_bytes = protocol.EncodeDelta(0x1015, 0x01, baseline, sizeof(baseline), payload, sizeof(payload),
+                                              test_message_buffer, sizeof(test_message_buffer));
+    TEST_ASSERT_NOT_EQUAL(0, encoded_bytes);
+    TEST_ASSERT_LESS_THAN(sizeof(payload), encoded_bytes);
+    TEST_ASSERT_EQUAL(ESP_OK, protocol.Decode(test_message_buffer, encoded_bytes, package));
+    TEST_ASSERT_TRUE(package.get()->delta());
+
+    memcpy(image, baseline, sizeof(image));
+    TEST_ASSERT_EQUAL(ESP_OK, protocol.ApplyDelta(package, image, sizeof(baseline), sizeof(image), applied_bytes));
+    TEST_ASSERT_EQUAL(sizeof(payload), applied_bytes);
+    TEST_ASSERT_EQUAL_MEMORY(payload, image, sizeof(payload));
+}
+
+void test_DeltaRejectedOnStaleBaseline() {
+    TitaniumProtocol protocol;
+    uint8_t baseline[32]                     = {0};
+    uint8_t payload[32]                      = {0};
+    uint8_t image[32]                        = {0};
+    uint8_t test_message_buffer[64]          = {0};
+    std::unique_ptr<TitaniumPackage> package = nullptr;
+    uint16_t applied_bytes                   = 0;
+
+    payload[0] = 0x01;
+    image[5]   = 0x05;
+
+    auto encoded_bytes = protocol.EncodeDelta(0x1015, 0x01, baseline, sizeof(baseline), payload, sizeof(payload),
+                                              test_message_buffer, sizeof(test_message_buffer));
+    TEST_ASSERT_EQUAL(ESP_OK, protocol.Decode(test_message_buffer, encoded_bytes, package));
+    TEST_ASSERT_EQUAL(ProtocolErrors::DELTA_BASELINE_MISMATCH,
+                      protocol.ApplyDelta(package, image, sizeof(image), sizeof(image), applied_bytes));
+    TEST_ASSERT_EQUAL(0x00, image[0]);
+}
+
+void test_DeltaFallsBackWhenNotSmaller() {
+    TitaniumProtocol protocol;
+    uint8_t baseline[8]             = {0};
+    uint8_t payload[8]              = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t test_message_buffer[32] = {0};
+
+    TEST_ASSERT_EQUAL(0, protocol.EncodeDelta(0x1015, 0x01, baseline, sizeof(baseline), payload, sizeof(payload),
+                                              test_message_buffer, sizeof(test_message_buffer)));
+}
+
+void test_DecodeAllReturnsEveryFrame() {
+    TitaniumProtocol protocol;
+    TitaniumFrameBatch batch;
+    uint8_t payload[5]              = {'L', 'U', 'C', 'A', 'S'};
+    uint8_t test_message_buffer[96] = {0xAA, 0x55};
+    uint16_t offset                 = 2;
+
+    auto first_bytes = protocol.Encode(0x1015, 0x01, payload, sizeof(payload), test_message_buffer + offset,
+                                       sizeof(test_message_buffer) - offset);
+    offset += first_bytes + 1;
+    auto second_offset = offset;
+    auto second_bytes  = protocol.Encode(0x1015, 0x02, payload, 3, test_message_buffer + offset,
+                                         sizeof(test_message_buffer) - offset);
+    offset += second_bytes;
+    auto partial_offset = offset;
+    protocol.Encode(0x1015, 0x03, payload, sizeof(payload), test_message_buffer + offset,
+                    sizeof(test_message_buffer) - offset);
+
+    TEST_ASSERT_EQUAL(2, protocol.DecodeAll(test_message_buffer, partial_offset + 12, batch));
+
+    TEST_ASSERT_EQUAL(2, batch.count);
+    TEST_ASSERT_EQUAL(2, batch.frames[0].offset);
+    TEST_ASSERT_EQUAL(first_bytes, batch.frames[0].size);
+    TEST_ASSERT_EQUAL(second_offset, batch.frames[1].offset);
+    TEST_ASSERT_EQUAL(second_bytes, batch.frames[1].size);
+    TEST_ASSERT_EQUAL(partial_offset, batch.consumed);
+    TEST_ASSERT_EQUAL(3, batch.discarded_bytes);
+}
+
+/**
+ * @brief Frames emitted by the parser during a test.
+ */
+struct ReceivedFrames {
+    uint8_t count     = 0;
+    uint16_t sizes[4] = {0};
+    uint8_t areas[4]  = {0};
+};
+
+static void CollectFrame(void* context, uint8_t* frame, uint16_t size) {
+    auto received = static_cast<ReceivedFrames*>(context);
+    TitaniumProtocol protocol;
+    std::unique_ptr<TitaniumPackage> package = nullptr;
+
+    TEST_ASSERT_EQUAL(ESP_OK, protocol.Decode(frame, size, package));
+    TEST_ASSERT_LESS_THAN(4, received->count);
+
+    received->sizes[received->count] = size;
+    received->areas[received->count] = package.get()->memory_area();
+    received->count++;
+}
+
+void test_ParserReassemblesSplitFrame() {
+    TitaniumProtocol protocol;
+    TitaniumFrameParser parser;
+    ReceivedFrames received;
+    uint8_t payload[5]              = {'L', 'U', 'C', 'A', 'S'};
+    uint8_t test_message_buffer[30] = {0};
+
+    auto encoded_bytes = protocol.Encode(0x1015, 0x01, payload, sizeof(payload), test_message_buffer, sizeof(test_message_buffer));
+
+    TEST_ASSERT_EQUAL(0, parser.Feed(test_message_buffer, 3, CollectFrame, &received));
+    TEST_ASSERT_EQUAL(0, parser.Feed(test_message_buffer + 3, 9, CollectFrame, &received));
+    TEST_ASSERT_TRUE(parser.HasPartialFrame());
+    TEST_ASSERT_EQUAL(1, parser.Feed(test_message_buffer + 12, encoded_bytes - 12, CollectFrame, &received));
+
+    TEST_ASSERT_EQUAL(1, received.count);
+    TEST_ASSERT_EQUAL(encoded_bytes, received.sizes[0]);
+    TEST_ASSERT_FALSE(parser.HasPartialFrame());
+    TEST_ASSERT_EQUAL(0, parser.GetDiscardedBytes());
+}
+
+void test_ParserSplitsMergedFrames() {
+    TitaniumProtocol protocol;
+    TitaniumFrameParser parser;
+    ReceivedFrames received;
+    uint8_t payload[5]              = {'L', 'U', 'C', 'A', 'S'};
+    uint8_t test_message_buffer[64] = {0};
+
+    auto first_bytes  = protocol.Encode(0x1015, 0x01, payload, sizeof(payload), test_message_buffer, sizeof(test_message_buffer));
+    auto second_bytes = protocol.Encode(0x1015, 0x02, payload, 3, test_message_buffer + first_bytes,
+                                        sizeof(test_message_buffer) - first_bytes);
+    protocol.Encode(0x1015, 0x03, payload, sizeof(payload), test_message_buffer + first_bytes + second_bytes,
+                    sizeof(test_message_buffer) - first_bytes - second_bytes);
+
+    /* The trailing bytes start the third frame, kept until the rest arrives. */
+    TEST_ASSERT_EQUAL(2, parser.Feed(test_message_buffer, first_bytes + second_bytes + 4, CollectFrame, &received));
+
+    TEST_ASSERT_EQUAL(2, received.count);
+    TEST_ASSERT_EQUAL(0x01, received.areas[0]);
+    TEST_ASSERT_EQUAL(0x02, received.areas[1]);
+    TEST_ASSERT_EQUAL(second_bytes, received.sizes[1]);
+    TEST_ASSERT_TRUE(parser.HasPartialFrame());
+
+    parser.Reset();
+    TEST_ASSERT_FALSE(parser.HasPartialFrame());
+}
+
+void test_ParserResynchronizesAfterCorruption() {
+    TitaniumProtocol protocol;
+    TitaniumFrameParser parser;
+    ReceivedFrames received;
+    uint8_t payload[5]              = {'L', 'U', 'C', 'A', 'S'};
+    uint8_t test_message_buffer[64] = {0xAA, 0x55, 0x00};
+    uint8_t garbage_bytes           = 3;
+
+    /* The UUID and the CRC are cleared so no byte of the corrupted frame looks like a start byte. */
+    auto corrupted_bytes = protocol.Encode(0x1015, 0x01, payload, sizeof(payload), test_message_buffer + garbage_bytes,
+                                           sizeof(test_message_buffer) - garbage_bytes);
+    memset(test_message_buffer + garbage_bytes + ProtocolAttributes::UUID_OFFSET, 0, ProtocolAttributes::UUID_SIZE);
+    memset(test_message_buffer + garbage_bytes + ProtocolAttributes::HEADER_OFFSET + sizeof(payload), 0,
+           ProtocolAttributes::CRC_SIZE);
+
+    auto valid_offset = garbage_bytes + corrupted_bytes;
+    auto valid_bytes  = protocol.Encode(0x1015, 0x03, payload, sizeof(payload), test_message_buffer + valid_offset,
+                                        sizeof(test_message_buffer) - valid_offset);
+
+    TEST_ASSERT_EQUAL(1, parser.Feed(test_message_buffer, valid_offset + valid_bytes, CollectFrame, &received));
+
+    TEST_ASSERT_EQUAL(1, received.count);
+    TEST_ASSERT_EQUAL(0x03, received.areas[0]);
+    TEST_ASSERT_EQUAL(1, parser.GetRejectedFrames());
+    TEST_ASSERT_EQUAL(valid_offset, parser.GetDiscardedBytes());
+    TEST_ASSERT_FALSE(parser.HasPartialFrame());
+}
+
+void test_ParserResyncKeepsFramesBehindFalseStart() {
+    TitaniumProtocol protocol;
+    TitaniumFrameParser parser;
+    ReceivedFrames received;
+    uint8_t payload[5]              = {'L', 'U', 'C', 'A', 'S'};
+    uint8_t test_message_buffer[64] = {0xAA, Protocol::START_BYTE};
+    uint8_t garbage_bytes           = 1;
+
+    /* A stray start byte whose header announces a payload longer than everything behind it. */
+    test_message_buffer[garbage_bytes + ProtocolAttributes::PAYLOAD_LENGTH_OFFSET] = 0x60;
+
+    auto valid_offset = garbage_bytes + ProtocolAttributes::HEADER_OFFSET;
+    auto valid_bytes  = protocol.Encode(0x1015, 0x03, payload, sizeof(payload), test_message_buffer + valid_offset,
+                                        sizeof(test_message_buffer) - valid_offset);
+
+    TEST_ASSERT_EQUAL(0, parser.Feed(test_message_buffer, valid_offset + valid_bytes, CollectFrame, &received));
+    TEST_ASSERT_TRUE(parser.HasPartialFrame());
+
+    TEST_ASSERT_EQUAL(1, parser.Resync(CollectFrame, &received));
+
+    TEST_ASSERT_EQUAL(1, received.count);
+    TEST_ASSERT_EQUAL(0x03, received.areas[0]);
+    TEST_ASSERT_EQUAL(valid_bytes, received.sizes[0]);
+    TEST_ASSERT_EQUAL(1, parser.GetRejectedFrames());
+    TEST_ASSERT_EQUAL(valid_offset, parser.GetDiscardedBytes());
+    TEST_ASSERT_FALSE(parser.HasPartialFrame());
+}
+
 void main_test(void) {
     vTaskDelay(pdMS_TO_TICKS(2000));
 
@@ -160,6 +433,17 @@ void main_test(void) {
     RUN_TEST(test_EncodeHappyPath);
     RUN_TEST(test_EncodeEmptyBuffer);
     RUN_TEST(test_EncodeShortBuffer);
+    RUN_TEST(test_EncodeRawPayloadRoundTrip);
+    RUN_TEST(test_EncodeGathersSegments);
+    RUN_TEST(test_DecodeViewReadsPayloadInPlace);
+    RUN_TEST(test_EncodeDeltaRoundTrip);
+    RUN_TEST(test_DeltaRejectedOnStaleBaseline);
+    RUN_TEST(test_DeltaFallsBackWhenNotSmaller);
+    RUN_TEST(test_DecodeAllReturnsEveryFrame);
+    RUN_TEST(test_ParserReassemblesSplitFrame);
+    RUN_TEST(test_ParserSplitsMergedFrames);
+    RUN_TEST(test_ParserResynchronizesAfterCorruption);
+    RUN_TEST(test_ParserResyncKeepsFramesBehindFalseStart);
 
     UNITY_END();
 }
@@ -0,0 +1,1264 @@
+#include "HAL/memory/MessageBus.h"
+#include "HAL/memory/SharedMemory.h"
+#include "HAL/memory/SharedMemoryManager.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "nvs_flash.h"
+#include "unity.h"
+
+static const char* TAG = "SharedMemoryBenchmark";
+
+namespace Benchmark {
+    constexpr uint16_t AREA_SIZE         = 64;   /**< Size of the area exercised by the benchmark. */
+    constexpr uint8_t MAXIMUM_READERS    = 4;    /**< Maximum amount of concurrent readers. */
+    constexpr uint32_t DURATION_MS       = 1000; /**< Duration of each benchmark run. */
+    constexpr uint8_t HISTOGRAM_BUCKETS  = 16;   /**< Power of two latency buckets, in microseconds. */
+    constexpr uint32_t WRITER_PERIOD_MS  = 1;    /**< Delay between two writes. */
+    constexpr uint32_t CACHE_READS       = 1000; /**< Reads timed per decode path. */
+    constexpr uint16_t CACHE_AREA_SIZE   = CONTINUOS_PACKET_LIST_SIZE; /**< Fits every message used by the cache benchmark. */
+    constexpr uint16_t LARGE_AREA_SIZE   = 1024; /**< Area well beyond the former 255 bytes limit. */
+    constexpr uint16_t CHUNK_SIZE        = 100;  /**< Size of the chunks streamed in and out of the large area. */
+    constexpr uint16_t RING_RECORD_SIZE  = sizeof(uint32_t); /**< Payload of the ring records. */
+    constexpr uint16_t RING_CAPACITY     = 4;    /**< Records kept by the ring under test. */
+    constexpr uint32_t HOLD_MS           = 20;   /**< Time an area is held to force a contended write. */
+    constexpr uint32_t SECTION_US        = 200;  /**< Critical section of the low priority holder in the stress test. */
+    constexpr uint32_t HOG_BURST_US      = 5000; /**< CPU burst of the middle priority task in the stress test. */
+    constexpr uint32_t LOCK_TIMEOUT_MS   = 10;   /**< Bounded wait of the high priority writer in the stress test. */
+    constexpr UBaseType_t HOLDER_PRIORITY = 2;   /**< Low priority consumer holding the area. */
+    constexpr UBaseType_t HOG_PRIORITY    = 4;   /**< Middle priority task that never touches the area. */
+    constexpr UBaseType_t URGENT_PRIORITY = 6;   /**< High priority writer, stands for the communication process. */
+}  // namespace Benchmark
+
+/**
+ * @brief Per task state shared between the benchmark and the spawned tasks.
+ */
+struct BenchmarkContext {
+    SharedMemory* area             = nullptr;
+    volatile bool running          = false;
+    volatile bool finished         = false;
+    uint32_t operations            = 0;
+    uint32_t torn_reads            = 0;
+    uint32_t max_latency_us        = 0;
+    uint32_t timeouts              = 0;
+    uint32_t histogram[Benchmark::HISTOGRAM_BUCKETS] = {0};
+};
+
+void setUp(void) {
+    // set stuff up here
+}
+
+void tearDown(void) {
+    // clean stuff up here
+}
+
+static uint8_t LatencyBucket(uint32_t latency_us) {
+    uint8_t bucket = 0;
+    while ((latency_us > 1) && (bucket < Benchmark::HISTOGRAM_BUCKETS - 1)) {
+        latency_us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static uint32_t LatencyPercentile(const uint32_t* histogram, uint32_t total, uint8_t percentile) {
+    uint32_t threshold  = (total * percentile) / 100;
+    uint32_t cumulative = 0;
+
+    for (uint8_t bucket = 0; bucket < Benchmark::HISTOGRAM_BUCKETS; bucket++) {
+        cumulative += histogram[bucket];
+        if (cumulative >= threshold) {
+            return 1 << bucket;
+        }
+    }
+    return 1 << (Benchmark::HISTOGRAM_BUCKETS - 1);
+}
+
+/**
+ * @brief Writer task, fills the whole area with a single incrementing byte so
+ * readers can detect a torn copy.
+ */
+static void WriterTask(void* parameters) {
+    auto context  = static_cast<BenchmarkContext*>(parameters);
+    uint8_t value = 0;
+    char buffer[Benchmark::AREA_SIZE];
+
+    while (context->running) {
+        value++;
+        memset(buffer, value, sizeof(buffer));
+        context->area->Write(buffer, sizeof(buffer));
+        context->operations++;
+        vTaskDelay(pdMS_TO_TICKS(Benchmark::WRITER_PERIOD_MS));
+    }
+
+    context->finished = true;
+    vTaskDelete(nullptr);
+}
+
+/**
+ * @brief Reader task, copies the area as fast as possible and records the
+ * latency of each read.
+ */
+static void ReaderTask(void* parameters) {
+    auto context = static_cast<BenchmarkContext*>(parameters);
+    char buffer[Benchmark::AREA_SIZE];
+
+    while (context->running) {
+        int64_t start = esp_timer_get_time();
+        auto result   = context->area->Read(buffer);
+        auto latency  = static_cast<uint32_t>(esp_timer_get_time() - start);
+
+        if (result == ESP_OK) {
+            for (uint16_t i = 1; i < sizeof(buffer); i++) {
+                if (buffer[i] != buffer[0]) {
+                    context->torn_reads++;
+                    break;
+                }
+            }
+        }
+
+        context->operations++;
+        context->histogram[LatencyBucket(latency)]++;
+        if (latency > context->max_latency_us) {
+            context->max_latency_us = latency;
+        }
+
+        if ((context->operations % 64) == 0) {
+            taskYIELD();
+        }
+    }
+
+    context->finished = true;
+    vTaskDelete(nullptr);
+}
+
+/**
+ * @brief Keeps the CPU busy without blocking.
+ *
+ * @param[in] duration_us Time to spin, in microseconds.
+ */
+static void Spin(uint32_t duration_us) {
+    int64_t end = esp_timer_get_time() + duration_us;
+    while (esp_timer_get_time() < end) {
+    }
+}
+
+/**
+ * @brief Low priority consumer, repeatedly borrows the area for a short
+ * critical section.
+ */
+static void HolderTask(void* parameters) {
+    auto context = static_cast<BenchmarkContext*>(parameters);
+
+    while (context->running) {
+        auto view = context->area->Borrow();
+        Spin(Benchmark::SECTION_US);
+        view.Release();
+
+        context->operations++;
+        vTaskDelay(1);
+    }
+
+    context->finished = true;
+    vTaskDelete(nullptr);
+}
+
+/**
+ * @brief Middle priority task that burns CPU, preempting the holder in the
+ * middle of its critical section unless the holder runs at the ceiling.
+ */
+static void HogTask(void* parameters) {
+    auto context = static_cast<BenchmarkContext*>(parameters);
+
+    while (context->running) {
+        Spin(Benchmark::HOG_BURST_US);
+        context->operations++;
+        vTaskDelay(1);
+    }
+
+    context->finished = true;
+    vTaskDelete(nullptr);
+}
+
+/**
+ * @brief High priority writer, records the latency of each bounded write.
+ */
+static void UrgentWriterTask(void* parameters) {
+    auto context = static_cast<BenchmarkContext*>(parameters);
+    char buffer[Benchmark::AREA_SIZE];
+
+    while (context->running) {
+        memset(buffer, context->operations, sizeof(buffer));
+
+        int64_t start = esp_timer_get_time();
+        auto result   = context->area->Write(buffer, sizeof(buffer), pdMS_TO_TICKS(Benchmark::LOCK_TIMEOUT_MS));
+        auto latency  = static_cast<uint32_t>(esp_timer_get_time() - start);
+
+        if (result == Error::LOCK_TIMEOUT) {
+            context->timeouts++;
+        }
+
+        context->operations++;
+        context->histogram[LatencyBucket(latency)]++;
+        if (latency > context->max_latency_us) {
+            context->max_latency_us = latency;
+        }
+
+        vTaskDelay(1);
+    }
+
+    context->finished = true;
+    vTaskDelete(nullptr);
+}
+
+/**
+ * @brief Times consecutive reads of an unchanged area.
+ *
+ * @return uint32_t Elapsed time in microseconds.
+ */
+template <typename T>
+static uint32_t MeasureReads(SharedMemory& area, T& message, const pb_msgdesc_t& msg_desc) {
+    int64_t start = esp_timer_get_time();
+
+    for (uint32_t i = 0; i < Benchmark::CACHE_READS; i++) {
+        area.Read(message, msg_desc);
+    }
+
+    return static_cast<uint32_t>(esp_timer_get_time() - start);
+}
+
+/**
+ * @brief Compares reads that run pb_decode against reads served by the decoded struct cache.
+ *
+ * @param[in] name Name of the message, used for logging.
+ * @param[in] written Message stored in the area.
+ * @param[in] msg_desc Descriptor of the message.
+ */
+template <typename T>
+static void RunDecodedCacheBenchmark(const char* name, T& written, const pb_msgdesc_t& msg_desc) {
+    static uint8_t storage[Benchmark::CACHE_AREA_SIZE];
+    alignas(T) static uint8_t cache[sizeof(T)];
+    T read{};
+
+    SharedMemory area(1, storage, sizeof(storage), READ_WRITE);
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Write(written, msg_desc));
+    auto decode_us = MeasureReads(area, read, msg_desc);
+
+    area.AttachCache(cache, sizeof(T), &msg_desc);
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Write(written, msg_desc));
+    auto cache_us = MeasureReads(area, read, msg_desc);
+    TEST_ASSERT_EQUAL_MEMORY(&written, &read, sizeof(T));
+
+    ESP_LOGI(TAG, "%-22s %4d bytes: pb_decode %6lu us, cache %6lu us for %lu reads",
+             name, area.GetWrittenBytes(), decode_us, cache_us, Benchmark::CACHE_READS);
+}
+
+/**
+ * @brief Runs one writer against a set of readers and reports throughput and latency.
+ *
+ * @param[in] read_mode Read mode of the area under test.
+ * @param[in] readers Amount of concurrent readers.
+ * @return uint32_t Amount of torn reads observed, expected to be zero.
+ */
+static uint32_t RunReadersBenchmark(ReadMode read_mode, uint8_t readers) {
+    uint8_t storage[Benchmark::AREA_SIZE];
+    SharedMemory area(1, storage, Benchmark::AREA_SIZE, READ_WRITE, read_mode);
+    BenchmarkContext writer_context{};
+    BenchmarkContext reader_context[Benchmark::MAXIMUM_READERS]{};
+    char initial[Benchmark::AREA_SIZE] = {0};
+
+    area.Write(initial, sizeof(initial));
+
+    writer_context.area    = &area;
+    writer_context.running = true;
+    xTaskCreatePinnedToCore(WriterTask, "bench_writer", 4096, &writer_context, 6, nullptr, 0);
+
+    for (uint8_t i = 0; i < readers; i++) {
+        reader_context[i].area    = &area;
+        reader_context[i].running = true;
+        xTaskCreatePinnedToCore(ReaderTask, "bench_reader", 4096, &reader_context[i], 5, nullptr, i % 2);
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(Benchmark::DURATION_MS));
+
+    writer_context.running = false;
+    for (uint8_t i = 0; i < readers; i++) {
+        reader_context[i].running = false;
+    }
+
+    while (!writer_context.finished) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    for (uint8_t i = 0; i < readers; i++) {
+        while (!reader_context[i].finished) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+    }
+
+    uint32_t total_reads = 0;
+    uint32_t torn_reads  = 0;
+    uint32_t max_latency = 0;
+    uint32_t histogram[Benchmark::HISTOGRAM_BUCKETS] = {0};
+
+    for (uint8_t i = 0; i < readers; i++) {
+        total_reads += reader_context[i].operations;
+        torn_reads += reader_context[i].torn_reads;
+        if (reader_context[i].max_latency_us > max_latency) {
+            max_latency = reader_context[i].max_latency_us;
+        }
+        for (uint8_t bucket = 0; bucket < Benchmark::HISTOGRAM_BUCKETS; bucket++) {
+            histogram[bucket] += reader_context[i].histogram[bucket];
+        }
+    }
+
+    ESP_LOGI(TAG, "%s readers=%d writes=%lu reads/s=%lu p50<=%luus p99<=%luus max=%luus torn=%lu",
+             read_mode == ReadMode::OPTIMISTIC ? "OPTIMISTIC" : "LOCKED",
+             readers,
+             writer_context.operations,
+             (total_reads * 1000) / Benchmark::DURATION_MS,
+             LatencyPercentile(histogram, total_reads, 50),
+             LatencyPercentile(histogram, total_reads, 99),
+             max_latency,
+             torn_reads);
+
+    return torn_reads;
+}
+
+void test_OptimisticReadDecodesLatestWrite() {
+    uint8_t storage[Benchmark::AREA_SIZE];
+    SharedMemory area(1, storage, Benchmark::AREA_SIZE, READ_WRITE, ReadMode::OPTIMISTIC);
+    char written[8] = {'T', 'I', 'T', 'A', 'N', 'I', 'U', 'M'};
+    char read[8]    = {0};
+
+    TEST_ASSERT_EQUAL(ESP_OK, area.Write(written, sizeof(written)));
+    TEST_ASSERT_EQUAL(ESP_OK, area.Read(read));
+
+    for (int i = 0; i < sizeof(written); i++) {
+        TEST_ASSERT_EQUAL(written[i], read[i]);
+    }
+}
+
+void test_SequenceIsEvenAfterWrite() {
+    uint8_t storage[Benchmark::AREA_SIZE];
+    SharedMemory area(1, storage, Benchmark::AREA_SIZE, READ_WRITE, ReadMode::OPTIMISTIC);
+    char written[4] = {1, 2, 3, 4};
+
+    TEST_ASSERT_EQUAL(0, area.GetSequence());
+    area.Write(written, sizeof(written));
+    TEST_ASSERT_EQUAL(2, area.GetSequence());
+    area.Write(written, sizeof(written));
+    TEST_ASSERT_EQUAL(4, area.GetSequence());
+}
+
+void test_ConsumersTrackUpdatesIndependently() {
+    auto manager       = SharedMemoryManager::GetInstance();
+    char written[4]    = {1, 2, 3, 4};
+    const uint8_t area = 0;
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(area, Benchmark::AREA_SIZE, READ_WRITE));
+
+    auto first  = manager->RegisterConsumer();
+    auto second = manager->RegisterConsumer();
+    TEST_ASSERT_NOT_EQUAL(MemoryConsumer::INVALID_CONSUMER, first);
+    TEST_ASSERT_NOT_EQUAL(MemoryConsumer::INVALID_CONSUMER, second);
+
+    TEST_ASSERT_FALSE(manager->HasChangedSince(first, area));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Write(area, written, sizeof(written)));
+
+    TEST_ASSERT_TRUE(manager->HasChangedSince(first, area));
+    TEST_ASSERT_FALSE(manager->HasChangedSince(first, area));
+    TEST_ASSERT_TRUE(manager->HasChangedSince(second, area));
+    TEST_ASSERT_EQUAL(1, manager->GetGeneration(area));
+}
+
+void test_SubscriberIsNotifiedOnWrite() {
+    auto manager       = SharedMemoryManager::GetInstance();
+    char written[4]    = {1, 2, 3, 4};
+    const uint8_t area = 1;
+
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(area, Benchmark::AREA_SIZE, READ_WRITE));
+
+    auto consumer = manager->RegisterConsumer();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Subscribe(consumer, area));
+    TEST_ASSERT_EQUAL(0, manager->WaitForUpdate(0));
+
+    int64_t start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Write(area, written, sizeof(written)));
+    TEST_ASSERT_EQUAL(1 << area, manager->WaitForUpdate(pdMS_TO_TICKS(100)));
+    ESP_LOGI(TAG, "write to wake up latency=%lldus", esp_timer_get_time() - start);
+
+    TEST_ASSERT_EQUAL(0, manager->WaitForUpdate(0));
+
+    /* Notifications on the default slot belong to the task and are left pending. */
+    xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Write(area, written, sizeof(written)));
+    TEST_ASSERT_EQUAL(1 << area, manager->WaitForUpdate(pdMS_TO_TICKS(100)));
+    TEST_ASSERT_EQUAL(1, ulTaskNotifyTake(pdTRUE, 0));
+
+    /* A wake up without an update returns before the timeout with no area set. */
+    TEST_ASSERT_EQUAL(ESP_OK, manager->WakeConsumer(consumer));
+    start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(0, manager->WaitForUpdate(pdMS_TO_TICKS(100)));
+    TEST_ASSERT_LESS_THAN(pdMS_TO_TICKS(100) * portTICK_PERIOD_MS * 1000, esp_timer_get_time() - start);
+}
+
+/**
+ * @brief Bus callback, keeps a reference to the last message it received.
+ */
+static void KeepMessage(const BusMessage& message, void* context) {
+    *static_cast<BusMessage*>(context) = message;
+}
+
+void test_BusFansOutOneCopyToEverySubscriber() {
+    auto manager       = SharedMemoryManager::GetInstance();
+    auto bus           = MessageBus::GetInstance();
+    char written[4]    = {5, 6, 7, 8};
+    const uint8_t area = 1;
+    BusMessage from_callback;
+    BusMessage from_queue[2];
+    QueueHandle_t queues[2];
+    subscriber_handle_t subscribers[3];
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(area, Benchmark::AREA_SIZE, READ_WRITE));
+
+    /* The bus stays started for the remaining tests. */
+    auto started = bus->Start(4096, 6);
+    TEST_ASSERT_TRUE((started == ESP_OK) || (started == ESP_ERR_INVALID_STATE));
+
+    subscribers[0] = bus->Subscribe(1UL << area, KeepMessage, &from_callback);
+    for (uint8_t i = 0; i < 2; i++) {
+        queues[i]          = xQueueCreate(2, MessageBus::QUEUE_ITEM_SIZE);
+        subscribers[i + 1] = bus->Subscribe(1UL << area, queues[i]);
+        TEST_ASSERT_NOT_EQUAL(Bus::INVALID_SUBSCRIBER, subscribers[i + 1]);
+    }
+
+    int64_t start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Write(area, written, sizeof(written)));
+    for (uint8_t i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE(MessageBus::Receive(queues[i], from_queue[i], pdMS_TO_TICKS(100)));
+    }
+    ESP_LOGI(TAG, "write to bus delivery latency=%lldus", esp_timer_get_time() - start);
+
+    /* Every subscriber references the same copy of the area. */
+    TEST_ASSERT_TRUE(from_callback.valid());
+    TEST_ASSERT_EQUAL_PTR(from_callback.data(), from_queue[0].data());
+    TEST_ASSERT_EQUAL_PTR(from_callback.data(), from_queue[1].data());
+    TEST_ASSERT_EQUAL(area, from_queue[0].area());
+    TEST_ASSERT_EQUAL(manager->GetGeneration(area), from_queue[0].generation());
+    TEST_ASSERT_EQUAL(sizeof(written), from_queue[0].size());
+    TEST_ASSERT_EQUAL_MEMORY(written, from_queue[0].data(), sizeof(written));
+
+    /* The payload stays valid after the area is overwritten. */
+    written[0] = 9;
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Write(area, written, sizeof(written)));
+    TEST_ASSERT_EQUAL(5, from_queue[1].data()[0]);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, bus->Unsubscribe(subscribers[i]));
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        while (MessageBus::Receive(queues[i], from_queue[i], pdMS_TO_TICKS(10))) {
+        }
+        from_queue[i].Release();
+        TEST_ASSERT_EQUAL(0, bus->GetDroppedMessages(subscribers[i + 1]));
+    }
+    from_callback.Release();
+
+    manager->Initialize();
+}
+
+void test_AreasAreCarvedFromAlignedArena() {
+    auto manager = SharedMemoryManager::GetInstance();
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(0, manager->GetArenaUsage());
+
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(0, 5, READ_WRITE));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(1, MemoryArena::ALIGNMENT + 1, READ_WRITE));
+    TEST_ASSERT_EQUAL(3 * MemoryArena::ALIGNMENT, manager->GetArenaUsage());
+
+    auto view = manager->Borrow(1);
+    TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(view.data()) % MemoryArena::ALIGNMENT);
+    view.Release();
+
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, manager->SignUpSharedArea(2, MemoryArena::SIZE, READ_WRITE));
+    manager->PrintMemoryMap();
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(0, manager->GetArenaUsage());
+}
+
+void test_ExternalAreasAreKeptOutOfTheArena() {
+    auto manager     = SharedMemoryManager::GetInstance();
+    uint32_t written = 0xCAFE;
+    uint32_t read    = 0;
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(0, Benchmark::AREA_SIZE, READ_WRITE, ReadMode::LOCKED,
+                                                        AreaPlacement::EXTERNAL));
+
+    /* Builds without PSRAM support place the area in the arena instead. */
+    if (manager->GetAreaPlacement(0) == AreaPlacement::EXTERNAL) {
+        TEST_ASSERT_EQUAL(0, manager->GetArenaUsage());
+        TEST_ASSERT_EQUAL(MemoryArena::Align(Benchmark::AREA_SIZE), manager->GetExternalUsage());
+    } else {
+        TEST_ASSERT_EQUAL(MemoryArena::Align(Benchmark::AREA_SIZE), manager->GetArenaUsage());
+        TEST_ASSERT_EQUAL(0, manager->GetExternalUsage());
+    }
+
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, manager->Write(0, reinterpret_cast<char*>(&written), sizeof(written)));
+    TEST_ASSERT_EQUAL(sizeof(read), manager->ReadChunk(0, 0, reinterpret_cast<uint8_t*>(&read), sizeof(read)));
+    TEST_ASSERT_EQUAL(written, read);
+
+    /* Optimistic areas are hot, they stay internal whatever the hint. */
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(1, Benchmark::AREA_SIZE, READ_WRITE, ReadMode::OPTIMISTIC,
+                                                        AreaPlacement::EXTERNAL));
+    TEST_ASSERT_EQUAL(AreaPlacement::INTERNAL, manager->GetAreaPlacement(1));
+    manager->PrintMemoryMap();
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(0, manager->GetExternalUsage());
+    TEST_ASSERT_EQUAL(AreaPlacement::INTERNAL, manager->GetAreaPlacement(0));
+}
+
+void test_RegisteredAreaRoundTrip() {
+    auto manager = SharedMemoryManager::GetInstance();
+    network_information_t written{};
+    network_information_t read{};
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(Error::NULL_PTR, manager->Write<MEMORY_AREAS_NETWORK_INFORMATION>(written));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_NETWORK_INFORMATION>());
+    TEST_ASSERT_EQUAL(NETWORK_INFORMATION_SIZE, manager->GetAreaSize(MEMORY_AREAS_NETWORK_INFORMATION));
+
+    written.ap_connected  = NETWORK_STATUS_CONNECTED;
+    written.sta_connected = NETWORK_STATUS_DISCONNECTED;
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, manager->Write<MEMORY_AREAS_NETWORK_INFORMATION>(written));
+    TEST_ASSERT_NOT_EQUAL(0, manager->Read<MEMORY_AREAS_NETWORK_INFORMATION>(read));
+    TEST_ASSERT_EQUAL(written.ap_connected, read.ap_connected);
+    TEST_ASSERT_EQUAL(written.sta_connected, read.sta_connected);
+
+    manager->Initialize();
+}
+
+void test_WriteLeaseAndReadViewShareAreaStorage() {
+    uint8_t storage[Benchmark::AREA_SIZE];
+    SharedMemory area(1, storage, Benchmark::AREA_SIZE, READ_WRITE, ReadMode::OPTIMISTIC);
+    uint8_t written[4] = {1, 2, 3, 4};
+
+    {
+        auto lease = area.Lease();
+        TEST_ASSERT_TRUE(lease.valid());
+        TEST_ASSERT_EQUAL(Benchmark::AREA_SIZE, lease.capacity());
+        TEST_ASSERT_EQUAL(1, area.GetSequence() & 1);
+
+        memcpy(lease.data(), written, sizeof(written));
+        TEST_ASSERT_EQUAL(Error::BUFFER_OUT_OF_SPACE, lease.Commit(Benchmark::AREA_SIZE + 1));
+        TEST_ASSERT_EQUAL(Error::NO_ERROR, lease.Commit(sizeof(written)));
+    }
+
+    TEST_ASSERT_EQUAL(1, area.GetGeneration());
+
+    auto view = area.Borrow();
+    TEST_ASSERT_TRUE(view.valid());
+    TEST_ASSERT_EQUAL(sizeof(written), view.size());
+    TEST_ASSERT_EQUAL_MEMORY(written, view.data(), sizeof(written));
+    view.Release();
+    TEST_ASSERT_FALSE(view.valid());
+
+    uint8_t write_only_storage[Benchmark::AREA_SIZE];
+    SharedMemory write_only(2, write_only_storage, Benchmark::AREA_SIZE, WRITE_ONLY);
+    TEST_ASSERT_FALSE(write_only.Borrow().valid());
+}
+
+/**
+ * @brief Commit callback, counts the leases reported as written.
+ */
+static void CountCommit(void* context, uint8_t area_index) {
+    (*static_cast<uint8_t*>(context))++;
+}
+
+void test_UncommittedLeaseIsNotAWrite() {
+    uint8_t storage[Benchmark::AREA_SIZE];
+    SharedMemory area(1, storage, Benchmark::AREA_SIZE, READ_WRITE, ReadMode::OPTIMISTIC);
+    char written[4]  = {1, 2, 3, 4};
+    uint8_t commits  = 0;
+
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Write(written, sizeof(written)));
+    auto sequence = area.GetSequence();
+
+    {
+        auto lease = area.Lease(CountCommit, &commits);
+        TEST_ASSERT_TRUE(lease.valid());
+        TEST_ASSERT_EQUAL(1, area.GetSequence() & 1);
+    }
+
+    TEST_ASSERT_EQUAL(sequence, area.GetSequence());
+    TEST_ASSERT_EQUAL(1, area.GetGeneration());
+    TEST_ASSERT_EQUAL(0, commits);
+
+    {
+        auto lease = area.Lease(CountCommit, &commits);
+        TEST_ASSERT_EQUAL(Error::NO_ERROR, lease.Commit(sizeof(written)));
+    }
+
+    TEST_ASSERT_EQUAL(2, area.GetGeneration());
+    TEST_ASSERT_EQUAL(1, commits);
+
+    /* The storage may be torn, a reader that sampled the old sequence must retry. */
+    {
+        auto lease = area.Lease(CountCommit, &commits);
+        lease.data()[0] = 9;
+    }
+
+    TEST_ASSERT_EQUAL(0, area.GetSequence() & 1);
+    TEST_ASSERT_EQUAL(3, area.GetGeneration());
+    TEST_ASSERT_EQUAL(1, commits);
+}
+
+void test_MessagesLargerThan255BytesAreNotTruncated() {
+    uint8_t storage[BROKER_CONFIG_SIZE];
+    broker_config_t written{};
+    broker_config_t read{};
+
+    SharedMemory area(1, storage, BROKER_CONFIG_SIZE, READ_WRITE);
+    memset(written.broker_uri, 'm', sizeof(written.broker_uri) - 1);
+
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Write(written, broker_config_t_msg));
+    TEST_ASSERT_GREATER_THAN(255, area.GetWrittenBytes());
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Read(read, broker_config_t_msg));
+    TEST_ASSERT_EQUAL_STRING(written.broker_uri, read.broker_uri);
+}
+
+void test_LargeAreaIsStreamedInChunks() {
+    static uint8_t storage[Benchmark::LARGE_AREA_SIZE];
+    uint8_t chunk[Benchmark::CHUNK_SIZE];
+    uint16_t offset = 0;
+
+    SharedMemory area(1, storage, Benchmark::LARGE_AREA_SIZE, READ_WRITE, ReadMode::OPTIMISTIC);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, area.WriteChunk(Benchmark::CHUNK_SIZE, chunk, sizeof(chunk)));
+    for (offset = 0; offset + sizeof(chunk) <= Benchmark::LARGE_AREA_SIZE; offset += sizeof(chunk)) {
+        for (uint16_t i = 0; i < sizeof(chunk); i++) {
+            chunk[i] = static_cast<uint8_t>(offset + i);
+        }
+        TEST_ASSERT_EQUAL(Error::NO_ERROR, area.WriteChunk(offset, chunk, sizeof(chunk)));
+    }
+    TEST_ASSERT_EQUAL(Error::BUFFER_OUT_OF_SPACE, area.WriteChunk(offset, chunk, sizeof(chunk)));
+    TEST_ASSERT_EQUAL(offset, area.GetWrittenBytes());
+
+    uint16_t read_bytes = 0;
+    uint16_t copied     = 0;
+    while ((copied = area.ReadChunk(read_bytes, chunk, sizeof(chunk))) > 0) {
+        for (uint16_t i = 0; i < copied; i++) {
+            TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(read_bytes + i), chunk[i]);
+        }
+        read_bytes += copied;
+    }
+    TEST_ASSERT_EQUAL(area.GetWrittenBytes(), read_bytes);
+
+    {
+        auto lease = area.Lease();
+        memset(chunk, 0xA5, sizeof(chunk));
+        while (lease.Append(chunk, sizeof(chunk)) == Error::NO_ERROR) {
+        }
+        TEST_ASSERT_EQUAL(Error::NO_ERROR, lease.Commit());
+    }
+    TEST_ASSERT_EQUAL((Benchmark::LARGE_AREA_SIZE / Benchmark::CHUNK_SIZE) * Benchmark::CHUNK_SIZE, area.GetWrittenBytes());
+}
+
+void test_RingAreaKeepsHistoryAndCountsOverflows() {
+    alignas(RingRecordHeader) uint8_t storage[SharedMemory::RingStorageSize(Benchmark::RING_RECORD_SIZE, Benchmark::RING_CAPACITY)];
+    uint8_t records[sizeof(storage)];
+    uint32_t cursor = 0;
+    uint32_t missed = 0;
+
+    SharedMemory area(1, storage, sizeof(storage), READ_WRITE);
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.ConfigureRing(Benchmark::RING_RECORD_SIZE));
+    TEST_ASSERT_EQUAL(Benchmark::RING_CAPACITY, area.GetRingCapacity());
+
+    for (uint32_t value = 0; value < Benchmark::RING_CAPACITY + 2; value++) {
+        TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Append(reinterpret_cast<uint8_t*>(&value), sizeof(value)));
+    }
+    TEST_ASSERT_EQUAL(2, area.GetOverwrittenRecords());
+    TEST_ASSERT_EQUAL(Error::BUFFER_OUT_OF_SPACE, area.Append(records, Benchmark::RING_RECORD_SIZE + 1));
+    TEST_ASSERT_EQUAL(1, area.GetRejectedRecords());
+    TEST_ASSERT_NOT_EQUAL(Error::NO_ERROR, area.Write(reinterpret_cast<char*>(records), sizeof(uint32_t)));
+
+    auto copied = area.ReadSince(cursor, records, sizeof(records), &missed);
+    TEST_ASSERT_EQUAL(Benchmark::RING_CAPACITY * (sizeof(RingRecordHeader) + Benchmark::RING_RECORD_SIZE), copied);
+    TEST_ASSERT_EQUAL(2, missed);
+    TEST_ASSERT_EQUAL(Benchmark::RING_CAPACITY + 2, cursor);
+
+    for (uint16_t offset = 0, expected = 2; offset < copied; expected++) {
+        RingRecordHeader header;
+        uint32_t value = 0;
+        memcpy(&header, records + offset, sizeof(header));
+        memcpy(&value, records + offset + sizeof(header), sizeof(value));
+
+        TEST_ASSERT_EQUAL(expected, header.sequence);
+        TEST_ASSERT_EQUAL(expected, value);
+        offset += sizeof(header) + header.length;
+    }
+
+    TEST_ASSERT_EQUAL(0, area.ReadSince(cursor, records, sizeof(records), &missed));
+}
+
+/**
+ * @brief Writes the same counter to two areas in one transaction until stopped.
+ */
+static void TransactionWriterTask(void* parameters) {
+    auto context   = static_cast<BenchmarkContext*>(parameters);
+    auto manager   = SharedMemoryManager::GetInstance();
+    uint32_t value = 0;
+
+    while (context->running) {
+        value++;
+        auto transaction = manager->Transaction({3, 1});
+        transaction.Write(1, reinterpret_cast<uint8_t*>(&value), sizeof(value));
+        transaction.Write(3, reinterpret_cast<uint8_t*>(&value), sizeof(value));
+        transaction.Commit();
+        context->operations++;
+    }
+
+    context->finished = true;
+    vTaskDelete(nullptr);
+}
+
+void test_SnapshotsSeeTransactionsAtomically() {
+    auto manager = SharedMemoryManager::GetInstance();
+    BenchmarkContext writer_context;
+    uint32_t snapshots = 0;
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(1, sizeof(uint32_t), READ_WRITE));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(3, sizeof(uint32_t), READ_WRITE));
+    TEST_ASSERT_FALSE(manager->Snapshot({1, 2}).valid());
+
+    writer_context.running = true;
+    xTaskCreatePinnedToCore(TransactionWriterTask, "tx_writer", 4096, &writer_context, 5, nullptr, 0);
+
+    int64_t deadline = esp_timer_get_time() + Benchmark::DURATION_MS * 1000;
+    while (esp_timer_get_time() < deadline) {
+        auto snapshot = manager->Snapshot({1, 3, 1});
+        TEST_ASSERT_TRUE(snapshot.valid());
+        TEST_ASSERT_EQUAL(snapshot.size(1), snapshot.size(3));
+        if (snapshot.size(1) > 0) {
+            TEST_ASSERT_EQUAL_MEMORY(snapshot.data(1), snapshot.data(3), snapshot.size(1));
+        }
+        snapshot.Release();
+
+        if ((++snapshots % 64) == 0) {
+            vTaskDelay(1);
+        }
+    }
+
+    writer_context.running = false;
+    while (!writer_context.finished) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    ESP_LOGI(TAG, "%lu transactions, %lu snapshots", writer_context.operations, snapshots);
+    manager->Initialize();
+}
+
+void test_FailedTransactionWritesNothing() {
+    auto manager  = SharedMemoryManager::GetInstance();
+    uint8_t value = 7;
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(1, sizeof(uint32_t), READ_WRITE));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(3, sizeof(uint32_t), READ_WRITE));
+
+    auto consumer = manager->RegisterConsumer();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Subscribe(consumer, 1));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Subscribe(consumer, 3));
+    manager->WaitForUpdate(0);
+
+    /* Areas 1 and 3 are leased before area 4, which is not signed up, fails the transaction. */
+    auto transaction = manager->Transaction({1, 3, 4});
+    TEST_ASSERT_FALSE(transaction.valid());
+    TEST_ASSERT_EQUAL(0, manager->GetGeneration(1));
+    TEST_ASSERT_EQUAL(0, manager->GetGeneration(3));
+    TEST_ASSERT_FALSE(manager->HasChangedSince(consumer, 1));
+    TEST_ASSERT_EQUAL(0, manager->WaitForUpdate(0));
+
+    /* A write that does not fit is refused before the area is touched. */
+    transaction = manager->Transaction({1, 3});
+    TEST_ASSERT_TRUE(transaction.valid());
+    TEST_ASSERT_EQUAL(Error::BUFFER_OUT_OF_SPACE, transaction.Write(3, &value, sizeof(uint32_t) + 1));
+
+    /* An aborted transaction writes and publishes nothing, even the writes it staged. */
+    TEST_ASSERT_EQUAL(ESP_OK, transaction.Write(1, &value, sizeof(value)));
+    transaction.Abort();
+
+    TEST_ASSERT_EQUAL(0, manager->GetGeneration(1));
+    TEST_ASSERT_EQUAL(0, manager->GetGeneration(3));
+    TEST_ASSERT_EQUAL(0, manager->GetWrittenBytes(1));
+    TEST_ASSERT_EQUAL(0, manager->WaitForUpdate(0));
+
+    /* Only Commit writes the staged areas. */
+    transaction = manager->Transaction({1, 3});
+    TEST_ASSERT_EQUAL(ESP_OK, transaction.Write(1, &value, sizeof(value)));
+    TEST_ASSERT_EQUAL(0, manager->GetGeneration(1));
+    TEST_ASSERT_EQUAL(ESP_OK, transaction.Commit());
+
+    TEST_ASSERT_EQUAL(1, manager->GetGeneration(1));
+    TEST_ASSERT_EQUAL(0, manager->GetGeneration(3));
+    TEST_ASSERT_EQUAL(sizeof(value), manager->GetWrittenBytes(1));
+    TEST_ASSERT_EQUAL(1 << 1, manager->WaitForUpdate(0));
+
+    manager->Initialize();
+}
+
+static void AreaHolderTask(void* parameters) {
+    auto context = static_cast<BenchmarkContext*>(parameters);
+    auto view    = SharedMemoryManager::GetInstance()->Borrow(1);
+
+    context->running = true;
+    vTaskDelay(pdMS_TO_TICKS(Benchmark::HOLD_MS));
+    view.Release();
+
+    context->finished = true;
+    vTaskDelete(nullptr);
+}
+
+void test_CountersTrackAccessesAndContention() {
+    auto manager   = SharedMemoryManager::GetInstance();
+    uint32_t value = 42;
+    AreaCounters counters;
+    BenchmarkContext holder_context;
+    area_diagnostics_t diagnostics{};
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(1, sizeof(uint32_t), READ_WRITE));
+
+    if (manager->GetAreaCounters(1, counters) == ESP_ERR_NOT_SUPPORTED) {
+        manager->Initialize();
+        TEST_IGNORE_MESSAGE("Built without TITANIUM_AREA_STATISTICS");
+    }
+
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, manager->Write(1, reinterpret_cast<char*>(&value), sizeof(value)));
+    TEST_ASSERT_EQUAL(sizeof(value), manager->Read(1, reinterpret_cast<char*>(&value), sizeof(value)));
+
+    /* Another task holds the area, the next write has to wait for it. */
+    xTaskCreatePinnedToCore(AreaHolderTask, "area_holder", 4096, &holder_context, 5, nullptr, 0);
+    while (!holder_context.running) {
+        vTaskDelay(1);
+    }
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, manager->Write(1, reinterpret_cast<char*>(&value), sizeof(value)));
+    while (!holder_context.finished) {
+        vTaskDelay(1);
+    }
+
+    TEST_ASSERT_EQUAL(ESP_OK, manager->GetAreaCounters(1, counters));
+    TEST_ASSERT_EQUAL(2, counters.writes);
+    TEST_ASSERT_EQUAL(2, counters.reads);
+    TEST_ASSERT_EQUAL(2 * sizeof(value), counters.bytes_written);
+    TEST_ASSERT_EQUAL(1, counters.contended);
+    TEST_ASSERT_GREATER_OR_EQUAL(Benchmark::HOLD_MS * 1000 / 2, counters.wait_max_us);
+    TEST_ASSERT_EQUAL_STRING(pcTaskGetName(nullptr), counters.last_writer);
+
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_AREA_DIAGNOSTICS>());
+    TEST_ASSERT_EQUAL(ESP_OK, manager->PublishDiagnostics());
+    TEST_ASSERT_NOT_EQUAL(0, manager->Read<MEMORY_AREAS_AREA_DIAGNOSTICS>(diagnostics));
+    TEST_ASSERT_EQUAL(2, diagnostics.areas_count);
+    TEST_ASSERT_EQUAL(1, diagnostics.areas[0].area);
+    TEST_ASSERT_EQUAL(2, diagnostics.areas[0].writes);
+
+    manager->DumpAreaCounters();
+    manager->Initialize();
+}
+
+static void AreaViewHolderTask(void* parameters) {
+    auto context = static_cast<BenchmarkContext*>(parameters);
+    auto view    = context->area->Borrow();
+
+    context->running = true;
+    vTaskDelay(pdMS_TO_TICKS(Benchmark::HOLD_MS));
+    view.Release();
+
+    context->finished = true;
+    vTaskDelete(nullptr);
+}
+
+void test_BoundedLockTimesOutWhileAreaIsHeld() {
+    uint8_t storage[Benchmark::AREA_SIZE];
+    SharedMemory area(1, storage, Benchmark::AREA_SIZE, READ_WRITE);
+    BenchmarkContext holder_context;
+    network_information_t information{};
+    char buffer[Benchmark::AREA_SIZE] = {0};
+
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Write(buffer, 8));
+
+    holder_context.area = &area;
+    xTaskCreatePinnedToCore(AreaViewHolderTask, "area_holder", 4096, &holder_context, 5, nullptr, 0);
+    while (!holder_context.running) {
+        vTaskDelay(1);
+    }
+
+    /* A failed lock leaves the area untouched and reports the timeout. */
+    int64_t start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(Error::LOCK_TIMEOUT, area.Write(buffer, sizeof(buffer), AreaLock::NO_WAIT));
+    TEST_ASSERT_EQUAL(Error::LOCK_TIMEOUT, area.Write(information, network_information_t_msg, pdMS_TO_TICKS(1)));
+    TEST_ASSERT_EQUAL(Error::LOCK_TIMEOUT, area.Read(buffer, AreaLock::NO_WAIT));
+    TEST_ASSERT_EQUAL(Error::LOCK_TIMEOUT, area.Read(information, network_information_t_msg, AreaLock::NO_WAIT));
+    TEST_ASSERT_FALSE(area.Borrow(AreaLock::NO_WAIT).valid());
+    TEST_ASSERT_FALSE(area.Lease(nullptr, nullptr, AreaLock::NO_WAIT).valid());
+    TEST_ASSERT_LESS_THAN(Benchmark::HOLD_MS * 1000, esp_timer_get_time() - start);
+    TEST_ASSERT_EQUAL(8, area.GetWrittenBytes());
+
+    while (!holder_context.finished) {
+        vTaskDelay(1);
+    }
+
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Write(buffer, sizeof(buffer), AreaLock::NO_WAIT));
+    TEST_ASSERT_EQUAL(sizeof(buffer), area.GetWrittenBytes());
+}
+
+/**
+ * @brief Runs a low priority holder, a middle priority hog and a high priority
+ * writer on the same core and reports the worst write latency.
+ *
+ * @param[in] ceiling Priority ceiling of the area.
+ * @param[out] timeouts Writes that gave up on the lock.
+ * @return uint32_t Longest write, in microseconds.
+ */
+static uint32_t RunPriorityStress(UBaseType_t ceiling, uint32_t& timeouts) {
+    uint8_t storage[Benchmark::AREA_SIZE];
+    SharedMemory area(1, storage, Benchmark::AREA_SIZE, READ_WRITE);
+    BenchmarkContext contexts[3]{};
+    TaskFunction_t tasks[3]       = {HolderTask, HogTask, UrgentWriterTask};
+    const char* names[3]          = {"stress_holder", "stress_hog", "stress_urgent"};
+    UBaseType_t priorities[3]     = {Benchmark::HOLDER_PRIORITY, Benchmark::HOG_PRIORITY, Benchmark::URGENT_PRIORITY};
+    auto& urgent                  = contexts[2];
+
+    area.SetPriorityCeiling(ceiling);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        contexts[i].area    = &area;
+        contexts[i].running = true;
+        xTaskCreatePinnedToCore(tasks[i], names[i], 4096, &contexts[i], priorities[i], nullptr, 1);
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(Benchmark::DURATION_MS));
+
+    for (uint8_t i = 0; i < 3; i++) {
+        contexts[i].running = false;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        while (!contexts[i].finished) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+    }
+
+    ESP_LOGI(TAG, "ceiling=%d holds=%lu bursts=%lu writes=%lu p50<=%luus p99<=%luus max=%luus timeouts=%lu",
+             ceiling,
+             contexts[0].operations,
+             contexts[1].operations,
+             urgent.operations,
+             LatencyPercentile(urgent.histogram, urgent.operations, 50),
+             LatencyPercentile(urgent.histogram, urgent.operations, 99),
+             urgent.max_latency_us,
+             urgent.timeouts);
+
+    timeouts = urgent.timeouts;
+    return urgent.max_latency_us;
+}
+
+void test_HighPriorityWriterLatencyIsBounded() {
+    uint32_t timeouts = 0;
+
+    /* Priority inheritance alone, the holder may be preempted inside the section. */
+    auto inherited = RunPriorityStress(AreaLock::NO_CEILING, timeouts);
+    TEST_ASSERT_EQUAL(0, timeouts);
+    TEST_ASSERT_LESS_THAN(Benchmark::LOCK_TIMEOUT_MS * 1000, inherited);
+
+    /* With a ceiling the section always runs to completion before the hog. */
+    auto ceiling = RunPriorityStress(Benchmark::URGENT_PRIORITY, timeouts);
+    TEST_ASSERT_EQUAL(0, timeouts);
+    TEST_ASSERT_LESS_THAN(Benchmark::LOCK_TIMEOUT_MS * 1000, ceiling);
+}
+
+void test_CeilingIsKeptUntilLastAreaIsReleased() {
+    uint8_t outer_storage[Benchmark::AREA_SIZE];
+    uint8_t inner_storage[Benchmark::AREA_SIZE];
+    SharedMemory outer(1, outer_storage, Benchmark::AREA_SIZE, READ_WRITE);
+    SharedMemory inner(2, inner_storage, Benchmark::AREA_SIZE, READ_WRITE);
+    auto priority = uxTaskPriorityGet(nullptr);
+
+    outer.SetPriorityCeiling(Benchmark::HOG_PRIORITY);
+    inner.SetPriorityCeiling(Benchmark::URGENT_PRIORITY);
+    vTaskPrioritySet(nullptr, Benchmark::HOLDER_PRIORITY);
+
+    auto outer_lease = outer.Lease();
+    auto inner_lease = inner.Lease();
+    TEST_ASSERT_EQUAL(Benchmark::URGENT_PRIORITY, uxTaskPriorityGet(nullptr));
+
+    /* Released out of order, the task keeps the ceiling it still holds. */
+    outer_lease.Release();
+    TEST_ASSERT_EQUAL(Benchmark::URGENT_PRIORITY, uxTaskPriorityGet(nullptr));
+    inner_lease.Release();
+    TEST_ASSERT_EQUAL(Benchmark::HOLDER_PRIORITY, uxTaskPriorityGet(nullptr));
+
+    vTaskPrioritySet(nullptr, priority);
+}
+
+void test_WriteFieldPatchesNestedField() {
+    auto manager = SharedMemoryManager::GetInstance();
+    continuos_packet_list_t written{};
+    continuos_packet_list_t read{};
+    packet_request_t appended{};
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_UART_CONTINUOS_PACKET>());
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SetPersistence(MEMORY_AREAS_UART_CONTINUOS_PACKET, false));
+
+    written.packet_configs_count                  = 1;
+    written.packet_configs[0].destination_address = 7;
+    written.packet_configs[0].packet_interval     = 1000;
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, manager->Write<MEMORY_AREAS_UART_CONTINUOS_PACKET>(written));
+    auto generation = manager->GetGeneration(MEMORY_AREAS_UART_CONTINUOS_PACKET);
+
+    uint32_t interval = 250;
+    TEST_ASSERT_EQUAL(ESP_OK, (manager->WriteField<MEMORY_AREAS_UART_CONTINUOS_PACKET>(
+                                  {CONTINUOS_PACKET_LIST_PACKET_CONFIGS_TAG, 0, PACKET_REQUEST_PACKET_INTERVAL_TAG}, interval)));
+    TEST_ASSERT_EQUAL(generation + 1, manager->GetGeneration(MEMORY_AREAS_UART_CONTINUOS_PACKET));
+
+    appended.destination_address = 9;
+    TEST_ASSERT_EQUAL(ESP_OK, (manager->WriteField<MEMORY_AREAS_UART_CONTINUOS_PACKET>(
+                                  {CONTINUOS_PACKET_LIST_PACKET_CONFIGS_TAG, 1}, appended)));
+
+    TEST_ASSERT_NOT_EQUAL(0, manager->Read<MEMORY_AREAS_UART_CONTINUOS_PACKET>(read));
+    TEST_ASSERT_EQUAL(2, read.packet_configs_count);
+    TEST_ASSERT_EQUAL(7, read.packet_configs[0].destination_address);
+    TEST_ASSERT_EQUAL(250, read.packet_configs[0].packet_interval);
+    TEST_ASSERT_EQUAL(9, read.packet_configs[1].destination_address);
+
+    /* Invalid patches leave the area untouched. */
+    generation = manager->GetGeneration(MEMORY_AREAS_UART_CONTINUOS_PACKET);
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, (manager->WriteField<MEMORY_AREAS_UART_CONTINUOS_PACKET>({42}, interval)));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, (manager->WriteField<MEMORY_AREAS_UART_CONTINUOS_PACKET>(
+                                               {CONTINUOS_PACKET_LIST_PACKET_CONFIGS_TAG, 5, PACKET_REQUEST_PACKET_INTERVAL_TAG}, interval)));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, (manager->WriteField<MEMORY_AREAS_UART_CONTINUOS_PACKET>(
+                                                {CONTINUOS_PACKET_LIST_PACKET_CONFIGS_TAG, 0, PACKET_REQUEST_PACKET_INTERVAL_TAG}, (uint8_t)1)));
+    TEST_ASSERT_EQUAL(generation, manager->GetGeneration(MEMORY_AREAS_UART_CONTINUOS_PACKET));
+
+    manager->Initialize();
+}
+
+void test_PersistentAreaIsRestoredAfterReboot() {
+    auto manager = SharedMemoryManager::GetInstance();
+    network_credentials_t written{};
+    network_credentials_t read{};
+
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_init());
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_NETWORK_CREDENTIALS>());
+
+    strcpy(written.ssid, "titanium");
+    strcpy(written.password, "persisted");
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, manager->Write<MEMORY_AREAS_NETWORK_CREDENTIALS>(written));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->FlushPersistentAreas());
+
+    /* Simulates a reboot: the areas are signed up again empty and restored on the first read. */
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_NETWORK_CREDENTIALS>());
+    TEST_ASSERT_EQUAL(0, manager->GetWrittenBytes(MEMORY_AREAS_NETWORK_CREDENTIALS));
+    TEST_ASSERT_NOT_EQUAL(0, manager->Read<MEMORY_AREAS_NETWORK_CREDENTIALS>(read));
+    TEST_ASSERT_EQUAL_STRING(written.ssid, read.ssid);
+    TEST_ASSERT_EQUAL_STRING(written.password, read.password);
+
+    /* A write before the first read wins over the stored copy. */
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_NETWORK_CREDENTIALS>());
+    strcpy(written.ssid, "fresh");
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, manager->Write<MEMORY_AREAS_NETWORK_CREDENTIALS>(written));
+    TEST_ASSERT_NOT_EQUAL(0, manager->Read<MEMORY_AREAS_NETWORK_CREDENTIALS>(read));
+    TEST_ASSERT_EQUAL_STRING("fresh", read.ssid);
+
+    manager->Initialize();
+}
+
+void test_SnapshotRestoresPersistentAreasFirst() {
+    auto manager    = SharedMemoryManager::GetInstance();
+    char first[4]   = {1, 2, 3, 4};
+    char second[4]  = {5, 6, 7, 8};
+
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_init());
+
+    manager->Initialize();
+    for (uint8_t area : {1, 3}) {
+        TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(area, sizeof(first), READ_WRITE));
+        TEST_ASSERT_EQUAL(ESP_OK, manager->SetPersistence(area, true));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Write(1, first, sizeof(first)));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->Write(3, second, sizeof(second)));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->FlushPersistentAreas());
+
+    /* Both areas are pending, the snapshot restores them before locking any. */
+    manager->Initialize();
+    for (uint8_t area : {1, 3}) {
+        TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(area, sizeof(first), READ_WRITE));
+        TEST_ASSERT_EQUAL(ESP_OK, manager->SetPersistence(area, true));
+    }
+
+    auto snapshot = manager->Snapshot({3, 1});
+    TEST_ASSERT_TRUE(snapshot.valid());
+    TEST_ASSERT_EQUAL(sizeof(first), snapshot.size(1));
+    TEST_ASSERT_EQUAL_MEMORY(first, snapshot.data(1), sizeof(first));
+    TEST_ASSERT_EQUAL_MEMORY(second, snapshot.data(3), sizeof(second));
+    snapshot.Release();
+
+    /* The flush does not hold the persistence mutex while it borrows the areas. */
+    TEST_ASSERT_EQUAL(ESP_OK, manager->FlushPersistentAreas());
+
+    manager->Initialize();
+}
+
+void test_RetainedAreaIsRestoredAfterDeepSleep() {
+    auto manager = SharedMemoryManager::GetInstance();
+    time_process_t written{};
+    time_process_t read{};
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_TIME_PROCESS>());
+
+    written.raw_time = 123456789;
+    written.hours    = 3;
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, manager->Write<MEMORY_AREAS_TIME_PROCESS>(written));
+
+    /* Simulates a wake up: RTC memory is kept and the area is restored as soon as it is signed up. */
+    manager->Initialize();
+    TEST_ASSERT_TRUE(manager->HasRetainedState());
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_TIME_PROCESS>());
+    TEST_ASSERT_NOT_EQUAL(0, manager->GetWrittenBytes(MEMORY_AREAS_TIME_PROCESS));
+    TEST_ASSERT_NOT_EQUAL(0, manager->Read<MEMORY_AREAS_TIME_PROCESS>(read));
+    TEST_ASSERT_EQUAL_UINT64(written.raw_time, read.raw_time);
+    TEST_ASSERT_EQUAL(written.hours, read.hours);
+
+    /* A copy taken with another area size is not restored. */
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea(MEMORY_AREAS_TIME_PROCESS, TIME_PROCESS_SIZE + 1, READ_WRITE));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SetRetention(MEMORY_AREAS_TIME_PROCESS, true));
+    TEST_ASSERT_EQUAL(0, manager->GetWrittenBytes(MEMORY_AREAS_TIME_PROCESS));
+
+    /* Neither is an area whose retention was dropped. */
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_TIME_PROCESS>());
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, manager->Write<MEMORY_AREAS_TIME_PROCESS>(written));
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SetRetention(MEMORY_AREAS_TIME_PROCESS, false));
+
+    manager->Initialize();
+    TEST_ASSERT_EQUAL(ESP_OK, manager->SignUpSharedArea<MEMORY_AREAS_TIME_PROCESS>());
+    TEST_ASSERT_EQUAL(0, manager->GetWrittenBytes(MEMORY_AREAS_TIME_PROCESS));
+
+    manager->Initialize();
+}
+
+void test_DecodedCacheIsInvalidatedByGeneration() {
+    uint8_t storage[Benchmark::AREA_SIZE];
+    network_information_t cache{};
+    network_information_t written{};
+    network_information_t read{};
+    uint8_t encoded[NETWORK_INFORMATION_SIZE];
+
+    SharedMemory area(1, storage, Benchmark::AREA_SIZE, READ_WRITE, ReadMode::OPTIMISTIC);
+    area.AttachCache(reinterpret_cast<uint8_t*>(&cache), sizeof(cache), &network_information_t_msg);
+
+    written.ap_connected = NETWORK_STATUS_CONNECTED;
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Write(written, network_information_t_msg));
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Read(read, network_information_t_msg));
+    TEST_ASSERT_EQUAL(NETWORK_STATUS_CONNECTED, read.ap_connected);
+
+    /* A raw write does not go through the cache, the next read must decode it. */
+    written.ap_connected  = NETWORK_STATUS_DISCONNECTED;
+    written.sta_connected = NETWORK_STATUS_CONNECTED;
+    pb_ostream_t ostream  = pb_ostream_from_buffer(encoded, sizeof(encoded));
+    TEST_ASSERT_TRUE(pb_encode(&ostream, &network_information_t_msg, &written));
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Write(reinterpret_cast<char*>(encoded), ostream.bytes_written));
+
+    TEST_ASSERT_EQUAL(Error::NO_ERROR, area.Read(read, network_information_t_msg));
+    TEST_ASSERT_EQUAL(NETWORK_STATUS_DISCONNECTED, read.ap_connected);
+    TEST_ASSERT_EQUAL(NETWORK_STATUS_CONNECTED, read.sta_connected);
+    TEST_ASSERT_EQUAL(NETWORK_STATUS_CONNECTED, cache.sta_connected);
+}
+
+void test_DecodedCacheBenchmark() {
+    network_information_t information{};
+    information.ap_connected  = NETWORK_STATUS_CONNECTED;
+    information.sta_connected = NETWORK_STATUS_CONNECTED;
+    RunDecodedCacheBenchmark("network_information_t", information, network_information_t_msg);
+
+    network_credentials_t credentials{};
+    strcpy(credentials.ssid, "titanium-benchmark");
+    strcpy(credentials.password, "a-reasonably-long-password");
+    RunDecodedCacheBenchmark("network_credentials_t", credentials, network_credentials_t_msg);
+
+    continuos_packet_list_t packets{};
+    packets.packet_configs_count = 4;
+    for (uint8_t i = 0; i < packets.packet_configs_count; i++) {
+        packets.packet_configs[i].destination_address = 0x1015 + i;
+        packets.packet_configs[i].destination_area    = MEMORY_AREAS_TIME_PROCESS;
+        packets.packet_configs[i].requested_area      = MEMORY_AREAS_TIME_PROCESS;
+        packets.packet_configs[i].packet_interval     = 1000;
+    }
+    RunDecodedCacheBenchmark("continuos_packet_list_t", packets, continuos_packet_list_t_msg);
+}
+
+void test_LockedReadersBenchmark() {
+    for (uint8_t readers = 1; readers <= Benchmark::MAXIMUM_READERS; readers *= 2) {
+        TEST_ASSERT_EQUAL(0, RunReadersBenchmark(ReadMode::LOCKED, readers));
+    }
+}
+
+void test_OptimisticReadersBenchmark() {
+    for (uint8_t readers = 1; readers <= Benchmark::MAXIMUM_READERS; readers *= 2) {
+        TEST_ASSERT_EQUAL(0, RunReadersBenchmark(ReadMode::OPTIMISTIC, readers));
+    }
+}
+
+void main_test(void) {
+    vTaskDelay(pdMS_TO_TICKS(2000));
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_OptimisticReadDecodesLatestWrite);
+    RUN_TEST(test_SequenceIsEvenAfterWrite);
+    RUN_TEST(test_ConsumersTrackUpdatesIndependently);
+    RUN_TEST(test_SubscriberIsNotifiedOnWrite);
+    RUN_TEST(test_BusFansOutOneCopyToEverySubscriber);
+    RUN_TEST(test_AreasAreCarvedFromAlignedArena);
+    RUN_TEST(test_ExternalAreasAreKeptOutOfTheArena);
+    RUN_TEST(test_RegisteredAreaRoundTrip);
+    RUN_TEST(test_WriteLeaseAndReadViewShareAreaStorage);
+    RUN_TEST(test_UncommittedLeaseIsNotAWrite);
+    RUN_TEST(test_MessagesLargerThan255BytesAreNotTruncated);
+    RUN_TEST(test_LargeAreaIsStreamedInChunks);
+    RUN_TEST(test_RingAreaKeepsHistoryAndCountsOverflows);
+    RUN_TEST(test_SnapshotsSeeTransactionsAtomically);
+    RUN_TEST(test_FailedTransactionWritesNothing);
+    RUN_TEST(test_CountersTrackAccessesAndContention);
+    RUN_TEST(test_BoundedLockTimesOutWhileAreaIsHeld);
+    RUN_TEST(test_HighPriorityWriterLatencyIsBounded);
+    RUN_TEST(test_CeilingIsKeptUntilLastAreaIsReleased);
+    RUN_TEST(test_WriteFieldPatchesNestedField);
+    RUN_TEST(test_PersistentAreaIsRestoredAfterReboot);
+    RUN_TEST(test_SnapshotRestoresPersistentAreasFirst);
+    RUN_TEST(test_RetainedAreaIsRestoredAfterDeepSleep);
+    RUN_TEST(test_DecodedCacheIsInvalidatedByGeneration);
+    RUN_TEST(test_DecodedCacheBenchmark);
+    RUN_TEST(test_LockedReadersBenchmark);
+    RUN_TEST(test_OptimisticReadersBenchmark);
+
+    UNITY_END();
+}
+
+extern "C" void app_main(void) {
+    main_test();
+}